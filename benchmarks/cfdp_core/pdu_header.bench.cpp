@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <cfdp_core/pdu_enums.hpp>
+#include <cfdp_core/pdu_header.hpp>
+
+#include <perf_counters.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using ::cfdp::bench::Per;
+using ::cfdp::bench::PerfScope;
+
+using ::cfdp::pdu::header::CrcFlag;
+using ::cfdp::pdu::header::Direction;
+using ::cfdp::pdu::header::LargeFileFlag;
+using ::cfdp::pdu::header::PduHeader;
+using ::cfdp::pdu::header::PduType;
+using ::cfdp::pdu::header::SegmentationControl;
+using ::cfdp::pdu::header::SegmentMetadataFlag;
+using ::cfdp::pdu::header::TransmissionMode;
+
+namespace
+{
+// Length of the entity IDs and of the transaction sequence number is the
+// benchmark argument.
+[[nodiscard]] PduHeader buildHeader(uint8_t length)
+{
+    return PduHeader{1,
+                     PduType::FileData,
+                     Direction::TowardsReceiver,
+                     TransmissionMode::Unacknowledged,
+                     CrcFlag::CrcNotPresent,
+                     LargeFileFlag::SmallFile,
+                     1024,
+                     SegmentationControl::BoundariesNotPreserved,
+                     length,
+                     SegmentMetadataFlag::NotPresent,
+                     length,
+                     1,
+                     42,
+                     2};
+}
+
+void decodeHeader(benchmark::State& state)
+{
+    const auto encoded = buildHeader(static_cast<uint8_t>(state.range(0))).encodeToBytes();
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(PduHeader{std::span<uint8_t const>{encoded}});
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void encodeHeader(benchmark::State& state)
+{
+    const auto header = buildHeader(static_cast<uint8_t>(state.range(0)));
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(header.encodeToBytes());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+BENCHMARK(decodeHeader)->Arg(1)->Arg(4)->Arg(8);
+BENCHMARK(encodeHeader)->Arg(1)->Arg(4)->Arg(8);
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <cfdp_core/pdu_enums.hpp>
+#include <cfdp_core/pdu_tlv.hpp>
+
+#include <perf_counters.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+using ::cfdp::bench::Per;
+using ::cfdp::bench::PerfScope;
+
+using ::cfdp::pdu::tlv::EntityId;
+using ::cfdp::pdu::tlv::FilestoreRequest;
+using ::cfdp::pdu::tlv::FilestoreRequestActionCode;
+using ::cfdp::pdu::tlv::MessageToUser;
+
+namespace
+{
+template <class Tlv>
+void decodeTlv(benchmark::State& state, const Tlv& tlv)
+{
+    const auto encoded = tlv.encodeToBytes();
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Tlv{std::span<uint8_t const>{encoded}});
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void decodeFilestoreRequest(benchmark::State& state)
+{
+    decodeTlv(state, FilestoreRequest{FilestoreRequestActionCode::RenameFile,
+                                      "/data/downlink/image.bin", "/data/archive/image.bin"});
+}
+
+void decodeMessageToUser(benchmark::State& state)
+{
+    decodeTlv(state, MessageToUser{std::string(static_cast<size_t>(state.range(0)), 'm')});
+}
+
+void decodeEntityId(benchmark::State& state)
+{
+    decodeTlv(state, EntityId{8, 0x0102030405060708});
+}
+} // namespace
+
+BENCHMARK(decodeFilestoreRequest);
+BENCHMARK(decodeMessageToUser)->Arg(8)->Arg(64)->Arg(250);
+BENCHMARK(decodeEntityId);
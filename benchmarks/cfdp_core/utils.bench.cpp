@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <cfdp_core/utils.hpp>
+
+#include <perf_counters.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using ::cfdp::bench::Per;
+using ::cfdp::bench::PerfScope;
+
+namespace
+{
+// Decodes every integer of a buffer, the size of the integers is the
+// benchmark argument.
+void bytesToInt(benchmark::State& state)
+{
+    const auto size = static_cast<uint32_t>(state.range(0));
+
+    auto memory = std::vector<uint8_t>(size * 512);
+    std::iota(memory.begin(), memory.end(), uint8_t{0});
+
+    const auto perf = PerfScope{state, Per::Byte};
+
+    for (auto _ : state)
+    {
+        for (auto offset = uint32_t{0}; offset < memory.size(); offset += size)
+        {
+            benchmark::DoNotOptimize(cfdp::utils::bytesToInt<uint64_t>(memory, offset, size));
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(memory.size()));
+}
+
+void intToBytes(benchmark::State& state)
+{
+    const auto size = static_cast<uint8_t>(state.range(0));
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    auto value = uint64_t{0};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfdp::utils::intToBytes(value++, size));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+BENCHMARK(bytesToInt)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK(intToBytes)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <cfdp_runtime/future.hpp>
+#include <cfdp_runtime/thread_pool.hpp>
+
+#include <perf_counters.hpp>
+
+using ::cfdp::bench::Per;
+using ::cfdp::bench::PerfScope;
+
+using ::cfdp::runtime::future::Future;
+using ::cfdp::runtime::future::Promise;
+using ::cfdp::runtime::thread_pool::ThreadPool;
+
+namespace
+{
+// Creating, resolving and reading a future on a single thread, the lower
+// bound of every task result.
+void resolveFuture(benchmark::State& state)
+{
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        auto promise = Promise<int>{};
+        auto future  = promise.getFuture();
+
+        promise.setValue(1);
+        benchmark::DoNotOptimize(future.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void resolveSharedFuture(benchmark::State& state)
+{
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        auto promise = Promise<int>{};
+        auto shared  = promise.getFuture().makeShared();
+
+        promise.setValue(1);
+        benchmark::DoNotOptimize(shared.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Continuation subscribed before the value is set, run inline when the
+// promise completes.
+void resolveWithCallback(benchmark::State& state)
+{
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        auto promise = Promise<int>{};
+        auto result  = 0;
+
+        promise.getFuture().onReady([&result](Future<int>&& future) { result = future.get(); });
+        promise.setValue(1);
+
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Chain of continuations run on the pool, the length of the chain is the
+// benchmark argument.
+void resolveChain(benchmark::State& state)
+{
+    auto pool         = ThreadPool{2};
+    const auto length = state.range(0);
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        auto promise = Promise<int>{};
+        auto future  = promise.getFuture();
+
+        for (auto i = int64_t{0}; i < length; ++i)
+        {
+            future = std::move(future).then(pool, [](int value) { return value + 1; });
+        }
+
+        promise.setValue(0);
+        benchmark::DoNotOptimize(future.get());
+    }
+
+    state.SetItemsProcessed(state.iterations() * length);
+}
+} // namespace
+
+BENCHMARK(resolveFuture);
+BENCHMARK(resolveSharedFuture);
+BENCHMARK(resolveWithCallback);
+BENCHMARK(resolveChain)->Arg(1)->Arg(16)->UseRealTime();
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <cfdp_runtime/logger.hpp>
+
+#include <perf_counters.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using ::cfdp::bench::Per;
+using ::cfdp::bench::PerfScope;
+
+// Calls go through `logging::log` directly, the level macros are not
+// defined for the benchmarks.
+namespace logging = ::cfdp::runtime::logging;
+
+namespace
+{
+// Measures the cost of the calls only, not of writing the lines out.
+class DiscardSink final : public logging::LogSink
+{
+  public:
+    void write(std::string_view /*lines*/) override {}
+};
+
+// Level of the module before the benchmark, restored once it is done.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+logging::LogLevel previousLevel = logging::LogLevel::Trace;
+
+// Runs once before the benchmark threads start and once after all of them
+// stopped, so no thread logs while the logger is being set up.
+template <logging::LogLevel Level>
+void discardMessages(const benchmark::State& /*state*/)
+{
+    previousLevel = logging::level(logging::LogModule::General);
+
+    logging::setSink(std::make_unique<DiscardSink>());
+    logging::setLevel(logging::LogModule::General, Level);
+}
+
+void restoreLogger(const benchmark::State& /*state*/)
+{
+    logging::setLevel(logging::LogModule::General, previousLevel);
+    logging::setSink(std::make_unique<logging::StdoutSink>());
+}
+
+// Plain arguments are copied as raw bytes and formatted by the backend.
+void logDeferred(benchmark::State& state)
+{
+    const auto perf = PerfScope{state, Per::Item};
+
+    auto pdu = uint64_t{0};
+    for (auto _ : state)
+    {
+        logging::log(logging::LogLevel::Info, "sent pdu {} of transaction {}", pdu++, 42);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Arguments owning memory are formatted by the calling thread.
+void logFormatted(benchmark::State& state)
+{
+    const auto file = std::string{"/data/downlink/image.bin"};
+    const auto perf = PerfScope{state, Per::Item};
+
+    auto pdu = uint64_t{0};
+    for (auto _ : state)
+    {
+        logging::log(logging::LogLevel::Info, "sent pdu {} of {}", pdu++, file);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Messages below the level of their module cost a single load.
+void logFiltered(benchmark::State& state)
+{
+    const auto perf = PerfScope{state, Per::Item};
+
+    auto pdu = uint64_t{0};
+    for (auto _ : state)
+    {
+        logging::log(logging::LogLevel::Debug, "sent pdu {} of transaction {}", pdu++, 42);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+// Every benchmark thread logs on its own, the backend formats behind them.
+BENCHMARK(logDeferred)
+    ->ThreadRange(1, 8)
+    ->Setup(discardMessages<logging::LogLevel::Trace>)
+    ->Teardown(restoreLogger)
+    ->UseRealTime();
+BENCHMARK(logFormatted)
+    ->ThreadRange(1, 8)
+    ->Setup(discardMessages<logging::LogLevel::Trace>)
+    ->Teardown(restoreLogger)
+    ->UseRealTime();
+BENCHMARK(logFiltered)
+    ->ThreadRange(1, 8)
+    ->Setup(discardMessages<logging::LogLevel::Warn>)
+    ->Teardown(restoreLogger)
+    ->UseRealTime();
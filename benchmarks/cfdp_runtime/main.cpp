@@ -0,0 +1,21 @@
+#include <benchmark/benchmark.h>
+
+#include <cfdp_runtime/logger.hpp>
+
+int main(int argc, char** argv)
+{
+    // Tracing of the runtime itself would be measured along with it, the
+    // logger benchmarks lower the level for their own runs.
+    cfdp::runtime::logging::setLevel(cfdp::runtime::logging::LogLevel::Warn);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <cfdp_runtime/atomic_queue.hpp>
+#include <cfdp_runtime/mpmc_queue.hpp>
+#include <cfdp_runtime/spsc_queue.hpp>
+
+#include <perf_counters.hpp>
+
+#include <cstdint>
+#include <thread>
+
+using ::cfdp::bench::Per;
+using ::cfdp::bench::PerfScope;
+
+using ::cfdp::runtime::atomic::AtomicQueue;
+using ::cfdp::runtime::atomic::MpmcQueue;
+using ::cfdp::runtime::atomic::SpscQueue;
+
+namespace
+{
+constexpr auto queue_capacity = size_t{1024};
+
+// Sent to the echo thread to make it exit.
+constexpr auto stop_value = ~uint64_t{0};
+
+// Even benchmark threads produce, odd ones consume, every thread moves the
+// same number of items, so the run ends with an empty queue, which is
+// shared by all runs.
+template <class Queue>
+void contendedTransfer(benchmark::State& state, Queue& queue)
+{
+    const auto producer = state.thread_index() % 2 == 0;
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    auto value = uint64_t{0};
+    for (auto _ : state)
+    {
+        if (producer)
+        {
+            queue.push(value++);
+        }
+        else
+        {
+            benchmark::DoNotOptimize(queue.pop());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void atomicQueueTransfer(benchmark::State& state)
+{
+    static auto queue = AtomicQueue<uint64_t>{};
+    contendedTransfer(state, queue);
+}
+
+void mpmcQueueTransfer(benchmark::State& state)
+{
+    static auto queue = MpmcQueue<uint64_t>{queue_capacity};
+    contendedTransfer(state, queue);
+}
+
+void spscQueueTransfer(benchmark::State& state)
+{
+    static auto queue = SpscQueue<uint64_t, queue_capacity>{};
+    contendedTransfer(state, queue);
+}
+
+// Round trip of a single item to another thread and back, the echo thread
+// waits in a blocking pop, like a pipeline stage would.
+template <class Queue>
+void pingPong(benchmark::State& state, Queue& requests, Queue& responses)
+{
+    auto echo = std::jthread{[&requests, &responses]() {
+        for (auto value = requests.pop(); value != stop_value; value = requests.pop())
+        {
+            responses.push(value);
+        }
+    }};
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    auto value = uint64_t{0};
+    for (auto _ : state)
+    {
+        requests.push(value++);
+        benchmark::DoNotOptimize(responses.pop());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    requests.push(stop_value);
+}
+
+void atomicQueueRoundTrip(benchmark::State& state)
+{
+    auto requests  = AtomicQueue<uint64_t>{};
+    auto responses = AtomicQueue<uint64_t>{};
+    pingPong(state, requests, responses);
+}
+
+void mpmcQueueRoundTrip(benchmark::State& state)
+{
+    auto requests  = MpmcQueue<uint64_t>{queue_capacity};
+    auto responses = MpmcQueue<uint64_t>{queue_capacity};
+    pingPong(state, requests, responses);
+}
+
+void spscQueueRoundTrip(benchmark::State& state)
+{
+    auto requests  = SpscQueue<uint64_t, queue_capacity>{};
+    auto responses = SpscQueue<uint64_t, queue_capacity>{};
+    pingPong(state, requests, responses);
+}
+} // namespace
+
+BENCHMARK(atomicQueueTransfer)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK(mpmcQueueTransfer)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK(spscQueueTransfer)->Threads(2)->UseRealTime();
+
+BENCHMARK(atomicQueueRoundTrip)->UseRealTime();
+BENCHMARK(mpmcQueueRoundTrip)->UseRealTime();
+BENCHMARK(spscQueueRoundTrip)->UseRealTime();
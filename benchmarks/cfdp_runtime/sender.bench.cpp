@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <cfdp_runtime/file_descriptor.hpp>
+#include <cfdp_runtime/sender.hpp>
+#include <cfdp_runtime/thread_pool.hpp>
+#include <cfdp_runtime/transport.hpp>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <perf_counters.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+using ::cfdp::bench::Per;
+using ::cfdp::bench::PerfScope;
+
+using ::cfdp::runtime::io::FileDescriptor;
+using ::cfdp::runtime::io::OutgoingPdu;
+using ::cfdp::runtime::io::Transport;
+using ::cfdp::runtime::io::UdpTransport;
+using ::cfdp::runtime::sender::Sender;
+using ::cfdp::runtime::sender::SenderOptions;
+using ::cfdp::runtime::thread_pool::ThreadPool;
+
+namespace
+{
+constexpr auto file_size = size_t{64} << 20;
+
+// Counts the PDUs instead of sending them, which leaves only the pipeline.
+class DiscardTransport final : public Transport
+{
+  public:
+    void transmit(std::span<const OutgoingPdu> pdus) override
+    {
+        benchmark::DoNotOptimize(pdus.data());
+    }
+};
+
+// Written once, it stays in the page cache for the following runs.
+[[nodiscard]] const std::filesystem::path& sourceFile()
+{
+    static const auto path = [] {
+        auto file = std::filesystem::temp_directory_path() / "cfdp_sender_bench.bin";
+        auto out  = std::ofstream{file, std::ios::binary};
+        auto data = std::vector<char>(file_size, 'x');
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        return file;
+    }();
+    return path;
+}
+
+void sendFile(benchmark::State& state, Transport& transport)
+{
+    auto pool       = ThreadPool{4};
+    auto fileSender = Sender{
+        pool, transport, SenderOptions{.segmentSize = static_cast<size_t>(state.range(0))}};
+    const auto& path = sourceFile();
+
+    const auto perf = PerfScope{state, Per::Byte};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(fileSender.send(path, 2).get());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(file_size));
+}
+
+// Reading, segmenting and encoding, the argument is the segment size.
+void sendToNowhere(benchmark::State& state)
+{
+    auto transport = DiscardTransport{};
+    sendFile(state, transport);
+}
+
+// Datagrams to a loopback socket which never reads them, so the kernel
+// drops them once its receive buffer is full, like a receiver too slow for
+// the link would.
+void sendOverUdpLoopback(benchmark::State& state)
+{
+    auto receiver = FileDescriptor{::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0)};
+
+    auto address            = sockaddr_in{};
+    address.sin_family      = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    auto length             = socklen_t{sizeof(address)};
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (::bind(receiver.get(), reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+        ::getsockname(receiver.get(), reinterpret_cast<sockaddr*>(&address), &length) != 0)
+    {
+        state.SkipWithError("could not bind the receiving socket");
+        return;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    auto transport = UdpTransport{"127.0.0.1", ntohs(address.sin_port)};
+    sendFile(state, transport);
+}
+} // namespace
+
+BENCHMARK(sendToNowhere)->Arg(1024)->Arg(8192)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(sendOverUdpLoopback)->Arg(1024)->Arg(8192)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include <cfdp_runtime/future.hpp>
+#include <cfdp_runtime/thread_pool.hpp>
+
+#include <perf_counters.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using ::cfdp::bench::Per;
+using ::cfdp::bench::PerfScope;
+
+using ::cfdp::runtime::future::Future;
+using ::cfdp::runtime::thread_pool::ThreadPool;
+
+namespace
+{
+// Futures collected before waiting for them, so dispatching is measured
+// without a round trip per task.
+constexpr auto dispatch_batch = size_t{1024};
+
+// Dispatches trivial tasks from outside of the pool, the number of workers
+// is the benchmark argument.
+void dispatchTask(benchmark::State& state)
+{
+    auto pool    = ThreadPool{static_cast<size_t>(state.range(0))};
+    auto futures = std::vector<Future<int>>{};
+    futures.reserve(dispatch_batch);
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        futures.push_back(pool.dispatchTask([]() { return 1; }));
+
+        if (futures.size() == dispatch_batch)
+        {
+            for (auto& future : futures)
+            {
+                benchmark::DoNotOptimize(future.get());
+            }
+            futures.clear();
+        }
+    }
+
+    for (auto& future : futures)
+    {
+        benchmark::DoNotOptimize(future.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Dispatches every task of a batch at once, the batch size is the
+// benchmark argument.
+void dispatchBulk(benchmark::State& state)
+{
+    auto pool           = ThreadPool{4};
+    const auto size     = static_cast<size_t>(state.range(0));
+    const auto functors = std::vector<int (*)()>(size, []() { return 1; });
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        for (auto& future : pool.dispatchBulk(functors))
+        {
+            benchmark::DoNotOptimize(future.get());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+// Latency of a single task, from dispatching it to having its result.
+void dispatchRoundTrip(benchmark::State& state)
+{
+    auto pool = ThreadPool{static_cast<size_t>(state.range(0))};
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pool.dispatchTask([]() { return 1; }).get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Tasks dispatched by a task already running on a worker end up in its own
+// deque, instead of the shared lanes.
+void nestedDispatch(benchmark::State& state)
+{
+    auto pool       = ThreadPool{4};
+    const auto size = static_cast<size_t>(state.range(0));
+
+    const auto perf = PerfScope{state, Per::Item};
+
+    for (auto _ : state)
+    {
+        auto outer = pool.dispatchTask([&pool, size]() {
+            auto futures = std::vector<Future<int>>{};
+            futures.reserve(size);
+
+            for (auto i = size_t{0}; i < size; ++i)
+            {
+                futures.push_back(pool.dispatchTask([]() { return 1; }));
+            }
+
+            auto sum = 0;
+            for (auto& future : futures)
+            {
+                sum += future.get();
+            }
+            return sum;
+        });
+
+        benchmark::DoNotOptimize(outer.get());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+} // namespace
+
+BENCHMARK(dispatchTask)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK(dispatchBulk)->Arg(16)->Arg(256)->UseRealTime();
+BENCHMARK(dispatchRoundTrip)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(nestedDispatch)->Arg(16)->Arg(256)->UseRealTime();
@@ -0,0 +1,202 @@
+#include "perf_counters.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+using ::cfdp::bench::num_perf_events;
+using ::cfdp::bench::Per;
+using ::cfdp::bench::PerfEvent;
+
+struct EventConfig
+{
+    uint32_t type;
+    uint64_t config;
+    const char* name;
+};
+
+constexpr auto l1d_read_miss = uint64_t{PERF_COUNT_HW_CACHE_L1D} |
+                               (uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8) |
+                               (uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16);
+
+// Indexed by PerfEvent.
+constexpr auto event_configs = std::array<EventConfig, num_perf_events>{{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch_misses"},
+    {PERF_TYPE_HW_CACHE, l1d_read_miss, "l1d_misses"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "llc_misses"},
+}};
+
+constexpr auto unit_names = std::array<const char*, 3>{"iteration", "item", "byte"};
+
+// Layout of a group read with the formats below.
+struct GroupReading
+{
+    uint64_t numEvents;
+    uint64_t timeEnabled;
+    uint64_t timeRunning;
+    std::array<uint64_t, num_perf_events> values;
+};
+
+[[nodiscard]] int openEvent(const EventConfig& event, int leader) noexcept
+{
+    auto attributes        = perf_event_attr{};
+    attributes.size        = sizeof(perf_event_attr);
+    attributes.type        = event.type;
+    attributes.config      = event.config;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                             PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // Members follow the leader, which starts disabled until `start`.
+    attributes.disabled       = leader < 0 ? 1 : 0;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv     = 1;
+
+    return static_cast<int>(
+        ::syscall(SYS_perf_event_open, &attributes, 0, -1, leader, PERF_FLAG_FD_CLOEXEC));
+}
+
+[[nodiscard]] double units(const benchmark::State& state, Per per) noexcept
+{
+    const auto iterations = static_cast<double>(state.iterations());
+
+    const auto processed = [&state](const char* rate) {
+        const auto found = state.counters.find(rate);
+        return found == state.counters.end() ? 0.0 : found->second.value;
+    };
+
+    const auto count = per == Per::Item   ? processed("items_per_second")
+                       : per == Per::Byte ? processed("bytes_per_second")
+                                          : iterations;
+
+    return count > 0.0 ? count : iterations;
+}
+} // namespace
+
+cfdp::bench::PerfCounters::PerfCounters() noexcept
+{
+    descriptors.fill(-1);
+
+    for (auto i = size_t{0}; i < num_perf_events; ++i)
+    {
+        descriptors[i] = openEvent(event_configs[i], leader);
+
+        if (descriptors[i] < 0)
+        {
+            openError = openError == 0 ? errno : openError;
+        }
+        else if (leader < 0)
+        {
+            leader = descriptors[i];
+        }
+    }
+}
+
+cfdp::bench::PerfCounters::~PerfCounters()
+{
+    for (const auto descriptor : descriptors)
+    {
+        if (descriptor >= 0)
+        {
+            ::close(descriptor);
+        }
+    }
+}
+
+void cfdp::bench::PerfCounters::start() noexcept
+{
+    values.fill(std::nullopt);
+
+    if (isAvailable())
+    {
+        ::ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+void cfdp::bench::PerfCounters::stop() noexcept
+{
+    if (!isAvailable())
+    {
+        return;
+    }
+
+    ::ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    auto reading   = GroupReading{};
+    const auto got = ::read(leader, &reading, sizeof(reading));
+
+    // A group which never got onto the PMU counted nothing at all.
+    if (got < 0 || reading.timeRunning == 0)
+    {
+        return;
+    }
+
+    const auto scale = static_cast<double>(reading.timeEnabled) /
+                       static_cast<double>(reading.timeRunning);
+
+    // Values follow the order in which the events were opened.
+    auto next = size_t{0};
+    for (auto i = size_t{0}; i < num_perf_events && next < reading.numEvents; ++i)
+    {
+        if (descriptors[i] >= 0)
+        {
+            values[i] = static_cast<uint64_t>(static_cast<double>(reading.values[next++]) * scale);
+        }
+    }
+}
+
+cfdp::bench::PerfScope::PerfScope(benchmark::State& state, Per per) noexcept
+    : state(state), per(per)
+{
+    counters.start();
+}
+
+cfdp::bench::PerfScope::~PerfScope()
+{
+    counters.stop();
+
+    if (!counters.isAvailable())
+    {
+        static auto reported = std::atomic_bool{false};
+        if (!reported.exchange(true))
+        {
+            std::fprintf(stderr, "hardware counters are not available: %s\n",
+                         std::strerror(counters.error()));
+        }
+        return;
+    }
+
+    const auto divisor = units(state, per);
+    const auto unit    = std::string{"/"} + unit_names[static_cast<size_t>(per)];
+
+    // Every thread reports its own ratios, which the library would sum up
+    // across the threads of a ThreadRange run, so they are averaged instead.
+    for (auto i = size_t{0}; i < num_perf_events; ++i)
+    {
+        if (const auto value = counters.value(static_cast<PerfEvent>(i)))
+        {
+            state.counters[event_configs[i].name + unit] = benchmark::Counter{
+                static_cast<double>(*value) / divisor, benchmark::Counter::kAvgThreads};
+        }
+    }
+
+    const auto cycles       = counters.value(PerfEvent::Cycles);
+    const auto instructions = counters.value(PerfEvent::Instructions);
+    if (cycles.has_value() && instructions.has_value() && *cycles > 0)
+    {
+        state.counters["ipc"] = benchmark::Counter{
+            static_cast<double>(*instructions) / static_cast<double>(*cycles),
+            benchmark::Counter::kAvgThreads};
+    }
+}
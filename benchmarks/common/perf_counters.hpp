@@ -0,0 +1,114 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace cfdp::bench
+{
+enum class PerfEvent : uint8_t
+{
+    Cycles = 0,
+    Instructions,
+    BranchMisses,
+    L1dMisses,
+    LlcMisses,
+};
+
+constexpr size_t num_perf_events = 5;
+
+// What the reported counters are divided by.
+enum class Per : uint8_t
+{
+    Iteration = 0,
+    Item,
+    Byte,
+};
+
+/**
+ * Hardware counters of the calling thread, read with perf_event_open as a
+ * single group, so all of them cover exactly the same instructions.
+ *
+ * Events the CPU or the kernel do not support are skipped, as are all of
+ * them when perf_event_paranoid forbids their use, or when the benchmarks
+ * run in a container without access to the PMU. Only the user space part
+ * of the calling thread is counted, work handed over to other threads is
+ * not.
+ */
+class PerfCounters
+{
+  public:
+    PerfCounters() noexcept;
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(PerfCounters const&) = delete;
+    PerfCounters(PerfCounters&&)                 = delete;
+    PerfCounters& operator=(PerfCounters&&)      = delete;
+
+    [[nodiscard]] inline bool isAvailable() const noexcept { return leader >= 0; }
+
+    // Error of the first event which could not be opened, zero if none.
+    [[nodiscard]] inline int error() const noexcept { return openError; }
+
+    void start() noexcept;
+    void stop() noexcept;
+
+    /**
+     * Returns the count between the last start and stop, scaled up if the
+     * kernel had to multiplex the counters.
+     *
+     * @return std::nullopt if the event is not available.
+     */
+    [[nodiscard]] inline std::optional<uint64_t> value(PerfEvent event) const noexcept
+    {
+        return values[static_cast<size_t>(event)];
+    }
+
+  private:
+    int leader{-1};
+    int openError{0};
+
+    std::array<int, num_perf_events> descriptors{};
+    std::array<std::optional<uint64_t>, num_perf_events> values{};
+};
+
+/**
+ * Counts the hardware events over a benchmark run and reports them as
+ * benchmark counters, like `cycles/item`, `instructions/byte` and `ipc`.
+ * Items and bytes are the ones set with SetItemsProcessed and
+ * SetBytesProcessed, it falls back to iterations if they are not set.
+ *
+ *     void decodeHeader(benchmark::State& state)
+ *     {
+ *         const auto perf = PerfScope{state, Per::Item};
+ *         for (auto _ : state)
+ *         {
+ *             ...
+ *         }
+ *         state.SetItemsProcessed(state.iterations());
+ *     }
+ *
+ * Nothing is reported if the counters are not available, the reason is
+ * written to the standard error once.
+ */
+class PerfScope
+{
+  public:
+    PerfScope(benchmark::State& state, Per per) noexcept;
+    ~PerfScope();
+
+    PerfScope(const PerfScope&)            = delete;
+    PerfScope& operator=(PerfScope const&) = delete;
+    PerfScope(PerfScope&&)                 = delete;
+    PerfScope& operator=(PerfScope&&)      = delete;
+
+  private:
+    benchmark::State& state;
+    Per per;
+    PerfCounters counters{};
+};
+} // namespace cfdp::bench
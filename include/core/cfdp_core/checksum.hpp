@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace cfdp::checksum
+{
+/**
+ * CFDP modular checksum, the default checksum type of the Metadata PDU.
+ *
+ * The file is split into 4 byte words, aligned to the start of the file,
+ * each one read as a big endian integer. The checksum is their sum modulo
+ * 2^32, with the last, incomplete word padded with zeros. Since every byte
+ * is added at the position of its file offset, segments can be added in
+ * any order.
+ */
+class ModularChecksum
+{
+  public:
+    ModularChecksum() = default;
+
+    /**
+     * Adds a segment of the file.
+     *
+     * @param offset file offset of the first byte of the segment.
+     * @param data content of the segment.
+     */
+    void update(uint64_t offset, std::span<uint8_t const> data) noexcept;
+
+    [[nodiscard]] inline uint32_t value() const noexcept { return sum; }
+
+  private:
+    uint32_t sum{0};
+};
+} // namespace cfdp::checksum
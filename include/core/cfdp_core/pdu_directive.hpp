@@ -6,6 +6,7 @@
 #include <memory>
 #include <optional>
 #include <span>
+#include <string>
 
 using ::cfdp::pdu::header::LargeFileFlag;
 
@@ -95,4 +96,39 @@ class EndOfFile : PduInterface
         return entityId.has_value() ? entityId->get()->getRawSize() : 0;
     }
 };
+
+// Options of the Metadata PDU are not supported yet, they are skipped
+// while decoding and never encoded.
+class Metadata : PduInterface
+{
+  public:
+    Metadata(bool closureRequested, ChecksumType checksumType, uint64_t fileSize,
+             LargeFileFlag largeFileFlag, std::string&& sourceFileName,
+             std::string&& destinationFileName);
+    Metadata(std::span<uint8_t const> memory, LargeFileFlag largeFileFlag);
+
+    [[nodiscard]] std::vector<uint8_t> encodeToBytes() const override;
+
+    [[nodiscard]] inline uint16_t getRawSize() const override
+    {
+        // Directive code + flags + file size + LV source name + LV destination name
+        return const_pdu_size_bytes + getSizeOfFileSize() + sizeof(uint8_t) +
+               sourceFileName.length() + sizeof(uint8_t) + destinationFileName.length();
+    };
+
+    bool closureRequested;
+    ChecksumType checksumType;
+    uint64_t fileSize;
+    LargeFileFlag largeFileFlag;
+    std::string sourceFileName;
+    std::string destinationFileName;
+
+  private:
+    static constexpr uint8_t const_pdu_size_bytes = sizeof(uint8_t) + sizeof(uint8_t);
+
+    [[nodiscard]] inline uint8_t getSizeOfFileSize() const
+    {
+        return (largeFileFlag == LargeFileFlag::LargeFile) ? sizeof(uint64_t) : sizeof(uint32_t);
+    }
+};
 } // namespace cfdp::pdu::directive
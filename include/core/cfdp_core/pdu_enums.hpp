@@ -94,6 +94,15 @@ enum class DirectiveSubtype : uint8_t
     Finished = 0b1,
 };
 
+enum class ChecksumType : uint8_t
+{
+    Modular         = 0b0000,
+    Crc32Proximity1 = 0b0001,
+    Crc32C          = 0b0010,
+    Crc32           = 0b0011,
+    Null            = 0b1111,
+};
+
 } // namespace cfdp::pdu::directive
 
 namespace cfdp::pdu::tlv
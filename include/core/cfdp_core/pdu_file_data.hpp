@@ -0,0 +1,56 @@
+#pragma once
+
+#include "pdu_enums.hpp"
+#include "pdu_interface.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using ::cfdp::pdu::header::LargeFileFlag;
+
+namespace cfdp::pdu::file_data
+{
+/**
+ * File Data PDU, without segment metadata.
+ *
+ * The file data is not copied, the PDU refers to the memory it was built
+ * or decoded from, which has to outlive it. That keeps segmenting a read
+ * buffer and decoding a received PDU free of copies.
+ */
+class FileData : PduInterface
+{
+  public:
+    FileData(uint64_t offset, std::span<uint8_t const> data, LargeFileFlag largeFileFlag);
+    FileData(std::span<uint8_t const> memory, LargeFileFlag largeFileFlag);
+
+    [[nodiscard]] std::vector<uint8_t> encodeToBytes() const override;
+
+    /**
+     * Appends only the segment offset, everything the PDU holds before the
+     * file data. A sender can then transmit the data from where it is read,
+     * without copying it into the PDU.
+     */
+    void encodeOffsetInto(std::vector<uint8_t>& out) const;
+
+    [[nodiscard]] inline uint16_t getRawSize() const override
+    {
+        // Segment offset + file data
+        return getSizeOfOffset() + data.size();
+    };
+
+    uint64_t offset;
+    std::span<uint8_t const> data;
+    LargeFileFlag largeFileFlag;
+
+    // The most of file data a single PDU can carry, the length of the data
+    // field is a 16 bit number.
+    static constexpr size_t max_data_size = UINT16_MAX - sizeof(uint64_t);
+
+  private:
+    [[nodiscard]] inline uint8_t getSizeOfOffset() const
+    {
+        return (largeFileFlag == LargeFileFlag::LargeFile) ? sizeof(uint64_t) : sizeof(uint32_t);
+    }
+};
+} // namespace cfdp::pdu::file_data
@@ -4,6 +4,7 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <ranges>
 
 namespace cfdp::runtime::atomic
 {
@@ -16,10 +17,22 @@ class AtomicQueue
     T pop() noexcept;
     std::optional<T> tryPop() noexcept;
 
+    // Like `tryPop`, but waits for the lock instead of giving up on it, so
+    // a queue that is only contended is never reported as empty.
+    std::optional<T> popIfAny() noexcept;
+
     void push(const T& item) noexcept;
     void emplace(T&& item) noexcept;
 
-    [[nodiscard]] inline size_t sizeNow() const noexcept { return content.size(); };
+    // Moves all the items into the queue, taking the lock only once.
+    template <std::ranges::input_range Range>
+    void emplaceBulk(Range&& items) noexcept;
+
+    [[nodiscard]] inline size_t sizeNow() const noexcept
+    {
+        std::scoped_lock<std::mutex> lock{mutex};
+        return content.size();
+    };
 
   private:
     std::queue<T> content{};
@@ -34,7 +47,7 @@ T cfdp::runtime::atomic::AtomicQueue<T>::pop() noexcept
     std::unique_lock<std::mutex> lock{mutex};
     notEmptyCond.wait(lock, [this]() { return !this->content.empty(); });
 
-    auto item = content.front();
+    auto item = std::move(content.front());
     content.pop();
 
     return item;
@@ -50,10 +63,26 @@ std::optional<T> cfdp::runtime::atomic::AtomicQueue<T>::tryPop() noexcept
         return std::nullopt;
     }
 
-    auto item = content.front();
+    auto item = std::move(content.front());
+    content.pop();
+
+    return std::make_optional(std::move(item));
+}
+
+template <class T>
+std::optional<T> cfdp::runtime::atomic::AtomicQueue<T>::popIfAny() noexcept
+{
+    std::scoped_lock<std::mutex> lock{mutex};
+
+    if (content.empty())
+    {
+        return std::nullopt;
+    }
+
+    auto item = std::move(content.front());
     content.pop();
 
-    return std::make_optional(item);
+    return std::make_optional(std::move(item));
 }
 
 template <class T>
@@ -75,3 +104,17 @@ void cfdp::runtime::atomic::AtomicQueue<T>::emplace(T&& item) noexcept
     }
     notEmptyCond.notify_one();
 }
+
+template <class T>
+template <std::ranges::input_range Range>
+void cfdp::runtime::atomic::AtomicQueue<T>::emplaceBulk(Range&& items) noexcept
+{
+    {
+        std::scoped_lock<std::mutex> lock{mutex};
+        for (auto& item : items)
+        {
+            content.push(std::move(item));
+        }
+    }
+    notEmptyCond.notify_all();
+}
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+
+namespace cfdp::runtime::channel
+{
+/**
+ * Bounded, closable multi-producer multi-consumer channel.
+ *
+ * Producers block in `push` while the channel is full, so a fast stage
+ * cannot outrun a slow one and grow the memory usage without limit.
+ * Closing the channel wakes up every blocked producer and consumer:
+ * pushing into a closed channel fails, while consumers can still pop
+ * the items which were queued before the channel was closed.
+ */
+template <class T>
+class Channel
+{
+  public:
+    explicit Channel(size_t capacity) : maxSize(capacity == 0 ? 1 : capacity) {}
+    ~Channel() = default;
+
+    Channel(const Channel&)            = delete;
+    Channel& operator=(Channel const&) = delete;
+    Channel(Channel&&)                 = delete;
+    Channel& operator=(Channel&&)      = delete;
+
+    /**
+     * Pushes an item, waiting for a free slot if the channel is full.
+     *
+     * @return false if the channel was closed, the item is dropped then.
+     */
+    bool push(const T& item) noexcept;
+    bool emplace(T&& item) noexcept;
+
+    /**
+     * Pushes an item only if there is a free slot available.
+     *
+     * @return false if the channel is full or closed.
+     */
+    [[nodiscard]] bool tryPush(const T& item) noexcept;
+    [[nodiscard]] bool tryEmplace(T&& item) noexcept;
+
+    /**
+     * Pops an item, waiting for one if the channel is empty.
+     *
+     * @return std::nullopt only if the channel is closed and drained.
+     */
+    std::optional<T> pop() noexcept;
+    std::optional<T> tryPop() noexcept;
+
+    /**
+     * Pops an item, waiting at most `timeout` for one to arrive.
+     *
+     * @param timeout how long should the consumer wait for an item.
+     * @return std::nullopt on timeout or if the channel is closed and drained.
+     */
+    template <class Rep, class Period>
+    std::optional<T> popFor(std::chrono::duration<Rep, Period> timeout) noexcept;
+
+    /**
+     * Pops an item without blocking the calling thread. The callback is
+     * invoked with the item as soon as one arrives, either right away or
+     * on the thread of the producer which pushed it.
+     *
+     * @param callback functor invoked with the popped item, or with
+     *                 std::nullopt if the channel is closed and drained.
+     */
+    void popAsync(std::move_only_function<void(std::optional<T>)>&& callback) noexcept;
+
+    /**
+     * Moves every currently queued item to the end of `container`.
+     *
+     * @return number of moved items.
+     */
+    template <class Container>
+    size_t drainInto(Container& container);
+
+    void close() noexcept;
+
+    [[nodiscard]] bool isClosed() const noexcept;
+    [[nodiscard]] size_t sizeNow() const noexcept;
+    [[nodiscard]] inline size_t capacity() const noexcept { return maxSize; }
+
+  private:
+    template <class U>
+    bool pushImpl(U&& item) noexcept;
+
+    template <class U>
+    bool tryPushImpl(U&& item) noexcept;
+
+    template <class U>
+    bool handOver(std::unique_lock<std::mutex>& lock, U&& item) noexcept;
+
+    T takeFront(std::unique_lock<std::mutex>& lock) noexcept;
+
+    size_t maxSize;
+    bool closed{false};
+    std::deque<T> content{};
+
+    // Asynchronous consumers, there are waiting ones only if `content` is empty.
+    std::deque<std::move_only_function<void(std::optional<T>)>> pendingPops{};
+
+    mutable std::mutex mutex{};
+    std::condition_variable notEmptyCond{};
+    std::condition_variable notFullCond{};
+};
+} // namespace cfdp::runtime::channel
+
+template <class T>
+template <class U>
+bool cfdp::runtime::channel::Channel<T>::handOver(std::unique_lock<std::mutex>& lock,
+                                                   U&& item) noexcept
+{
+    if (pendingPops.empty())
+    {
+        return false;
+    }
+
+    auto consumer = std::move(pendingPops.front());
+    pendingPops.pop_front();
+
+    lock.unlock();
+    consumer(std::make_optional<T>(std::forward<U>(item)));
+
+    return true;
+}
+
+template <class T>
+template <class U>
+bool cfdp::runtime::channel::Channel<T>::pushImpl(U&& item) noexcept
+{
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        notFullCond.wait(lock, [this]() { return closed || content.size() < maxSize; });
+
+        if (closed)
+        {
+            return false;
+        }
+
+        if (handOver(lock, std::forward<U>(item)))
+        {
+            return true;
+        }
+
+        content.push_back(std::forward<U>(item));
+    }
+    notEmptyCond.notify_one();
+
+    return true;
+}
+
+template <class T>
+template <class U>
+bool cfdp::runtime::channel::Channel<T>::tryPushImpl(U&& item) noexcept
+{
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+
+        if (closed || content.size() >= maxSize)
+        {
+            return false;
+        }
+
+        if (handOver(lock, std::forward<U>(item)))
+        {
+            return true;
+        }
+
+        content.push_back(std::forward<U>(item));
+    }
+    notEmptyCond.notify_one();
+
+    return true;
+}
+
+template <class T>
+bool cfdp::runtime::channel::Channel<T>::push(const T& item) noexcept
+{
+    return pushImpl(item);
+}
+
+template <class T>
+bool cfdp::runtime::channel::Channel<T>::emplace(T&& item) noexcept
+{
+    return pushImpl(std::move(item));
+}
+
+template <class T>
+bool cfdp::runtime::channel::Channel<T>::tryPush(const T& item) noexcept
+{
+    return tryPushImpl(item);
+}
+
+template <class T>
+bool cfdp::runtime::channel::Channel<T>::tryEmplace(T&& item) noexcept
+{
+    return tryPushImpl(std::move(item));
+}
+
+template <class T>
+T cfdp::runtime::channel::Channel<T>::takeFront(std::unique_lock<std::mutex>& lock) noexcept
+{
+    auto item = std::move(content.front());
+    content.pop_front();
+
+    lock.unlock();
+    notFullCond.notify_one();
+
+    return item;
+}
+
+template <class T>
+std::optional<T> cfdp::runtime::channel::Channel<T>::pop() noexcept
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    notEmptyCond.wait(lock, [this]() { return closed || !content.empty(); });
+
+    if (content.empty())
+    {
+        return std::nullopt;
+    }
+
+    return std::make_optional(takeFront(lock));
+}
+
+template <class T>
+std::optional<T> cfdp::runtime::channel::Channel<T>::tryPop() noexcept
+{
+    std::unique_lock<std::mutex> lock{mutex};
+
+    if (content.empty())
+    {
+        return std::nullopt;
+    }
+
+    return std::make_optional(takeFront(lock));
+}
+
+template <class T>
+template <class Rep, class Period>
+std::optional<T>
+cfdp::runtime::channel::Channel<T>::popFor(std::chrono::duration<Rep, Period> timeout) noexcept
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    notEmptyCond.wait_for(lock, timeout, [this]() { return closed || !content.empty(); });
+
+    if (content.empty())
+    {
+        return std::nullopt;
+    }
+
+    return std::make_optional(takeFront(lock));
+}
+
+template <class T>
+void cfdp::runtime::channel::Channel<T>::popAsync(
+    std::move_only_function<void(std::optional<T>)>&& callback) noexcept
+{
+    std::unique_lock<std::mutex> lock{mutex};
+
+    if (!content.empty())
+    {
+        callback(std::make_optional(takeFront(lock)));
+        return;
+    }
+
+    if (closed)
+    {
+        lock.unlock();
+        callback(std::nullopt);
+        return;
+    }
+
+    pendingPops.push_back(std::move(callback));
+}
+
+template <class T>
+template <class Container>
+size_t cfdp::runtime::channel::Channel<T>::drainInto(Container& container)
+{
+    auto drained = std::deque<T>{};
+
+    {
+        std::scoped_lock<std::mutex> lock{mutex};
+        drained.swap(content);
+    }
+    notFullCond.notify_all();
+
+    container.insert(container.end(), std::make_move_iterator(drained.begin()),
+                     std::make_move_iterator(drained.end()));
+
+    return drained.size();
+}
+
+template <class T>
+void cfdp::runtime::channel::Channel<T>::close() noexcept
+{
+    auto consumers = decltype(pendingPops){};
+
+    {
+        std::scoped_lock<std::mutex> lock{mutex};
+        closed = true;
+        consumers.swap(pendingPops);
+    }
+    notEmptyCond.notify_all();
+    notFullCond.notify_all();
+
+    for (auto& consumer : consumers)
+    {
+        consumer(std::nullopt);
+    }
+}
+
+template <class T>
+bool cfdp::runtime::channel::Channel<T>::isClosed() const noexcept
+{
+    std::scoped_lock<std::mutex> lock{mutex};
+    return closed;
+}
+
+template <class T>
+size_t cfdp::runtime::channel::Channel<T>::sizeNow() const noexcept
+{
+    std::scoped_lock<std::mutex> lock{mutex};
+    return content.size();
+}
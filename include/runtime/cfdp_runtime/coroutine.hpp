@@ -0,0 +1,555 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "channel.hpp"
+#include "future.hpp"
+#include "reactor.hpp"
+#include "task.hpp"
+#include "timer_service.hpp"
+
+namespace cfdp::runtime::coroutine
+{
+/**
+ * Recycles coroutine frames in per-thread free lists.
+ *
+ * Frames are grouped in size classes of `granularity` bytes, so every
+ * coroutine of the same kind reuses the memory of the previous one.
+ * A frame released on another thread than the one which allocated it
+ * simply lands in the free list of the releasing thread. Frames larger
+ * than `max_pooled_size` go straight to the global allocator.
+ */
+class FrameAllocator
+{
+  public:
+    static constexpr size_t granularity       = 64;
+    static constexpr size_t max_pooled_size   = 2048;
+    static constexpr size_t max_cached_frames = 256;
+
+    [[nodiscard]] static void* allocate(size_t size);
+    static void deallocate(void* frame, size_t size) noexcept;
+};
+
+/**
+ * Frames of every coroutine type defined here come from the FrameAllocator.
+ */
+struct PooledFrame
+{
+    [[nodiscard]] static void* operator new(size_t size) { return FrameAllocator::allocate(size); }
+
+    static void operator delete(void* frame, size_t size) noexcept
+    {
+        FrameAllocator::deallocate(frame, size);
+    }
+};
+
+template <class T>
+class Task;
+} // namespace cfdp::runtime::coroutine
+
+namespace cfdp::runtime::coroutine::detail
+{
+template <class T>
+class TaskPromise;
+
+class TaskPromiseBase : public cfdp::runtime::coroutine::PooledFrame
+{
+  public:
+    struct FinalAwaiter
+    {
+        [[nodiscard]] inline bool await_ready() const noexcept { return false; }
+
+        template <class Promise>
+        [[nodiscard]] inline std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+        {
+            auto continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        inline void await_resume() const noexcept {}
+    };
+
+    [[nodiscard]] inline std::suspend_always initial_suspend() const noexcept { return {}; }
+    [[nodiscard]] inline FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    inline void unhandled_exception() noexcept { error = std::current_exception(); }
+
+    // Coroutine awaiting this one, resumed once this one finishes.
+    std::coroutine_handle<> continuation{};
+
+    // Outermost frame of the chain of awaiting coroutines, destroying it
+    // destroys the whole chain. Null if that frame is not owned by us.
+    std::coroutine_handle<> root{};
+
+  protected:
+    inline void rethrowIfFailed() const
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+  private:
+    std::exception_ptr error{};
+};
+
+template <class T>
+class TaskPromise : public TaskPromiseBase
+{
+  public:
+    [[nodiscard]] inline cfdp::runtime::coroutine::Task<T> get_return_object() noexcept;
+
+    template <class U>
+        requires std::convertible_to<U&&, T>
+    inline void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+    {
+        result.emplace(std::forward<U>(value));
+    }
+
+    [[nodiscard]] inline T takeResult()
+    {
+        rethrowIfFailed();
+        return std::move(result.value());
+    }
+
+  private:
+    std::optional<T> result{};
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+  public:
+    [[nodiscard]] inline cfdp::runtime::coroutine::Task<void> get_return_object() noexcept;
+
+    inline void return_void() const noexcept {}
+    inline void takeResult() const { rethrowIfFailed(); }
+};
+
+/**
+ * Eagerly destroyed coroutine driving a Task to completion on an executor.
+ */
+class DetachedTask
+{
+  public:
+    struct promise_type : public cfdp::runtime::coroutine::PooledFrame
+    {
+        [[nodiscard]] inline DetachedTask get_return_object() noexcept
+        {
+            return DetachedTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        [[nodiscard]] inline std::suspend_always initial_suspend() const noexcept { return {}; }
+        [[nodiscard]] inline std::suspend_never final_suspend() const noexcept { return {}; }
+
+        inline void return_void() const noexcept {}
+        inline void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * Returns the frame which has to be destroyed to release the suspended
+ * coroutine, together with every coroutine awaiting it.
+ *
+ * @return null if the chain ends in a coroutine we do not own.
+ */
+template <class Promise>
+[[nodiscard]] inline std::coroutine_handle<>
+owningFrame(std::coroutine_handle<Promise> handle) noexcept
+{
+    if constexpr (std::is_base_of_v<TaskPromiseBase, Promise>)
+    {
+        return handle.promise().root;
+    }
+    else if constexpr (std::is_same_v<Promise, DetachedTask::promise_type>)
+    {
+        return handle;
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+/**
+ * Starts the awaited task, transferring the control to it, and resumes the
+ * awaiting coroutine once the task finishes.
+ */
+template <class T>
+struct TaskAwaiter
+{
+    std::coroutine_handle<TaskPromise<T>> handle;
+
+    [[nodiscard]] inline bool await_ready() const noexcept { return !handle || handle.done(); }
+
+    template <class Promise>
+    [[nodiscard]] inline std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<Promise> awaiting) const noexcept
+    {
+        handle.promise().continuation = awaiting;
+        handle.promise().root         = owningFrame(awaiting);
+        return handle;
+    }
+
+    inline T await_resume() const { return handle.promise().takeResult(); }
+};
+
+/**
+ * Resumes a coroutine once run. If the executor drops it without running,
+ * the frame owning the coroutine is destroyed instead of leaking.
+ */
+class ResumeTask
+{
+  public:
+    template <class Promise>
+    explicit ResumeTask(std::coroutine_handle<Promise> handle) noexcept
+        : handle(handle), owner(owningFrame(handle))
+    {}
+
+    ~ResumeTask()
+    {
+        if (handle && owner)
+        {
+            owner.destroy();
+        }
+    }
+
+    ResumeTask(ResumeTask&& other) noexcept
+        : handle(std::exchange(other.handle, nullptr)), owner(other.owner)
+    {}
+
+    ResumeTask(const ResumeTask&)            = delete;
+    ResumeTask& operator=(ResumeTask const&) = delete;
+    ResumeTask& operator=(ResumeTask&&)      = delete;
+
+    inline void operator()() { std::exchange(handle, nullptr).resume(); }
+
+  private:
+    std::coroutine_handle<> handle;
+    std::coroutine_handle<> owner;
+};
+
+template <class T>
+DetachedTask driveTask(cfdp::runtime::coroutine::Task<T> task,
+                       cfdp::runtime::future::Promise<T> promise)
+{
+    try
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            co_await std::move(task);
+            promise.setValue();
+        }
+        else
+        {
+            promise.setValue(co_await std::move(task));
+        }
+    }
+    catch (...)
+    {
+        promise.setException(std::current_exception());
+    }
+}
+} // namespace cfdp::runtime::coroutine::detail
+
+namespace cfdp::runtime::coroutine
+{
+/**
+ * Lazily started coroutine returning a value of type T.
+ *
+ * A task does nothing until it is either awaited by another coroutine,
+ * which then resumes once the task finishes, or handed over to `spawn`
+ * which runs it on an executor. Exceptions escaping the coroutine body
+ * are rethrown to the awaiting side.
+ */
+template <class T = void>
+class [[nodiscard]] Task
+{
+  public:
+    using promise_type = detail::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+    ~Task()
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+    Task(const Task&)            = delete;
+    Task& operator=(Task const&) = delete;
+    Task& operator=(Task&&)      = delete;
+
+    [[nodiscard]] inline bool isDone() const noexcept { return !handle || handle.done(); }
+
+    /**
+     * Starts the task and suspends the awaiting coroutine until it is done,
+     * transferring the control directly, without going through a scheduler.
+     */
+    [[nodiscard]] inline auto operator co_await() && noexcept;
+
+  private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * Suspends the awaiting coroutine and resumes it on one of the workers of
+ * the executor.
+ */
+template <thread_pool::Executor Executor>
+class ScheduleAwaiter
+{
+  public:
+    explicit ScheduleAwaiter(Executor& executor) noexcept : executor(executor) {}
+
+    [[nodiscard]] inline bool await_ready() const noexcept { return false; }
+
+    template <class Promise>
+    inline void await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+    {
+        executor.post(detail::ResumeTask{handle});
+    }
+
+    inline void await_resume() const noexcept {}
+
+  private:
+    Executor& executor;
+};
+
+/**
+ * Suspends the awaiting coroutine until the future is ready, then resumes
+ * it on the executor with the value of the future. Only futures created by
+ * a `future::Promise`, like the ones returned by ThreadPool, can be awaited
+ * before they are ready.
+ */
+template <thread_pool::Executor Executor, class T>
+class FutureAwaiter
+{
+  public:
+    FutureAwaiter(Executor& executor, future::Future<T>&& future) noexcept
+        : executor(executor), future(std::move(future))
+    {}
+
+    [[nodiscard]] inline bool await_ready() const noexcept { return future->isReady(); }
+
+    template <class Promise>
+    inline void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        auto pending = std::move(future.value());
+        future.reset();
+
+        std::move(pending).onReady(
+            [this, resume = detail::ResumeTask{handle}](future::Future<T>&& ready) mutable {
+                future.emplace(std::move(ready));
+                executor.post(std::move(resume));
+            });
+    }
+
+    [[nodiscard]] inline T await_resume() { return future->get(); }
+
+  private:
+    Executor& executor;
+    std::optional<future::Future<T>> future;
+};
+
+/**
+ * Pops an item from the channel, suspending the awaiting coroutine instead
+ * of blocking its thread while the channel is empty. The coroutine is
+ * resumed on the executor once an item arrives or the channel is closed.
+ */
+template <thread_pool::Executor Executor, class T>
+class PopAwaiter
+{
+  public:
+    PopAwaiter(Executor& executor, channel::Channel<T>& channel) noexcept
+        : executor(executor), channel(channel)
+    {}
+
+    [[nodiscard]] inline bool await_ready() noexcept
+    {
+        item = channel.tryPop();
+        return item.has_value();
+    }
+
+    template <class Promise>
+    inline void await_suspend(std::coroutine_handle<Promise> handle) noexcept
+    {
+        channel.popAsync(
+            [this, resume = detail::ResumeTask{handle}](std::optional<T> popped) mutable {
+                item = std::move(popped);
+                executor.post(std::move(resume));
+            });
+    }
+
+    [[nodiscard]] inline std::optional<T> await_resume() noexcept { return std::move(item); }
+
+  private:
+    Executor& executor;
+    channel::Channel<T>& channel;
+    std::optional<T> item{};
+};
+
+/**
+ * Suspends the awaiting coroutine for the given time, it is resumed where
+ * the timer source runs its callbacks, like the thread pool of the timer
+ * service, once the timer fires.
+ */
+template <timer::TimerSource Timers>
+class SleepAwaiter
+{
+  public:
+    SleepAwaiter(Timers& timers, typename Timers::Clock::duration delay) noexcept
+        : timers(timers), delay(delay)
+    {}
+
+    [[nodiscard]] inline bool await_ready() const noexcept
+    {
+        return delay <= Timers::Clock::duration::zero();
+    }
+
+    template <class Promise>
+    inline void await_suspend(std::coroutine_handle<Promise> handle) const
+    {
+        timers.scheduleAfter(delay, detail::ResumeTask{handle});
+    }
+
+    inline void await_resume() const noexcept {}
+
+  private:
+    Timers& timers;
+    typename Timers::Clock::duration delay;
+};
+
+/**
+ * Suspends the awaiting coroutine until the descriptor becomes ready, it is
+ * resumed on the thread pool of the reactor with the epoll events which
+ * occurred. The descriptor must not be watched by the reactor otherwise.
+ */
+class ReadinessAwaiter
+{
+  public:
+    ReadinessAwaiter(io::Reactor& reactor, int fd, uint32_t events) noexcept
+        : reactor(reactor), fd(fd), events(events)
+    {}
+
+    [[nodiscard]] inline bool await_ready() const noexcept { return false; }
+
+    template <class Promise>
+    inline void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        reactor.watchOnce(
+            fd, events,
+            [this, resume = detail::ResumeTask{handle}](uint32_t occurred) mutable {
+                events = occurred;
+                resume();
+            },
+            io::Dispatch::Pool);
+    }
+
+    [[nodiscard]] inline uint32_t await_resume() const noexcept { return events; }
+
+  private:
+    io::Reactor& reactor;
+    int fd;
+    uint32_t events;
+};
+
+/**
+ * Moves the awaiting coroutine onto the executor.
+ */
+template <thread_pool::Executor Executor>
+[[nodiscard]] inline ScheduleAwaiter<Executor> schedule(Executor& executor) noexcept
+{
+    return ScheduleAwaiter<Executor>{executor};
+}
+
+/**
+ * Awaits the future, resuming on the executor once it is ready.
+ */
+template <thread_pool::Executor Executor, class T>
+[[nodiscard]] inline FutureAwaiter<Executor, T> wait(Executor& executor,
+                                                     future::Future<T>&& future) noexcept
+{
+    return FutureAwaiter<Executor, T>{executor, std::move(future)};
+}
+
+/**
+ * Awaits an item of the channel, resuming on the executor once it arrives.
+ */
+template <thread_pool::Executor Executor, class T>
+[[nodiscard]] inline PopAwaiter<Executor, T> pop(Executor& executor,
+                                                 channel::Channel<T>& channel) noexcept
+{
+    return PopAwaiter<Executor, T>{executor, channel};
+}
+
+/**
+ * Suspends the awaiting coroutine for at least `delay`.
+ */
+template <timer::TimerSource Timers>
+[[nodiscard]] inline SleepAwaiter<Timers> sleepFor(Timers& timers,
+                                                   typename Timers::Clock::duration delay) noexcept
+{
+    return SleepAwaiter<Timers>{timers, delay};
+}
+
+/**
+ * Awaits readiness of the descriptor, like `io::readable` or `io::writable`.
+ */
+[[nodiscard]] inline ReadinessAwaiter ready(io::Reactor& reactor, int fd, uint32_t events) noexcept
+{
+    return ReadinessAwaiter{reactor, fd, events};
+}
+
+/**
+ * Runs the task on the executor.
+ *
+ * @param executor executor the task is started on, it has to outlive the task.
+ * @param task task to be run.
+ * @return future of the task result.
+ */
+template <thread_pool::Executor Executor, class T>
+future::Future<T> spawn(Executor& executor, Task<T>&& task)
+{
+    auto promise = future::Promise<T>{};
+    auto future  = promise.getFuture();
+
+    auto driver = detail::driveTask(std::move(task), std::move(promise));
+    executor.post(detail::ResumeTask{driver.handle});
+
+    return future;
+}
+} // namespace cfdp::runtime::coroutine
+
+template <class T>
+auto cfdp::runtime::coroutine::detail::TaskPromise<T>::get_return_object() noexcept
+    -> cfdp::runtime::coroutine::Task<T>
+{
+    return cfdp::runtime::coroutine::Task<T>{
+        std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline auto cfdp::runtime::coroutine::detail::TaskPromise<void>::get_return_object() noexcept
+    -> cfdp::runtime::coroutine::Task<void>
+{
+    return cfdp::runtime::coroutine::Task<void>{
+        std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+template <class T>
+auto cfdp::runtime::coroutine::Task<T>::operator co_await() && noexcept
+{
+    return detail::TaskAwaiter<T>{handle};
+}
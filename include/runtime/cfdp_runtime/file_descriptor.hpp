@@ -0,0 +1,47 @@
+#pragma once
+
+#include <system_error>
+#include <utility>
+
+namespace cfdp::runtime::io
+{
+/**
+ * Owning wrapper of a file descriptor, closing it on destruction.
+ */
+class FileDescriptor
+{
+  public:
+    FileDescriptor() noexcept = default;
+    explicit FileDescriptor(int fd) noexcept : fd(fd) {}
+    ~FileDescriptor() { reset(); }
+
+    FileDescriptor(FileDescriptor&& other) noexcept : fd(other.release()) {}
+    FileDescriptor& operator=(FileDescriptor&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset(other.release());
+        }
+        return *this;
+    }
+
+    FileDescriptor(const FileDescriptor&)            = delete;
+    FileDescriptor& operator=(FileDescriptor const&) = delete;
+
+    [[nodiscard]] inline int get() const noexcept { return fd; }
+    [[nodiscard]] inline bool isValid() const noexcept { return fd >= 0; }
+    [[nodiscard]] inline int release() noexcept { return std::exchange(fd, -1); }
+
+    void reset(int newFd = -1) noexcept;
+
+  private:
+    int fd{-1};
+};
+
+/**
+ * Error of the last failed system call, taken from errno.
+ *
+ * @param what name of the call, becomes part of the message.
+ */
+[[nodiscard]] std::system_error lastError(const char* what);
+} // namespace cfdp::runtime::io
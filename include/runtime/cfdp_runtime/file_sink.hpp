@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "file_descriptor.hpp"
+#include "logger.hpp"
+
+namespace cfdp::runtime::logging
+{
+struct FileSinkOptions
+{
+    std::filesystem::path directory{"."};
+
+    // Segments are named `<baseName>.<sequence>.log`.
+    std::string baseName{"cfdp"};
+
+    // Space allocated for every segment up front, a batch which does not
+    // fit starts the next segment.
+    size_t segmentSize{size_t{64} << 20};
+
+    // Segments are also rotated once they are open for that long.
+    std::optional<std::chrono::seconds> maxSegmentAge{};
+
+    // Oldest segments are removed once there are more of them, zero keeps
+    // every segment.
+    size_t maxSegments{0};
+
+    // Written lines are synced to the disk at most that often, without it
+    // they reach the disk whenever the kernel writes the pages back, or when
+    // the logger is flushed.
+    std::optional<std::chrono::milliseconds> syncInterval{};
+};
+
+/**
+ * Log sink appending into memory mapped, preallocated segment files.
+ *
+ * Writing a batch is a single memcpy into the mapping, there is no system
+ * call per line or per batch, the kernel writes the pages back on its own.
+ * The lines are visible to other readers of the file right away, they are
+ * only durable after a sync though, see `syncInterval`. Flushing the logger
+ * always syncs the current segment.
+ *
+ * A segment is truncated to its contents once it is closed. Until then, and
+ * after a crash, it ends with the unused, zeroed space. New segments never
+ * overwrite the old ones, the sequence continues after the highest one
+ * found in the directory.
+ *
+ * Like every sink, it is used only by the logging backend thread. If a
+ * segment can not be created, the lines go to the standard error instead,
+ * until the next rotation succeeds.
+ */
+class MappedFileSink final : public LogSink
+{
+  public:
+    /**
+     * Opens the first segment, creating the directory if needed.
+     *
+     * @throw std::system_error if the segment could not be created.
+     */
+    explicit MappedFileSink(FileSinkOptions options);
+    ~MappedFileSink() override;
+
+    MappedFileSink(const MappedFileSink&)            = delete;
+    MappedFileSink& operator=(MappedFileSink const&) = delete;
+    MappedFileSink(MappedFileSink&&)                 = delete;
+    MappedFileSink& operator=(MappedFileSink&&)      = delete;
+
+    void write(std::string_view lines) override;
+    void flush() override;
+
+    [[nodiscard]] inline const std::filesystem::path& currentPath() const noexcept
+    {
+        return path;
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    void openSegment();
+    void closeSegment() noexcept;
+
+    // Closes the current segment and opens the next one.
+    [[nodiscard]] bool rotate() noexcept;
+    void removeOldSegments() noexcept;
+    void sync(bool force) noexcept;
+
+    [[nodiscard]] std::filesystem::path segmentPath(uint64_t index) const;
+
+    FileSinkOptions options;
+
+    uint64_t sequence{0};
+    std::filesystem::path path{};
+    io::FileDescriptor file{};
+    std::span<char> mapping{};
+    size_t used{0};
+    size_t synced{0};
+
+    Clock::time_point openedAt{};
+    Clock::time_point syncedAt{};
+};
+} // namespace cfdp::runtime::logging
@@ -1,8 +1,222 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "logger.hpp"
+#include "task.hpp"
+
+namespace cfdp::runtime::future
+{
+template <class T>
+class Future;
+
+template <class T>
+class SharedFuture;
+
+template <class T>
+class Promise;
+
+namespace detail
+{
+/**
+ * Shared state of a `Promise` and its future: the result and the
+ * callbacks waiting for it, in a single allocation.
+ *
+ * Callbacks run on the thread which satisfies the promise, so they should
+ * only hand the work over to an executor, never do it themselves. Nothing
+ * is allocated for them unless one is registered.
+ */
+template <class T>
+class PromiseState
+{
+  public:
+    template <class... Args>
+    inline void setValue(Args&&... args)
+    {
+        complete([&](Result& result) { result.template emplace<1>(std::forward<Args>(args)...); });
+    }
+
+    inline void setException(std::exception_ptr error)
+    {
+        complete([&](Result& result) { result.template emplace<2>(std::move(error)); });
+    }
+
+    // Stores the broken_promise error, unless the promise was satisfied.
+    inline void abandon() noexcept
+    {
+        auto ready = std::vector<thread_pool::Task>{};
+
+        {
+            std::scoped_lock<std::mutex> lock{mutex};
+
+            if (completed)
+            {
+                return;
+            }
+
+            result.template emplace<2>(std::make_exception_ptr(
+                std::future_error{std::future_errc::broken_promise}));
+            completed = true;
+            ready.swap(callbacks);
+        }
+
+        finish(ready);
+    }
+
+    inline void retrieve()
+    {
+        std::scoped_lock<std::mutex> lock{mutex};
+
+        if (std::exchange(retrieved, true))
+        {
+            throw std::future_error{std::future_errc::future_already_retrieved};
+        }
+    }
+
+    /**
+     * Registers a callback, running it immediately if the promise was
+     * already satisfied.
+     *
+     * @throw std::bad_alloc if the callback could not be stored.
+     */
+    inline void subscribe(thread_pool::Task&& callback)
+    {
+        {
+            std::scoped_lock<std::mutex> lock{mutex};
+
+            if (!completed)
+            {
+                callbacks.push_back(std::move(callback));
+                return;
+            }
+        }
+
+        run(callback);
+    }
+
+    template <class Rep, class Period>
+    [[nodiscard]] inline std::future_status
+    waitFor(std::chrono::duration<Rep, Period> timeout) const noexcept
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+
+        return completedCond.wait_for(lock, timeout, [this]() { return completed; })
+                   ? std::future_status::ready
+                   : std::future_status::timeout;
+    }
+
+    // Moves the value out, for a Future.
+    [[nodiscard]] inline T take()
+    {
+        wait();
+
+        if (result.index() == 2)
+        {
+            std::rethrow_exception(std::get<2>(result));
+        }
+
+        if constexpr (!std::is_void_v<T>)
+        {
+            return std::move(std::get<1>(result));
+        }
+    }
+
+    // Copies the value, for a SharedFuture.
+    [[nodiscard]] inline T copy() const
+    {
+        wait();
+
+        if (result.index() == 2)
+        {
+            std::rethrow_exception(std::get<2>(result));
+        }
+
+        if constexpr (!std::is_void_v<T>)
+        {
+            return std::get<1>(result);
+        }
+    }
+
+    // A failing callback must not keep the others from running, nor
+    // escape into the promise, which may be completed by a destructor.
+    static inline void run(thread_pool::Task& callback) noexcept
+    {
+        try
+        {
+            callback();
+        }
+        catch (const std::exception& error)
+        {
+            logging::error("a future continuation failed: {}", error.what());
+        }
+        catch (...)
+        {
+            logging::error("a future continuation failed");
+        }
+    }
+
+  private:
+    using Stored = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+    using Result = std::variant<std::monostate, Stored, std::exception_ptr>;
+
+    template <class Store>
+    inline void complete(Store&& store)
+    {
+        auto ready = std::vector<thread_pool::Task>{};
+
+        {
+            std::scoped_lock<std::mutex> lock{mutex};
+
+            if (completed)
+            {
+                throw std::future_error{std::future_errc::promise_already_satisfied};
+            }
+
+            store(result);
+            completed = true;
+            ready.swap(callbacks);
+        }
+
+        finish(ready);
+    }
+
+    inline void finish(std::vector<thread_pool::Task>& ready) noexcept
+    {
+        completedCond.notify_all();
+
+        for (auto& callback : ready)
+        {
+            run(callback);
+        }
+    }
+
+    inline void wait() const
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+        completedCond.wait(lock, [this]() { return completed; });
+    }
+
+    mutable std::mutex mutex{};
+    mutable std::condition_variable completedCond{};
+    bool completed{false};
+    bool retrieved{false};
+    Result result{};
+    std::vector<thread_pool::Task> callbacks{};
+};
+} // namespace detail
+} // namespace cfdp::runtime::future
 
 namespace
 {
@@ -14,6 +228,20 @@ class FutureBase
   public:
     [[nodiscard]] inline ValueType get()
     {
+        if (state != nullptr)
+        {
+            if constexpr (std::is_same_v<FutureLike<ValueType>, std::future<ValueType>>)
+            {
+                // Like std::future, the future is no longer valid once read.
+                const auto owned = std::move(state);
+                return owned->take();
+            }
+            else
+            {
+                return state->copy();
+            }
+        }
+
         if (!internal.valid())
         {
             throw std::future_error{std::future_errc::future_already_retrieved};
@@ -29,7 +257,25 @@ class FutureBase
      */
     [[nodiscard]] inline std::future_status poll(uint64_t timeout_s = 0) const noexcept
     {
-        return internal.wait_for(std::chrono::seconds(timeout_s));
+        return waitFor(std::chrono::seconds(timeout_s));
+    };
+
+    /**
+     * Returns a future status after specified timeout passed. Unlike `poll`,
+     * accepts any duration, down to the resolution of the steady clock.
+     *
+     * @param timeout how long should the call wait before returning.
+     * @return std::future_status::ready or std::future_status::timeout.
+     */
+    template <class Rep, class Period>
+    [[nodiscard]] inline std::future_status
+    waitFor(std::chrono::duration<Rep, Period> timeout) const noexcept
+    {
+        if (state != nullptr)
+        {
+            return state->waitFor(timeout);
+        }
+        return internal.wait_for(timeout);
     };
 
     [[nodiscard]] inline bool isReady() const noexcept
@@ -38,8 +284,20 @@ class FutureBase
     };
 
   protected:
+    // A future comes either from a std::promise, or from a `Promise`, then
+    // it shares the state of that promise.
     FutureLike<ValueType> internal;
-    FutureBase(FutureLike<ValueType> f) : internal{std::move(f)} {}
+    std::shared_ptr<cfdp::runtime::future::detail::PromiseState<ValueType>> state;
+
+    FutureBase(FutureLike<ValueType> f,
+               std::shared_ptr<cfdp::runtime::future::detail::PromiseState<ValueType>> state)
+        : internal{std::move(f)}, state{std::move(state)}
+    {}
+
+    [[nodiscard]] inline bool isValid() const noexcept
+    {
+        return state != nullptr || internal.valid();
+    }
 };
 } // namespace
 
@@ -49,7 +307,8 @@ template <class T>
 class SharedFuture : public FutureBase<std::shared_future, T>
 {
   public:
-    explicit SharedFuture(std::shared_future<T> f) : FutureBase<std::shared_future, T>{std::move(f)}
+    explicit SharedFuture(std::shared_future<T> f)
+        : FutureBase<std::shared_future, T>{std::move(f), nullptr}
     {}
 
     ~SharedFuture()                              = default;
@@ -58,29 +317,389 @@ class SharedFuture : public FutureBase<std::shared_future, T>
     SharedFuture(SharedFuture&&)                 = default;
 
     SharedFuture& operator=(SharedFuture&&) = delete;
+
+  private:
+    friend class Future<T>;
+
+    explicit SharedFuture(std::shared_ptr<detail::PromiseState<T>> state)
+        : FutureBase<std::shared_future, T>{std::shared_future<T>{}, std::move(state)}
+    {}
 };
 
 template <class T>
 class Future : public FutureBase<std::future, T>
 {
   public:
-    explicit Future(std::future<T> f) : FutureBase<std::future, T>{std::move(f)} {}
+    explicit Future(std::future<T> f) : FutureBase<std::future, T>{std::move(f), nullptr} {}
 
-    ~Future()                   = default;
-    Future(Future&&)            = default;
-    Future& operator=(Future&&) = default;
+    ~Future()                            = default;
+    Future(Future&&) noexcept            = default;
+    Future& operator=(Future&&) noexcept = default;
 
     Future(const Future&)            = delete;
     Future& operator=(Future const&) = delete;
 
     [[nodiscard]] SharedFuture<T> makeShared()
     {
-        if (!this->internal.valid())
+        if (!this->isValid())
         {
             throw std::future_error{std::future_errc::future_already_retrieved};
         }
 
+        if (this->state != nullptr)
+        {
+            return SharedFuture<T>{std::move(this->state)};
+        }
+
         return SharedFuture<T>{this->internal.share()};
     };
+
+    /**
+     * Consumes the future and calls `callback` with it, once it is ready.
+     *
+     * The callback runs on the thread which satisfies the promise, or on the
+     * calling thread if the future is ready already. Only futures created by
+     * a `Promise` can be waited on, otherwise std::future_error is thrown,
+     * unless the future is already ready.
+     *
+     * @param callback functor accepting the ready Future<T>.
+     */
+    template <class Callback>
+        requires std::invocable<Callback, Future<T>&&>
+    void onReady(Callback&& callback) &&;
+
+    /**
+     * Consumes the future and schedules `func` on the `executor` once the
+     * result is available, without blocking any thread in the meantime.
+     *
+     * The value of this future is passed to `func`, unless it holds an
+     * exception, then the exception is propagated to the returned future
+     * and `func` is never called.
+     *
+     * @param executor executor which runs `func`, it has to outlive the call.
+     * @param func continuation accepting the value of this future.
+     * @return future of the continuation result.
+     */
+    template <thread_pool::Executor Executor, class Functor>
+    auto then(Executor& executor, Functor&& func) &&;
+
+  private:
+    friend class Promise<T>;
+
+    explicit Future(std::shared_ptr<detail::PromiseState<T>> state)
+        : FutureBase<std::future, T>{std::future<T>{}, std::move(state)}
+    {}
+};
+
+/**
+ * Producer side of a `Future`, able to run continuations once satisfied.
+ *
+ * Unlike std::promise, it shares its state with the future directly, so a
+ * continuation costs no allocation beyond its own callback. A promise
+ * destroyed without being satisfied breaks its future (just like
+ * std::promise does) and still runs its continuations, so nothing waits
+ * forever for a result that will never come.
+ */
+template <class T>
+class Promise
+{
+  public:
+    Promise() : state{std::make_shared<detail::PromiseState<T>>()} {}
+    ~Promise() { abandon(); }
+
+    Promise(Promise&&) noexcept = default;
+
+    Promise& operator=(Promise&& other) noexcept
+    {
+        if (this != &other)
+        {
+            abandon();
+            state = std::move(other.state);
+        }
+        return *this;
+    }
+
+    Promise(const Promise&)            = delete;
+    Promise& operator=(Promise const&) = delete;
+
+    [[nodiscard]] inline Future<T> getFuture()
+    {
+        checkState().retrieve();
+        return Future<T>{state};
+    }
+
+    template <class... Args>
+    inline void setValue(Args&&... args)
+    {
+        checkState().setValue(std::forward<Args>(args)...);
+    }
+
+    inline void setException(std::exception_ptr error)
+    {
+        checkState().setException(std::move(error));
+    }
+
+  private:
+    [[nodiscard]] inline detail::PromiseState<T>& checkState() const
+    {
+        if (state == nullptr)
+        {
+            throw std::future_error{std::future_errc::no_state};
+        }
+        return *state;
+    }
+
+    inline void abandon() noexcept
+    {
+        if (state != nullptr)
+        {
+            std::exchange(state, nullptr)->abandon();
+        }
+    }
+
+    // Empty once the promise is moved from or abandoned.
+    std::shared_ptr<detail::PromiseState<T>> state;
+};
+
+template <class T, class Functor>
+struct ContinuationResult
+{
+    using type = std::invoke_result_t<Functor&, T&&>;
 };
+
+template <class Functor>
+struct ContinuationResult<void, Functor>
+{
+    using type = std::invoke_result_t<Functor&>;
+};
+
+template <class T>
+using WhenAllResult = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+template <class T>
+using WhenAnyResult = std::conditional_t<std::is_void_v<T>, size_t, std::pair<size_t, T>>;
+
+/**
+ * Returns a future which becomes ready once all of `futures` are ready.
+ *
+ * The values are collected in the order of `futures`. If any of them holds
+ * an exception, the first one to arrive is propagated instead.
+ */
+template <class T>
+Future<WhenAllResult<T>> whenAll(std::vector<Future<T>> futures);
+
+/**
+ * Returns a future which becomes ready as soon as any of `futures` is
+ * ready. It holds the index of that future together with its value, or
+ * the exception it was holding.
+ */
+template <class T>
+Future<WhenAnyResult<T>> whenAny(std::vector<Future<T>> futures);
 } // namespace cfdp::runtime::future
+
+template <class T>
+template <class Callback>
+    requires std::invocable<Callback, cfdp::runtime::future::Future<T>&&>
+void cfdp::runtime::future::Future<T>::onReady(Callback&& callback) &&
+{
+    if (!this->isValid())
+    {
+        throw std::future_error{std::future_errc::no_state};
+    }
+
+    if (this->state == nullptr)
+    {
+        if (!this->isReady())
+        {
+            throw std::future_error{std::future_errc::no_state};
+        }
+
+        std::invoke(std::forward<Callback>(callback), std::move(*this));
+        return;
+    }
+
+    // The callback holds this future, and with it the state, until the
+    // promise is satisfied or abandoned and the callback has run.
+    auto shared = this->state;
+
+    shared->subscribe(
+        [self = std::move(*this), callback = std::forward<Callback>(callback)]() mutable {
+            std::invoke(callback, std::move(self));
+        });
+}
+
+template <class T>
+template <cfdp::runtime::thread_pool::Executor Executor, class Functor>
+auto cfdp::runtime::future::Future<T>::then(Executor& executor, Functor&& func) &&
+{
+    using Result = typename ContinuationResult<T, std::decay_t<Functor>>::type;
+
+    auto promise = Promise<Result>{};
+    auto future  = promise.getFuture();
+
+    std::move(*this).onReady([&executor, promise = std::move(promise),
+                              func = std::forward<Functor>(func)](Future<T>&& ready) mutable {
+        executor.post([ready = std::move(ready), promise = std::move(promise),
+                       func = std::move(func)]() mutable {
+            try
+            {
+                if constexpr (std::is_void_v<T> && std::is_void_v<Result>)
+                {
+                    ready.get();
+                    std::invoke(func);
+                    promise.setValue();
+                }
+                else if constexpr (std::is_void_v<T>)
+                {
+                    ready.get();
+                    promise.setValue(std::invoke(func));
+                }
+                else if constexpr (std::is_void_v<Result>)
+                {
+                    std::invoke(func, ready.get());
+                    promise.setValue();
+                }
+                else
+                {
+                    promise.setValue(std::invoke(func, ready.get()));
+                }
+            }
+            catch (...)
+            {
+                promise.setException(std::current_exception());
+            }
+        });
+    });
+
+    return future;
+}
+
+template <class T>
+auto cfdp::runtime::future::whenAll(std::vector<Future<T>> futures) -> Future<WhenAllResult<T>>
+{
+    // `void` cannot be stored in an optional, the values are not needed then.
+    using Stored = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    struct Aggregate
+    {
+        std::mutex mutex{};
+        size_t remaining{0};
+        std::vector<std::optional<Stored>> values{};
+        std::exception_ptr error{};
+        Promise<WhenAllResult<T>> promise{};
+    };
+
+    auto aggregate       = std::make_shared<Aggregate>();
+    aggregate->remaining = futures.size();
+    auto result          = aggregate->promise.getFuture();
+
+    if constexpr (!std::is_void_v<T>)
+    {
+        aggregate->values.resize(futures.size());
+    }
+
+    auto finish = [](Aggregate& state) {
+        if (state.error)
+        {
+            state.promise.setException(state.error);
+        }
+        else if constexpr (std::is_void_v<T>)
+        {
+            state.promise.setValue();
+        }
+        else
+        {
+            auto values = std::vector<Stored>{};
+            values.reserve(state.values.size());
+
+            for (auto& value : state.values)
+            {
+                values.push_back(std::move(value.value()));
+            }
+
+            state.promise.setValue(std::move(values));
+        }
+    };
+
+    if (futures.empty())
+    {
+        finish(*aggregate);
+        return result;
+    }
+
+    for (size_t index = 0; index < futures.size(); ++index)
+    {
+        std::move(futures[index]).onReady([aggregate, index, finish](Future<T>&& ready) {
+            auto lock = std::unique_lock<std::mutex>{aggregate->mutex};
+
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    ready.get();
+                }
+                else
+                {
+                    aggregate->values[index].emplace(ready.get());
+                }
+            }
+            catch (...)
+            {
+                if (!aggregate->error)
+                {
+                    aggregate->error = std::current_exception();
+                }
+            }
+
+            if (--aggregate->remaining == 0)
+            {
+                lock.unlock();
+                finish(*aggregate);
+            }
+        });
+    }
+
+    return result;
+}
+
+template <class T>
+auto cfdp::runtime::future::whenAny(std::vector<Future<T>> futures) -> Future<WhenAnyResult<T>>
+{
+    struct Aggregate
+    {
+        std::atomic_bool resolved{false};
+        Promise<WhenAnyResult<T>> promise{};
+    };
+
+    auto aggregate = std::make_shared<Aggregate>();
+    auto result    = aggregate->promise.getFuture();
+
+    for (size_t index = 0; index < futures.size(); ++index)
+    {
+        std::move(futures[index]).onReady([aggregate, index](Future<T>&& ready) {
+            if (aggregate->resolved.exchange(true))
+            {
+                return;
+            }
+
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    ready.get();
+                    aggregate->promise.setValue(index);
+                }
+                else
+                {
+                    aggregate->promise.setValue(std::make_pair(index, ready.get()));
+                }
+            }
+            catch (...)
+            {
+                aggregate->promise.setException(std::current_exception());
+            }
+        });
+    }
+
+    return result;
+}
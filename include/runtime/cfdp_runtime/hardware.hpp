@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace cfdp::runtime::hardware
+{
+// We could use `std::hardware_destructive_interference_size`, but its
+// value depends on the compiler flags, which makes it unsuitable for
+// anything visible in public headers. 64 bytes is correct for x86-64
+// and most of the ARM cores we are targeting.
+constexpr size_t cache_line_size = 64;
+
+// Logical CPU numbers, as used by the kernel.
+using CpuSet = std::vector<size_t>;
+
+/**
+ * Parses a CPU list in the kernel format, like "0-3,8,10-11".
+ *
+ * @return std::nullopt if the list is malformed.
+ */
+[[nodiscard]] std::optional<CpuSet> parseCpuList(std::string_view list) noexcept;
+
+/**
+ * Returns the CPUs belonging to a NUMA node, read from sysfs.
+ *
+ * @return empty set if the node does not exist or sysfs is unavailable.
+ */
+[[nodiscard]] CpuSet numaNodeCpus(size_t node) noexcept;
+
+/**
+ * Returns the number of online NUMA nodes, a machine without NUMA support
+ * counts as a single node.
+ */
+[[nodiscard]] size_t numNumaNodes() noexcept;
+
+/**
+ * Restricts the calling thread to the given CPUs.
+ *
+ * @return false if the affinity could not be changed.
+ */
+bool pinCurrentThread(const CpuSet& cpus) noexcept;
+
+/**
+ * Makes the calling thread prefer memory of the given NUMA node for its
+ * new allocations, falling back to other nodes once the node is full.
+ *
+ * @return false if the memory policy could not be changed.
+ */
+bool preferNumaNode(size_t node) noexcept;
+} // namespace cfdp::runtime::hardware
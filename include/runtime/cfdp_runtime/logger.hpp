@@ -1,10 +1,23 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <bit>
 #include <chrono>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <format>
-#include <mutex>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #if defined(CFDP_LOG_LEVEL_TRACE)
 #define LOG_TRACE
@@ -37,37 +50,239 @@ enum class LogLevel : uint8_t
     Error,
 };
 
+/**
+ * Subsystems with their own log level.
+ */
+enum class LogModule : uint8_t
+{
+    General = 0,
+    ThreadPool,
+    Timer,
+    Reactor,
+    Simulation,
+    Sender,
+};
+
+constexpr size_t num_log_modules = 6;
+
+/**
+ * Runtime thresholds of the modules, messages below the threshold of their
+ * module are dropped. Every module starts at Trace, so by default only the
+ * compile time `CFDP_LOG_LEVEL_*` limit applies, which still takes precedence:
+ * levels compiled out can not be turned back on at runtime.
+ *
+ * Checking a threshold costs a single relaxed load, so it can be raised
+ * or lowered for one module while the rest of the runtime is under load.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+inline auto module_levels = std::array<std::atomic<LogLevel>, num_log_modules>{};
+
+inline void setLevel(LogModule module, LogLevel level) noexcept
+{
+    module_levels[static_cast<size_t>(module)].store(level, std::memory_order_relaxed);
+}
+
+inline void setLevel(LogLevel level) noexcept
+{
+    for (auto& threshold : module_levels)
+    {
+        threshold.store(level, std::memory_order_relaxed);
+    }
+}
+
+[[nodiscard]] inline LogLevel level(LogModule module) noexcept
+{
+    return module_levels[static_cast<size_t>(module)].load(std::memory_order_relaxed);
+}
+
+[[nodiscard]] inline bool isEnabled(LogModule module, LogLevel level) noexcept
+{
+    return level >= module_levels[static_cast<size_t>(module)].load(std::memory_order_relaxed);
+}
+
+[[nodiscard]] std::optional<LogLevel> parseLevel(std::string_view name) noexcept;
+[[nodiscard]] std::optional<LogModule> parseModule(std::string_view name) noexcept;
+
+/**
+ * Sets the thresholds from a comma separated list of `module=level` pairs,
+ * a bare level applies to every module, e.g. `warn,thread_pool=debug`.
+ * Meant for levels coming from the environment or a configuration file.
+ *
+ * @return false if any entry is malformed, the valid ones are applied anyway.
+ */
+bool configureLevels(std::string_view spec) noexcept;
+
+/**
+ * Destination of the formatted log lines.
+ *
+ * Sinks are only ever called from the logging backend thread, one batch
+ * of complete, newline terminated lines at a time.
+ */
+class LogSink
+{
+  public:
+    LogSink()          = default;
+    virtual ~LogSink() = default;
+
+    LogSink(const LogSink&)            = delete;
+    LogSink& operator=(LogSink const&) = delete;
+    LogSink(LogSink&&)                 = delete;
+    LogSink& operator=(LogSink&&)      = delete;
+
+    virtual void write(std::string_view lines) = 0;
+    virtual void flush() {}
+};
+
+class StdoutSink final : public LogSink
+{
+  public:
+    void write(std::string_view lines) override;
+    void flush() override;
+};
+
+/**
+ * Replaces the sink, every message logged before is written to the old one.
+ * The default sink writes to the standard output.
+ */
+void setSink(std::unique_ptr<LogSink> sink);
+
+/**
+ * Blocks until every message logged so far by the calling thread is written
+ * to the sink and the sink is flushed.
+ */
+void flush() noexcept;
+
+// Formats the arguments captured by a deferred log call, on the backend.
+using DeferredFormatter = void (*)(std::string& out, std::string_view format,
+                                   const std::byte* arguments);
+
+// Space for the arguments of a deferred log call, calls with larger
+// arguments are formatted right away.
+constexpr size_t max_deferred_size = 48;
+
+/**
+ * Arguments which can be captured as raw bytes and formatted later. They
+ * have to be plain values, anything referring to other memory (pointers,
+ * strings, views) could be gone by the time the backend formats them.
+ */
+template <class T>
+concept Deferrable = std::is_trivially_copyable_v<T> &&
+                     (std::is_arithmetic_v<T> || std::same_as<T, std::thread::id>);
+
+/**
+ * Front end of the asynchronous logger.
+ *
+ * A log call only stores the message with its metadata in a ring owned by
+ * the calling thread, it never takes a lock and never touches the sink.
+ * A single backend thread collects the records from all the rings, formats
+ * them and writes them to the sink in batches. The backend sleeps while
+ * there is nothing to log, waking it up costs a producer one atomic
+ * notification, and only if it is actually asleep. Once a ring is full,
+ * the producer waits for the backend to catch up, messages are never lost.
+ *
+ * When every argument is Deferrable, even the formatting is left to the
+ * backend. The call only copies the format string pointer and the raw
+ * bytes of the arguments, so it is cheap enough for the hot paths.
+ */
 class Logger
 {
   public:
     void log(LogLevel level, std::string msg) const noexcept;
 
-  private:
-    // NOTE: 14.10.2024 <@uncommon-nickname>
-    // We need this mutex to be static, our entrypoint logging functions
-    // use templates and each specialization has its own static logger
-    // object. This way we will avoid log races.
-    static inline std::mutex mutex{}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    /**
+     * Logs a message formatted later on the backend thread.
+     *
+     * @param format format string, it has to outlive the program, like
+     *        a string literal does.
+     * @param formatter function decoding `arguments` and formatting them.
+     * @param arguments raw bytes of the arguments, up to max_deferred_size.
+     */
+    void logDeferred(LogLevel level, std::string_view format, DeferredFormatter formatter,
+                     std::span<const std::byte> arguments) const noexcept;
+};
+
+namespace detail
+{
+template <class... Args>
+inline constexpr size_t deferred_size = (size_t{0} + ... + sizeof(Args));
+
+template <class... Args>
+inline constexpr auto deferred_offsets = []() {
+    auto offsets = std::array<size_t, sizeof...(Args)>{};
+    auto offset  = size_t{0};
+    auto index   = size_t{0};
+
+    ((offsets[index++] = offset, offset += sizeof(Args)), ...);
+
+    return offsets;
+}();
+
+// Arguments are packed without any padding, so they are copied out
+// instead of being accessed in place.
+template <class T>
+[[nodiscard]] T readDeferred(const std::byte* from) noexcept
+{
+    auto bytes = std::array<std::byte, sizeof(T)>{};
+    std::memcpy(bytes.data(), from, sizeof(T));
+
+    return std::bit_cast<T>(bytes);
+}
+
+template <class... Args, size_t... Indices>
+void formatDeferred(std::string& out, std::string_view format,
+                    [[maybe_unused]] const std::byte* arguments,
+                    std::index_sequence<Indices...> /*indices*/)
+{
+    // Both are left unused by messages without arguments.
+    [[maybe_unused]] auto values = std::tuple<Args...>{
+        readDeferred<Args>(arguments + deferred_offsets<Args...>[Indices])...};
+
+    std::vformat_to(std::back_inserter(out), format,
+                    std::make_format_args(std::get<Indices>(values)...));
+}
+
+template <class... Args>
+void formatDeferred(std::string& out, std::string_view format, const std::byte* arguments)
+{
+    formatDeferred<Args...>(out, format, arguments, std::index_sequence_for<Args...>{});
+}
+} // namespace detail
 
-    [[nodiscard]] inline std::thread::id getThreadID() const noexcept
+template <class... Args>
+constexpr static void log(LogModule module, LogLevel level, std::format_string<Args...> msg,
+                          Args&&... args) noexcept
+{
+    static auto logger = Logger{};
+
+    if (!isEnabled(module, level))
     {
-        return std::this_thread::get_id();
+        return;
     }
 
-    [[nodiscard]] inline std::string getCurrentTimestamp() const noexcept
+    if constexpr ((Deferrable<std::remove_cvref_t<Args>> && ...) &&
+                  detail::deferred_size<std::remove_cvref_t<Args>...> <= max_deferred_size)
     {
-        const auto now = std::chrono::system_clock::now();
-        return std::format("{:%d-%m-%Y %H:%M:%OS}", now);
+        auto arguments =
+            std::array<std::byte, detail::deferred_size<std::remove_cvref_t<Args>...>>{};
+        auto offset    = size_t{0};
+
+        ((std::memcpy(arguments.data() + offset, &args, sizeof(args)), offset += sizeof(args)),
+         ...);
+
+        logger.logDeferred(level, msg.get(), &detail::formatDeferred<std::remove_cvref_t<Args>...>,
+                           arguments);
     }
-};
+    else
+    {
+        auto log = std::vformat(msg.get(), std::make_format_args(args...));
+        logger.log(level, std::move(log));
+    }
+}
 
 template <class... Args>
 constexpr static void log(LogLevel level, std::format_string<Args...> msg, Args&&... args) noexcept
 {
-    static auto logger = Logger{};
-
-    auto log = std::vformat(msg.get(), std::make_format_args(args...));
-    logger.log(level, std::move(log));
+    log(LogModule::General, level, msg, std::forward<Args>(args)...);
 }
 
 template <class... Args>
@@ -78,6 +293,14 @@ constexpr static void trace(std::format_string<Args...> msg, Args&&... args) noe
 #endif
 }
 
+template <LogModule module, class... Args>
+constexpr static void trace(std::format_string<Args...> msg, Args&&... args) noexcept
+{
+#if defined(LOG_TRACE)
+    log(module, LogLevel::Trace, msg, std::forward<Args>(args)...);
+#endif
+}
+
 template <class... Args>
 constexpr static void debug(std::format_string<Args...> msg, Args&&... args) noexcept
 {
@@ -86,6 +309,14 @@ constexpr static void debug(std::format_string<Args...> msg, Args&&... args) noe
 #endif
 }
 
+template <LogModule module, class... Args>
+constexpr static void debug(std::format_string<Args...> msg, Args&&... args) noexcept
+{
+#if defined(LOG_DEBUG)
+    log(module, LogLevel::Debug, msg, std::forward<Args>(args)...);
+#endif
+}
+
 template <class... Args>
 constexpr static void info(std::format_string<Args...> msg, Args&&... args) noexcept
 {
@@ -94,6 +325,14 @@ constexpr static void info(std::format_string<Args...> msg, Args&&... args) noex
 #endif
 }
 
+template <LogModule module, class... Args>
+constexpr static void info(std::format_string<Args...> msg, Args&&... args) noexcept
+{
+#if defined(LOG_INFO)
+    log(module, LogLevel::Info, msg, std::forward<Args>(args)...);
+#endif
+}
+
 template <class... Args>
 constexpr static void warn(std::format_string<Args...> msg, Args&&... args) noexcept
 {
@@ -102,6 +341,14 @@ constexpr static void warn(std::format_string<Args...> msg, Args&&... args) noex
 #endif
 }
 
+template <LogModule module, class... Args>
+constexpr static void warn(std::format_string<Args...> msg, Args&&... args) noexcept
+{
+#if defined(LOG_WARN)
+    log(module, LogLevel::Warn, msg, std::forward<Args>(args)...);
+#endif
+}
+
 template <class... Args>
 constexpr static void error(std::format_string<Args...> msg, Args&&... args) noexcept
 {
@@ -109,4 +356,12 @@ constexpr static void error(std::format_string<Args...> msg, Args&&... args) noe
     log(LogLevel::Error, msg, std::forward<Args>(args)...);
 #endif
 }
+
+template <LogModule module, class... Args>
+constexpr static void error(std::format_string<Args...> msg, Args&&... args) noexcept
+{
+#if defined(LOG_ERROR)
+    log(module, LogLevel::Error, msg, std::forward<Args>(args)...);
+#endif
+}
 } // namespace cfdp::runtime::logging
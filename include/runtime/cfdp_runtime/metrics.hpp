@@ -0,0 +1,304 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "hardware.hpp"
+
+namespace cfdp::runtime::metrics
+{
+// Cells every counter and histogram is split into. Threads updating the
+// same metric mostly land in different cells, so they do not fight over
+// a single cache line.
+constexpr size_t num_shards = 8;
+
+/**
+ * Cell updated by the calling thread, threads are spread over the cells in
+ * the order they first update any metric.
+ */
+[[nodiscard]] inline size_t shardIndex() noexcept
+{
+    static auto nextShard         = std::atomic<size_t>{0};
+    thread_local const auto shard = nextShard.fetch_add(1, std::memory_order_relaxed) % num_shards;
+
+    return shard;
+}
+
+/**
+ * Monotonically increasing count, like the number of PDUs sent.
+ */
+class Counter
+{
+  public:
+    Counter() = default;
+
+    Counter(const Counter&)            = delete;
+    Counter& operator=(Counter const&) = delete;
+    Counter(Counter&&)                 = delete;
+    Counter& operator=(Counter&&)      = delete;
+
+    inline void add(uint64_t amount = 1) noexcept
+    {
+        cells[shardIndex()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * Sums up the cells. Updates racing with the read may or may not be
+     * included, the result is never lower than any previous read.
+     */
+    [[nodiscard]] uint64_t value() const noexcept;
+
+  private:
+    struct alignas(hardware::cache_line_size) Cell
+    {
+        std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Cell, num_shards> cells{};
+};
+
+/**
+ * Value going up and down, like the number of open transactions. Gauges
+ * are set rather than accumulated, so a gauge is a single atomic.
+ */
+class Gauge
+{
+  public:
+    Gauge() = default;
+
+    Gauge(const Gauge&)            = delete;
+    Gauge& operator=(Gauge const&) = delete;
+    Gauge(Gauge&&)                 = delete;
+    Gauge& operator=(Gauge&&)      = delete;
+
+    inline void set(int64_t value) noexcept { current.store(value, std::memory_order_relaxed); }
+    inline void add(int64_t amount) noexcept
+    {
+        current.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] inline int64_t value() const noexcept
+    {
+        return current.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<int64_t> current{0};
+};
+
+/**
+ * Aggregated state of a histogram.
+ */
+struct HistogramSnapshot
+{
+    uint64_t count{0};
+    uint64_t sum{0};
+
+    // Non empty buckets in ascending order, as pairs of the inclusive upper
+    // bound of the bucket and the number of values in it.
+    std::vector<std::pair<uint64_t, uint64_t>> buckets{};
+
+    /**
+     * Returns the upper bound of the bucket holding the `q` quantile, so
+     * the result overestimates the real value by at most one bucket.
+     *
+     * @param q quantile, from 0.0 to 1.0.
+     */
+    [[nodiscard]] uint64_t quantile(double q) const noexcept;
+};
+
+/**
+ * Distribution of unsigned values, like latencies in nanoseconds or sizes
+ * in bytes, covering the whole 64 bit range.
+ *
+ * Buckets follow the HDR histogram layout: every power of two is split into
+ * 2^sub_bucket_bits linear buckets, so each value is recorded with a relative
+ * error of at most 1 / 2^sub_bucket_bits, no matter its magnitude. Recording
+ * is two relaxed increments in the cell of the calling thread.
+ */
+class Histogram
+{
+  public:
+    static constexpr size_t sub_bucket_bits  = 3;
+    static constexpr size_t sub_bucket_count = size_t{1} << sub_bucket_bits;
+    static constexpr size_t num_buckets =
+        2 * sub_bucket_count + (64 - sub_bucket_bits - 1) * sub_bucket_count;
+
+    Histogram() = default;
+
+    Histogram(const Histogram&)            = delete;
+    Histogram& operator=(Histogram const&) = delete;
+    Histogram(Histogram&&)                 = delete;
+    Histogram& operator=(Histogram&&)      = delete;
+
+    inline void record(uint64_t value) noexcept
+    {
+        auto& shard = shards[shardIndex()];
+
+        shard.buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] HistogramSnapshot snapshot() const;
+
+    [[nodiscard]] static constexpr size_t bucketIndex(uint64_t value) noexcept;
+    [[nodiscard]] static constexpr uint64_t bucketUpperBound(size_t index) noexcept;
+
+  private:
+    struct alignas(hardware::cache_line_size) Shard
+    {
+        std::atomic<uint64_t> sum{0};
+        std::array<std::atomic<uint64_t>, num_buckets> buckets{};
+    };
+
+    std::array<Shard, num_shards> shards{};
+};
+
+// Label names and values of a single time series, like {{"lane", "high"}}.
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * Named collection of metrics, exported in the Prometheus text format.
+ *
+ * Metrics are created once and then updated through the returned reference,
+ * which stays valid for the lifetime of the registry, so updates never touch
+ * the registry itself. Only creating metrics and exporting them takes the
+ * registry lock.
+ *
+ * Asking for an existing metric returns it, asking for a name already used
+ * by a metric of another kind throws std::invalid_argument, as does a name
+ * which is not a valid Prometheus metric name.
+ */
+class Registry
+{
+  public:
+    Registry() = default;
+
+    Registry(const Registry&)            = delete;
+    Registry& operator=(Registry const&) = delete;
+    Registry(Registry&&)                 = delete;
+    Registry& operator=(Registry&&)      = delete;
+
+    /**
+     * Registry used by the runtime itself.
+     */
+    [[nodiscard]] static Registry& global();
+
+    Counter& counter(std::string_view name, std::string_view help, const Labels& labels = {});
+    Gauge& gauge(std::string_view name, std::string_view help, const Labels& labels = {});
+    Histogram& histogram(std::string_view name, std::string_view help, const Labels& labels = {});
+
+    /**
+     * Registers a gauge read only when the metrics are exported, like the
+     * depth of a queue which is already tracked elsewhere. The callback runs
+     * under the registry lock and must not use the registry. It replaces any
+     * series of the same name and labels.
+     */
+    void callbackGauge(std::string_view name, std::string_view help, const Labels& labels,
+                       std::function<double()> read);
+
+    /**
+     * Removes a single time series, references to it become dangling.
+     *
+     * @return false if there was no such series.
+     */
+    bool remove(std::string_view name, const Labels& labels = {});
+
+    /**
+     * Removes a single time series by its key, which never allocates, so
+     * series can be removed from destructors.
+     *
+     * @param key labels rendered by `seriesKey`.
+     * @return false if there was no such series.
+     */
+    bool remove(std::string_view name, std::string_view key) noexcept;
+
+    /**
+     * Renders the labels into the key identifying a series of a metric.
+     *
+     * @throw std::invalid_argument if a label name is not valid.
+     */
+    [[nodiscard]] static std::string seriesKey(const Labels& labels);
+
+    /**
+     * Renders every metric in the Prometheus text exposition format.
+     */
+    [[nodiscard]] std::string exportText() const;
+
+    /**
+     * Writes the metrics to a file, replacing it atomically, so the file can
+     * be picked up by the node exporter textfile collector at any time.
+     *
+     * @throw std::system_error if the file could not be written.
+     */
+    void exportToFile(const std::filesystem::path& path) const;
+
+    /**
+     * Sends the metrics to a local agent listening on a unix stream socket.
+     *
+     * @throw std::system_error if the socket could not be written.
+     */
+    void exportToSocket(const std::filesystem::path& path) const;
+
+  private:
+    using Metric = std::variant<std::unique_ptr<Counter>, std::unique_ptr<Gauge>,
+                                std::unique_ptr<Histogram>, std::function<double()>>;
+
+    struct Family
+    {
+        std::string help;
+        std::string_view type;
+
+        // Series keyed by their rendered labels, like `{lane="high"}`.
+        std::map<std::string, Metric, std::less<>> series{};
+    };
+
+    // Returns the series, creating it with `create` if it does not exist.
+    Metric& findOrInsert(std::string_view name, std::string_view help, std::string_view type,
+                         const Labels& labels, const std::function<Metric()>& create);
+
+    mutable std::mutex mutex{};
+    std::map<std::string, Family, std::less<>> families{};
+};
+} // namespace cfdp::runtime::metrics
+
+constexpr size_t cfdp::runtime::metrics::Histogram::bucketIndex(uint64_t value) noexcept
+{
+    // Values below two full sets of sub buckets are kept exactly.
+    if (value < 2 * sub_bucket_count)
+    {
+        return static_cast<size_t>(value);
+    }
+
+    const auto shift = static_cast<size_t>(std::bit_width(value)) - sub_bucket_bits - 1;
+    const auto top   = static_cast<size_t>(value >> shift);
+
+    return 2 * sub_bucket_count + (shift - 1) * sub_bucket_count + (top - sub_bucket_count);
+}
+
+constexpr uint64_t cfdp::runtime::metrics::Histogram::bucketUpperBound(size_t index) noexcept
+{
+    if (index < 2 * sub_bucket_count)
+    {
+        return index;
+    }
+
+    const auto offset = index - 2 * sub_bucket_count;
+    const auto shift  = offset / sub_bucket_count + 1;
+    const auto top    = offset % sub_bucket_count + sub_bucket_count;
+
+    // Wraps around to the maximum value for the very last bucket.
+    return ((uint64_t{top} + 1) << shift) - 1;
+}
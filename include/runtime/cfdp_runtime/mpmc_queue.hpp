@@ -0,0 +1,379 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <thread>
+
+#include "hardware.hpp"
+
+namespace cfdp::runtime::atomic
+{
+/**
+ * Bounded lock-free multi-producer multi-consumer queue, based on the ring
+ * buffer design by Dmitry Vyukov.
+ *
+ * Every cell carries a sequence counter, which tells both producers and
+ * consumers whether the cell is ready for them in the current lap of the
+ * ring. Producers and consumers only contend on their own position counter,
+ * each kept on a separate cache line, and hand items over through the
+ * cells, which are cache line aligned as well.
+ *
+ * The single item operations are lock-free, the bulk ones are not, see
+ * `pushN` and `popN`. Blocking `push` and `pop` park on a cell, which is
+ * notified only if a thread is parked.
+ *
+ * The capacity is always rounded up to the nearest power of two.
+ */
+template <class T>
+class MpmcQueue
+{
+  public:
+    explicit MpmcQueue(size_t capacity);
+    ~MpmcQueue() = default;
+
+    MpmcQueue(const MpmcQueue&)            = delete;
+    MpmcQueue& operator=(MpmcQueue const&) = delete;
+    MpmcQueue(MpmcQueue&&)                 = delete;
+    MpmcQueue& operator=(MpmcQueue&&)      = delete;
+
+    T pop() noexcept;
+    std::optional<T> tryPop() noexcept;
+
+    void push(const T& item) noexcept;
+    void emplace(T&& item) noexcept;
+
+    [[nodiscard]] bool tryPush(const T& item) noexcept;
+    [[nodiscard]] bool tryEmplace(T&& item) noexcept;
+
+    /**
+     * Moves as many items as currently fit into the queue, claiming all the
+     * cells with a single atomic operation.
+     *
+     * Blocking: the cells are claimed before the consumers of the previous
+     * lap are done with them, so a descheduled consumer holds the call up.
+     *
+     * @param items items to be moved into the queue.
+     * @return number of items from the front of `items` which were pushed.
+     */
+    size_t pushN(std::span<T> items) noexcept;
+
+    /**
+     * Moves up to `maxItems` items out of the queue, claiming all the cells
+     * with a single atomic operation.
+     *
+     * Blocking: the cells are claimed before their producers are done with
+     * them, so a descheduled producer holds the call up.
+     *
+     * @param out output iterator receiving the popped items.
+     * @param maxItems upper bound of items to pop.
+     * @return number of popped items.
+     */
+    template <std::output_iterator<T> OutputIt>
+    size_t popN(OutputIt out, size_t maxItems) noexcept;
+
+    [[nodiscard]] inline size_t capacity() const noexcept { return mask + 1; }
+
+    [[nodiscard]] inline size_t sizeNow() const noexcept
+    {
+        const auto head = dequeuePos.load(std::memory_order_relaxed);
+        const auto tail = enqueuePos.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+  private:
+    struct alignas(hardware::cache_line_size) Cell
+    {
+        std::atomic<size_t> sequence{0};
+        std::optional<T> item{};
+    };
+
+    template <class U>
+    bool tryPushImpl(U&& item) noexcept;
+
+    void waitUntilNotFull() noexcept;
+    void waitUntilNotEmpty() noexcept;
+
+    void park(Cell& cell, size_t seq) noexcept;
+    void notifyParked(Cell& cell) noexcept;
+
+    size_t mask;
+    std::unique_ptr<Cell[]> cells;
+
+    alignas(hardware::cache_line_size) std::atomic<size_t> enqueuePos{0};
+    alignas(hardware::cache_line_size) std::atomic<size_t> dequeuePos{0};
+
+    // Threads parked in `push` or `pop`, read by every operation.
+    alignas(hardware::cache_line_size) std::atomic<size_t> parked{0};
+};
+} // namespace cfdp::runtime::atomic
+
+template <class T>
+cfdp::runtime::atomic::MpmcQueue<T>::MpmcQueue(size_t capacity)
+{
+    auto roundedCapacity = size_t{2};
+    while (roundedCapacity < capacity)
+    {
+        roundedCapacity <<= 1;
+    }
+
+    mask  = roundedCapacity - 1;
+    cells = std::make_unique<Cell[]>(roundedCapacity);
+
+    for (size_t i = 0; i < roundedCapacity; ++i)
+    {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <class T>
+template <class U>
+bool cfdp::runtime::atomic::MpmcQueue<T>::tryPushImpl(U&& item) noexcept
+{
+    auto pos = enqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        auto& cell     = cells[pos & mask];
+        const auto seq = cell.sequence.load(std::memory_order_acquire);
+        const auto lag = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (lag == 0)
+        {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.item.emplace(std::forward<U>(item));
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                notifyParked(cell);
+                return true;
+            }
+        }
+        else if (lag < 0)
+        {
+            // The cell still holds an item from the previous lap.
+            return false;
+        }
+        else
+        {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <class T>
+bool cfdp::runtime::atomic::MpmcQueue<T>::tryPush(const T& item) noexcept
+{
+    return tryPushImpl(item);
+}
+
+template <class T>
+bool cfdp::runtime::atomic::MpmcQueue<T>::tryEmplace(T&& item) noexcept
+{
+    return tryPushImpl(std::move(item));
+}
+
+template <class T>
+void cfdp::runtime::atomic::MpmcQueue<T>::push(const T& item) noexcept
+{
+    while (!tryPushImpl(item))
+    {
+        waitUntilNotFull();
+    }
+}
+
+template <class T>
+void cfdp::runtime::atomic::MpmcQueue<T>::emplace(T&& item) noexcept
+{
+    while (!tryPushImpl(std::move(item)))
+    {
+        waitUntilNotFull();
+    }
+}
+
+template <class T>
+std::optional<T> cfdp::runtime::atomic::MpmcQueue<T>::tryPop() noexcept
+{
+    auto pos = dequeuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        auto& cell     = cells[pos & mask];
+        const auto seq = cell.sequence.load(std::memory_order_acquire);
+        const auto lag = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+        if (lag == 0)
+        {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                auto item = std::move(cell.item);
+                cell.item.reset();
+                cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                notifyParked(cell);
+                return item;
+            }
+        }
+        else if (lag < 0)
+        {
+            // Nothing was published to this cell yet.
+            return std::nullopt;
+        }
+        else
+        {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <class T>
+T cfdp::runtime::atomic::MpmcQueue<T>::pop() noexcept
+{
+    while (true)
+    {
+        if (auto item = tryPop())
+        {
+            return std::move(item.value());
+        }
+
+        waitUntilNotEmpty();
+    }
+}
+
+template <class T>
+void cfdp::runtime::atomic::MpmcQueue<T>::waitUntilNotFull() noexcept
+{
+    const auto pos = enqueuePos.load(std::memory_order_relaxed);
+    auto& cell     = cells[pos & mask];
+    const auto seq = cell.sequence.load(std::memory_order_acquire);
+
+    // Parks only while the cell still holds the item of the previous lap,
+    // a consumer notifies once it is taken. Any other sequence means the
+    // position moved on meanwhile and the cell may never change again for
+    // this lap, so the caller retries instead.
+    if (seq + capacity() == pos + 1)
+    {
+        park(cell, seq);
+    }
+}
+
+template <class T>
+void cfdp::runtime::atomic::MpmcQueue<T>::waitUntilNotEmpty() noexcept
+{
+    const auto pos = dequeuePos.load(std::memory_order_relaxed);
+    auto& cell     = cells[pos & mask];
+    const auto seq = cell.sequence.load(std::memory_order_acquire);
+
+    // Parks only while the cell is empty in this lap, a producer notifies
+    // once it fills it. Other consumers could have passed through the cell
+    // since `pos` was read, then it changes only a lap later.
+    if (seq == pos)
+    {
+        park(cell, seq);
+    }
+}
+
+template <class T>
+void cfdp::runtime::atomic::MpmcQueue<T>::park(Cell& cell, size_t seq) noexcept
+{
+    parked.fetch_add(1, std::memory_order_relaxed);
+
+    // Pairs with the fence in `notifyParked`, either the notifying thread
+    // sees us counted, or we see the sequence it stored and do not sleep.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    cell.sequence.wait(seq, std::memory_order_acquire);
+    parked.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template <class T>
+void cfdp::runtime::atomic::MpmcQueue<T>::notifyParked(Cell& cell) noexcept
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (parked.load(std::memory_order_relaxed) > 0)
+    {
+        cell.sequence.notify_all();
+    }
+}
+
+template <class T>
+size_t cfdp::runtime::atomic::MpmcQueue<T>::pushN(std::span<T> items) noexcept
+{
+    auto pos     = enqueuePos.load(std::memory_order_relaxed);
+    auto claimed = size_t{0};
+
+    do
+    {
+        const auto head = dequeuePos.load(std::memory_order_acquire);
+        const auto used = static_cast<intptr_t>(pos) - static_cast<intptr_t>(head);
+        const auto free = static_cast<intptr_t>(capacity()) - used;
+
+        claimed = std::min(items.size(), static_cast<size_t>(std::max(free, intptr_t{0})));
+
+        if (claimed == 0)
+        {
+            return 0;
+        }
+    } while (!enqueuePos.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed));
+
+    for (size_t i = 0; i < claimed; ++i)
+    {
+        auto& cell = cells[(pos + i) & mask];
+
+        // Consumers which already claimed these cells may still be moving
+        // the items out, wait for them to finish.
+        while (cell.sequence.load(std::memory_order_acquire) != pos + i)
+        {
+            std::this_thread::yield();
+        }
+
+        cell.item.emplace(std::move(items[i]));
+        cell.sequence.store(pos + i + 1, std::memory_order_release);
+        notifyParked(cell);
+    }
+
+    return claimed;
+}
+
+template <class T>
+template <std::output_iterator<T> OutputIt>
+size_t cfdp::runtime::atomic::MpmcQueue<T>::popN(OutputIt out, size_t maxItems) noexcept
+{
+    auto pos     = dequeuePos.load(std::memory_order_relaxed);
+    auto claimed = size_t{0};
+
+    do
+    {
+        const auto tail      = enqueuePos.load(std::memory_order_acquire);
+        const auto available = static_cast<intptr_t>(tail) - static_cast<intptr_t>(pos);
+
+        claimed = std::min(maxItems, static_cast<size_t>(std::max(available, intptr_t{0})));
+
+        if (claimed == 0)
+        {
+            return 0;
+        }
+    } while (!dequeuePos.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed));
+
+    for (size_t i = 0; i < claimed; ++i)
+    {
+        auto& cell = cells[(pos + i) & mask];
+
+        // Producers which already claimed these cells may still be moving
+        // the items in, wait for them to finish.
+        while (cell.sequence.load(std::memory_order_acquire) != pos + i + 1)
+        {
+            std::this_thread::yield();
+        }
+
+        *out++ = std::move(cell.item.value());
+        cell.item.reset();
+        cell.sequence.store(pos + i + mask + 1, std::memory_order_release);
+        notifyParked(cell);
+    }
+
+    return claimed;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "metrics.hpp"
+
+/**
+ * Cycle accurate timers for hot paths, too short for tracing spans, like
+ * decoding a single header or handing a task over to a worker.
+ *
+ *     void decode()
+ *     {
+ *         CFDP_PROFILE_SCOPE("pdu_header.decode");
+ *         ...
+ *     }
+ *
+ * The macro expands to nothing, unless CFDP_ENABLE_PROFILING is defined,
+ * see the ENABLE_PROFILING option. Otherwise every scope reads the time
+ * stamp counter twice and records the difference in a histogram of its
+ * name, which is only a few relaxed increments on the cache line of the
+ * calling thread.
+ *
+ * The histograms are exported by the global metrics registry, in counter
+ * ticks, as `cfdp_profile_scope_cycles{scope="..."}`. The report converts
+ * them to nanoseconds and is written to the standard error at exit.
+ */
+#define CFDP_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CFDP_PROFILE_CONCAT(a, b) CFDP_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef CFDP_ENABLE_PROFILING
+#define CFDP_PROFILE_SCOPE(name)                                                                   \
+    static auto& CFDP_PROFILE_CONCAT(cfdp_profile_site_, __LINE__) =                               \
+        ::cfdp::runtime::profiling::site(name);                                                    \
+    const auto CFDP_PROFILE_CONCAT(cfdp_profile_scope_, __LINE__) =                                \
+        ::cfdp::runtime::profiling::Scope{CFDP_PROFILE_CONCAT(cfdp_profile_site_, __LINE__)}
+#else
+#define CFDP_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+
+namespace cfdp::runtime::profiling
+{
+/**
+ * Reads the time stamp counter, or the virtual counter on ARM. It ticks at
+ * a constant rate on every CPU we are targeting, but it is not ordered with
+ * the surrounding instructions.
+ */
+[[nodiscard]] inline uint64_t readCycles() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    auto ticks = uint64_t{0};
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/**
+ * Reads the counter once all preceding instructions finished, so the end
+ * of a scope is not read before its work is done.
+ */
+[[nodiscard]] inline uint64_t readCyclesOrdered() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    auto cpu = 0U;
+    return __rdtscp(&cpu);
+#elif defined(__aarch64__)
+    asm volatile("isb" ::: "memory");
+    return readCycles();
+#else
+    return readCycles();
+#endif
+}
+
+/**
+ * Returns the duration of a counter tick, measured against the steady
+ * clock on the first call, which takes about 10 ms.
+ */
+[[nodiscard]] double nanosPerCycle() noexcept;
+
+/**
+ * Returns the histogram of a scope, registering it on the first call.
+ * Sites sharing a name share the histogram.
+ */
+[[nodiscard]] metrics::Histogram& site(const char* name);
+
+/**
+ * Renders a table with the number of runs and the latency quantiles of
+ * every scope in nanoseconds.
+ */
+[[nodiscard]] std::string report();
+
+/**
+ * Records the counter ticks between its construction and destruction.
+ */
+class Scope
+{
+  public:
+    inline explicit Scope(metrics::Histogram& cycles) noexcept
+        : cycles(cycles), begin(readCycles())
+    {}
+
+    inline ~Scope() { cycles.record(readCyclesOrdered() - begin); }
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(Scope const&) = delete;
+    Scope(Scope&&)                 = delete;
+    Scope& operator=(Scope&&)      = delete;
+
+  private:
+    metrics::Histogram& cycles;
+    uint64_t begin;
+};
+} // namespace cfdp::runtime::profiling
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <sys/epoll.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "file_descriptor.hpp"
+#include "task.hpp"
+#include "thread_pool.hpp"
+
+namespace cfdp::runtime::io
+{
+// Readiness flags, any combination of the epoll event flags is accepted.
+constexpr uint32_t readable = EPOLLIN;
+constexpr uint32_t writable = EPOLLOUT;
+
+/**
+ * Where readiness handlers are run.
+ *
+ * Inline handlers run on the reactor thread, so they must never block.
+ * Pool handlers run on the thread pool. The descriptor is rearmed once
+ * the handler returns, so a handler never runs concurrently with itself.
+ */
+enum class Dispatch : uint8_t
+{
+    Inline = 0,
+    Pool,
+};
+
+/**
+ * Edge-triggered epoll reactor.
+ *
+ * A single thread waits for readiness of every registered descriptor and
+ * dispatches the handlers either inline or onto the thread pool. Handlers
+ * are edge-triggered: they are called once per readiness change and are
+ * expected to read or write until the descriptor returns EAGAIN. The
+ * reactor drains timerfds and eventfds it created itself.
+ *
+ * The reactor is also an executor, tasks posted to it run on the reactor
+ * thread, which is woken up through an eventfd.
+ *
+ * Descriptors are identified by their numbers. A handler can still be
+ * called once after its descriptor is removed, if the event was already
+ * picked up by the reactor thread.
+ */
+class Reactor
+{
+  public:
+    using Handler = std::move_only_function<void(uint32_t events)>;
+
+    explicit Reactor(thread_pool::ThreadPool& pool);
+    ~Reactor();
+
+    Reactor(const Reactor&)            = delete;
+    Reactor& operator=(Reactor const&) = delete;
+    Reactor(Reactor&&)                 = delete;
+    Reactor& operator=(Reactor&&)      = delete;
+
+    /**
+     * Takes over the descriptor and watches it for readiness.
+     *
+     * @param fd descriptor, it is closed once removed or with the reactor.
+     * @param events readiness flags the handler is interested in.
+     * @param handler functor called with the epoll events which occurred.
+     * @param dispatch where the handler runs.
+     * @return number of the descriptor, used to modify or remove it.
+     */
+    int watch(FileDescriptor&& fd, uint32_t events, Handler&& handler,
+              Dispatch dispatch = Dispatch::Inline);
+
+    /**
+     * Waits for a single readiness event of a descriptor owned elsewhere.
+     * The descriptor is removed from the reactor before the handler runs.
+     */
+    void watchOnce(int fd, uint32_t events, Handler&& handler,
+                   Dispatch dispatch = Dispatch::Inline);
+
+    /**
+     * Creates a timerfd firing first after `initial` and then every
+     * `interval`, unless the interval is zero.
+     *
+     * @return number of the timerfd.
+     */
+    int addTimer(std::chrono::nanoseconds initial, std::chrono::nanoseconds interval,
+                 Handler&& handler, Dispatch dispatch = Dispatch::Inline);
+
+    /**
+     * Creates an eventfd, its handler runs after every `signal`, with the
+     * signals sent in the meantime coalesced into one call.
+     *
+     * @return number of the eventfd.
+     */
+    int addEvent(Handler&& handler, Dispatch dispatch = Dispatch::Inline);
+
+    /**
+     * Signals an eventfd created by `addEvent`. Safe to call from any thread.
+     */
+    void signal(int eventFd) noexcept;
+
+    /**
+     * Replaces the readiness flags of a descriptor. While its pool handler
+     * runs, the new flags are applied when the handler returns.
+     *
+     * @return false if the descriptor is not watched.
+     */
+    bool modify(int fd, uint32_t events) noexcept;
+
+    bool remove(int fd) noexcept;
+
+    /**
+     * Runs the task on the reactor thread.
+     */
+    void post(thread_pool::Task&& task) noexcept;
+
+    /**
+     * Stops the reactor thread and closes every owned descriptor. Called
+     * from the reactor thread itself, it only asks the thread to exit, the
+     * next call from another thread or the destructor joins it.
+     */
+    void stop() noexcept;
+
+    [[nodiscard]] size_t sizeNow() const noexcept;
+
+  private:
+    static constexpr auto log_module = logging::LogModule::Reactor;
+
+    enum class Kind : uint8_t
+    {
+        Descriptor = 0,
+        Timer,
+        Event,
+    };
+
+    struct Registration
+    {
+        FileDescriptor owned;
+        int fd;
+        uint32_t generation;
+        uint32_t events;
+        Kind kind;
+        Dispatch dispatch;
+        bool once;
+        // Set while a pool handler runs, guarded by the poller mutex.
+        bool inFlight;
+        Handler handler;
+    };
+
+    // Everything the handlers dispatched onto the pool need to rearm their
+    // descriptors, it stays alive until the last of them is done.
+    struct Poller
+    {
+        FileDescriptor epoll{};
+        std::mutex mutex{};
+        std::unordered_map<int, std::shared_ptr<Registration>> registrations{};
+        uint32_t nextGeneration{0};
+
+        void rearm(const Registration& registration) noexcept;
+    };
+
+    static constexpr size_t max_events = 256;
+
+    int add(Registration&& registration);
+    void dispatch(std::shared_ptr<Registration>&& registration, uint32_t events) noexcept;
+    void runPosted() noexcept;
+    void run() noexcept;
+
+    thread_pool::ThreadPool& pool;
+    std::shared_ptr<Poller> poller;
+    FileDescriptor wakeup;
+
+    std::mutex postedMutex{};
+    std::vector<thread_pool::Task> posted{};
+
+    std::atomic_bool stopped{false};
+    std::mutex stopMutex{};
+    std::thread thread{};
+};
+} // namespace cfdp::runtime::io
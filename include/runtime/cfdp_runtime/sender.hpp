@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "future.hpp"
+#include "logger.hpp"
+#include "thread_pool.hpp"
+#include "transport.hpp"
+
+namespace cfdp::runtime::sender
+{
+struct SenderOptions
+{
+    uint64_t sourceEntity{1};
+
+    // File data carried by a single File Data PDU, at most 65527 bytes,
+    // and less if the whole PDU would not fit the transport, like UDP.
+    size_t segmentSize{1024};
+
+    // Size of each of the two read buffers of a transaction, rounded down
+    // to a multiple of `segmentSize`. It bounds the memory of a transaction
+    // regardless of the size of the file.
+    size_t readSize{size_t{1} << 20};
+};
+
+struct TransferSummary
+{
+    uint64_t transaction{0};
+    uint64_t fileSize{0};
+
+    // Modular checksum sent in the EOF PDU.
+    uint32_t checksum{0};
+    uint64_t fileDataPdus{0};
+};
+
+/**
+ * Sends files in unacknowledged mode (Class 1): a Metadata PDU, the file
+ * data split into File Data PDUs, and an EOF PDU with the checksum of the
+ * file. Nothing is retransmitted, the transaction ends once the EOF PDU is
+ * handed over to the transport.
+ *
+ * Every transaction is a pipeline on the thread pool. While one buffer is
+ * segmented, encoded and transmitted, the next part of the file is read
+ * into the other one, so the disk and the transport are busy at the same
+ * time. The stages hand over to each other by posting tasks, no worker
+ * ever waits for another one, so any number of transactions can share a
+ * small pool.
+ */
+class Sender
+{
+  public:
+    /**
+     * @param pool pool running the transactions, it has to outlive them.
+     * @param transport where the PDUs go, it has to outlive the transactions.
+     * @throw std::invalid_argument if the segment or read size is invalid,
+     * or a File Data PDU with a full segment exceeds `maxPduSize` of the
+     * transport.
+     */
+    Sender(thread_pool::ThreadPool& pool, io::Transport& transport, SenderOptions options = {});
+
+    Sender(const Sender&)            = delete;
+    Sender& operator=(Sender const&) = delete;
+    Sender(Sender&&)                 = delete;
+    Sender& operator=(Sender&&)      = delete;
+
+    /**
+     * Starts sending a file. The source file name is the given path, the
+     * destination file name its last component.
+     *
+     * @param file regular file to be sent.
+     * @param destinationEntity entity receiving the file.
+     * @return future of the summary, holding std::system_error if reading
+     *         or transmitting failed.
+     * @throw std::system_error if the file could not be opened.
+     * @throw std::invalid_argument if the destination is the sender itself,
+     *        or a file name is longer than 255 bytes.
+     */
+    [[nodiscard]] future::Future<TransferSummary> send(const std::filesystem::path& file,
+                                                       uint64_t destinationEntity);
+
+  private:
+    static constexpr auto log_module = logging::LogModule::Sender;
+
+    thread_pool::ThreadPool& pool;
+    io::Transport& transport;
+    SenderOptions options;
+
+    std::atomic<uint64_t> nextTransaction{1};
+};
+} // namespace cfdp::runtime::sender
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <ratio>
+#include <type_traits>
+#include <vector>
+
+#include "future.hpp"
+#include "logger.hpp"
+#include "task.hpp"
+#include "timing_wheel.hpp"
+
+namespace cfdp::runtime::simulation
+{
+/**
+ * Clock of a simulation. It has the types of a std::chrono clock, but
+ * there is no global `now`, every Scheduler keeps its own time, which only
+ * moves when the scheduler runs.
+ */
+struct VirtualClock
+{
+    using rep        = int64_t;
+    using period     = std::nano;
+    using duration   = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<VirtualClock>;
+
+    static constexpr bool is_steady = true;
+};
+
+/**
+ * Deterministic, single threaded stand-in for the ThreadPool and the
+ * TimerService, used to run the runtime in virtual time.
+ *
+ * Posted tasks run one by one, in the order they were posted, on the thread
+ * calling one of the `run` methods. Once no task is ready, the clock jumps
+ * straight to the next timer, so waiting costs nothing and a simulation is
+ * bound only by the CPU. Timers are kept in a TimingWheel with a tick of
+ * `tickDuration`, like in the TimerService they never fire early, but can
+ * fire up to one tick late. Given the same sequence of calls, every run
+ * executes the tasks in exactly the same order at exactly the same time.
+ *
+ * Exceptions thrown by posted tasks are propagated to the caller of `run`,
+ * which stops the run, the other tasks stay queued.
+ */
+class Scheduler
+{
+  public:
+    using Clock = VirtualClock;
+
+    explicit Scheduler(Clock::duration tickDuration = std::chrono::microseconds(1));
+
+    Scheduler(const Scheduler&)            = delete;
+    Scheduler& operator=(Scheduler const&) = delete;
+    Scheduler(Scheduler&&)                 = delete;
+    Scheduler& operator=(Scheduler&&)      = delete;
+
+    inline void post(thread_pool::Task&& task) { ready.push_back(std::move(task)); }
+
+    /**
+     * Queues a functor, like `ThreadPool::dispatchTask`.
+     *
+     * @return future of the functor result, ready once the functor ran.
+     */
+    template <class Functor>
+        requires std::invocable<Functor>
+    auto dispatchTask(Functor&& func) -> future::Future<decltype(func())>;
+
+    timer::TimerId scheduleAfter(Clock::duration delay, thread_pool::Task&& callback);
+    timer::TimerId scheduleAt(Clock::time_point deadline, thread_pool::Task&& callback);
+
+    bool cancel(timer::TimerId id) noexcept;
+    bool rearm(timer::TimerId id, Clock::duration delay) noexcept;
+
+    /**
+     * Runs a single task, moving the clock to the next timer first if no
+     * task is ready.
+     *
+     * @return false if there was nothing left to run.
+     */
+    bool step();
+
+    /**
+     * Runs tasks and fires timers until there is nothing left to do.
+     *
+     * @return number of tasks run.
+     */
+    size_t runUntilIdle();
+
+    /**
+     * Runs everything due up to the deadline and leaves the clock there.
+     *
+     * @return number of tasks run.
+     */
+    size_t runUntil(Clock::time_point deadline);
+
+    inline size_t runFor(Clock::duration duration) { return runUntil(time + duration); }
+
+    [[nodiscard]] inline Clock::time_point now() const noexcept { return time; }
+    [[nodiscard]] inline size_t sizeNow() const noexcept { return ready.size() + wheel.sizeNow(); }
+    [[nodiscard]] inline Clock::duration tickDuration() const noexcept { return tick; }
+
+  private:
+    static constexpr auto log_module = logging::LogModule::Simulation;
+
+    // First tick at which `deadline` is already in the past.
+    [[nodiscard]] uint64_t expiryTick(Clock::time_point deadline) const noexcept;
+
+    // Moves the wheel to its next event not later than `limitTick`, queueing
+    // the expired timers.
+    bool advanceTimers(uint64_t limitTick);
+
+    bool runReady();
+
+    const Clock::duration tick;
+    Clock::time_point time{};
+
+    timer::TimingWheel wheel{};
+    std::deque<thread_pool::Task> ready{};
+    std::vector<thread_pool::Task> expired{};
+};
+} // namespace cfdp::runtime::simulation
+
+template <class Functor>
+    requires std::invocable<Functor>
+auto cfdp::runtime::simulation::Scheduler::dispatchTask(Functor&& func)
+    -> future::Future<decltype(func())>
+{
+    using Result = decltype(func());
+
+    auto promise = future::Promise<Result>{};
+    auto future  = promise.getFuture();
+
+    post([promise = std::move(promise), func = std::forward<Functor>(func)]() mutable {
+        try
+        {
+            if constexpr (std::is_void_v<Result>)
+            {
+                std::invoke(func);
+                promise.setValue();
+            }
+            else
+            {
+                promise.setValue(std::invoke(func));
+            }
+        }
+        catch (...)
+        {
+            promise.setException(std::current_exception());
+        }
+    });
+
+    return future;
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <thread>
+
+#include "hardware.hpp"
+
+namespace cfdp::runtime::atomic
+{
+enum class WaitStrategy : uint8_t
+{
+    // Blocking operations spin and yield, the other side never has to
+    // notify, so `tryPush` and `tryPop` stay fence free.
+    Spin = 0,
+    // Blocking operations park the thread with atomic wait. Publishing
+    // an item costs an extra fence, to check whether the peer is parked.
+    Park,
+};
+
+/**
+ * Wait-free bounded single-producer single-consumer queue.
+ *
+ * Meant for fixed pipeline stages, where exactly one thread pushes and
+ * exactly one thread pops. Each side keeps a private copy of the other
+ * side's index and only reloads the shared one when the copy says the
+ * queue is full (or empty), so in the steady state the two threads touch
+ * each other's cache lines once per lap, not once per item.
+ */
+template <class T, size_t Capacity, WaitStrategy Wait = WaitStrategy::Park>
+    requires(Capacity >= 2 && std::has_single_bit(Capacity))
+class SpscQueue
+{
+  public:
+    SpscQueue()  = default;
+    ~SpscQueue() = default;
+
+    SpscQueue(const SpscQueue&)            = delete;
+    SpscQueue& operator=(SpscQueue const&) = delete;
+    SpscQueue(SpscQueue&&)                 = delete;
+    SpscQueue& operator=(SpscQueue&&)      = delete;
+
+    // Consumer side.
+    T pop() noexcept;
+    std::optional<T> tryPop() noexcept;
+
+    // Producer side.
+    void push(const T& item) noexcept;
+    void emplace(T&& item) noexcept;
+    [[nodiscard]] bool tryPush(const T& item) noexcept;
+    [[nodiscard]] bool tryEmplace(T&& item) noexcept;
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+    [[nodiscard]] inline size_t sizeNow() const noexcept
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    // Items pushed and popped since construction, a consumer waiting for
+    // everything pushed up to some point compares the two.
+    [[nodiscard]] inline size_t pushedNow() const noexcept
+    {
+        return tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] inline size_t poppedNow() const noexcept
+    {
+        return head.load(std::memory_order_acquire);
+    }
+
+  private:
+    static constexpr size_t mask = Capacity - 1;
+
+    template <class U>
+    bool tryPushImpl(U&& item) noexcept;
+
+    template <class U>
+    void pushImpl(U&& item) noexcept;
+
+    // Producer side. The parking flag of the consumer lives here, since
+    // it is rarely written, but checked by the producer on every push.
+    alignas(hardware::cache_line_size) std::atomic<size_t> tail{0};
+    size_t cachedHead{0};
+    std::atomic_bool consumerParked{false};
+
+    // Consumer side, mirroring the producer one.
+    alignas(hardware::cache_line_size) std::atomic<size_t> head{0};
+    size_t cachedTail{0};
+    std::atomic_bool producerParked{false};
+
+    alignas(hardware::cache_line_size) std::array<std::optional<T>, Capacity> slots{};
+};
+} // namespace cfdp::runtime::atomic
+
+template <class T, size_t Capacity, cfdp::runtime::atomic::WaitStrategy Wait>
+    requires(Capacity >= 2 && std::has_single_bit(Capacity))
+template <class U>
+bool cfdp::runtime::atomic::SpscQueue<T, Capacity, Wait>::tryPushImpl(U&& item) noexcept
+{
+    const auto current = tail.load(std::memory_order_relaxed);
+
+    if (current - cachedHead == Capacity)
+    {
+        cachedHead = head.load(std::memory_order_acquire);
+
+        if (current - cachedHead == Capacity)
+        {
+            return false;
+        }
+    }
+
+    slots[current & mask].emplace(std::forward<U>(item));
+    tail.store(current + 1, std::memory_order_release);
+
+    if constexpr (Wait == WaitStrategy::Park)
+    {
+        // Pairs with the fence in `pop`.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (consumerParked.load(std::memory_order_relaxed))
+        {
+            tail.notify_one();
+        }
+    }
+
+    return true;
+}
+
+template <class T, size_t Capacity, cfdp::runtime::atomic::WaitStrategy Wait>
+    requires(Capacity >= 2 && std::has_single_bit(Capacity))
+template <class U>
+void cfdp::runtime::atomic::SpscQueue<T, Capacity, Wait>::pushImpl(U&& item) noexcept
+{
+    while (!tryPushImpl(std::forward<U>(item)))
+    {
+        if constexpr (Wait == WaitStrategy::Park)
+        {
+            const auto observed = head.load(std::memory_order_relaxed);
+
+            producerParked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed) ==
+                Capacity)
+            {
+                head.wait(observed, std::memory_order_acquire);
+            }
+
+            producerParked.store(false, std::memory_order_relaxed);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template <class T, size_t Capacity, cfdp::runtime::atomic::WaitStrategy Wait>
+    requires(Capacity >= 2 && std::has_single_bit(Capacity))
+bool cfdp::runtime::atomic::SpscQueue<T, Capacity, Wait>::tryPush(const T& item) noexcept
+{
+    return tryPushImpl(item);
+}
+
+template <class T, size_t Capacity, cfdp::runtime::atomic::WaitStrategy Wait>
+    requires(Capacity >= 2 && std::has_single_bit(Capacity))
+bool cfdp::runtime::atomic::SpscQueue<T, Capacity, Wait>::tryEmplace(T&& item) noexcept
+{
+    return tryPushImpl(std::move(item));
+}
+
+template <class T, size_t Capacity, cfdp::runtime::atomic::WaitStrategy Wait>
+    requires(Capacity >= 2 && std::has_single_bit(Capacity))
+void cfdp::runtime::atomic::SpscQueue<T, Capacity, Wait>::push(const T& item) noexcept
+{
+    pushImpl(item);
+}
+
+template <class T, size_t Capacity, cfdp::runtime::atomic::WaitStrategy Wait>
+    requires(Capacity >= 2 && std::has_single_bit(Capacity))
+void cfdp::runtime::atomic::SpscQueue<T, Capacity, Wait>::emplace(T&& item) noexcept
+{
+    pushImpl(std::move(item));
+}
+
+template <class T, size_t Capacity, cfdp::runtime::atomic::WaitStrategy Wait>
+    requires(Capacity >= 2 && std::has_single_bit(Capacity))
+std::optional<T> cfdp::runtime::atomic::SpscQueue<T, Capacity, Wait>::tryPop() noexcept
+{
+    const auto current = head.load(std::memory_order_relaxed);
+
+    if (current == cachedTail)
+    {
+        cachedTail = tail.load(std::memory_order_acquire);
+
+        if (current == cachedTail)
+        {
+            return std::nullopt;
+        }
+    }
+
+    auto& slot = slots[current & mask];
+    auto item  = std::move(slot);
+    slot.reset();
+
+    head.store(current + 1, std::memory_order_release);
+
+    if constexpr (Wait == WaitStrategy::Park)
+    {
+        // Pairs with the fence in `push`.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (producerParked.load(std::memory_order_relaxed))
+        {
+            head.notify_one();
+        }
+    }
+
+    return item;
+}
+
+template <class T, size_t Capacity, cfdp::runtime::atomic::WaitStrategy Wait>
+    requires(Capacity >= 2 && std::has_single_bit(Capacity))
+T cfdp::runtime::atomic::SpscQueue<T, Capacity, Wait>::pop() noexcept
+{
+    while (true)
+    {
+        if (auto item = tryPop())
+        {
+            return std::move(item.value());
+        }
+
+        if constexpr (Wait == WaitStrategy::Park)
+        {
+            const auto observed = tail.load(std::memory_order_relaxed);
+
+            consumerParked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (tail.load(std::memory_order_relaxed) == head.load(std::memory_order_relaxed))
+            {
+                tail.wait(observed, std::memory_order_acquire);
+            }
+
+            consumerParked.store(false, std::memory_order_relaxed);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
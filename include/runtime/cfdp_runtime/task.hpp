@@ -0,0 +1,200 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cfdp::runtime::thread_pool
+{
+/**
+ * Move-only, type erased `void()` callable.
+ *
+ * Unlike std::function, it accepts move-only functors (like lambdas owning
+ * a std::promise) and stores small ones inline, without touching the heap.
+ * Functors which do not fit the inline buffer, or which could throw while
+ * being moved, are allocated on the heap instead.
+ *
+ * A task can also be cancelled instead of being run. Functors with a
+ * `cancel()` member get a chance to report it, others are just dropped.
+ */
+class Task
+{
+  public:
+    // Together with the operations pointer, the whole task fits a single
+    // cache line. That is enough for a promise plus a few captures.
+    static constexpr size_t inline_storage_size = 7 * sizeof(void*);
+
+    Task() noexcept = default;
+
+    template <class Functor>
+        requires(!std::same_as<std::remove_cvref_t<Functor>, Task> &&
+                 std::invocable<std::remove_cvref_t<Functor>&>)
+    Task(Functor&& func); // NOLINT(google-explicit-constructor)
+
+    ~Task() { reset(); }
+
+    Task(Task&& other) noexcept;
+    Task& operator=(Task&& other) noexcept;
+
+    Task(const Task&)            = delete;
+    Task& operator=(Task const&) = delete;
+
+    inline void operator()() { operations->invoke(storage.data()); }
+
+    /**
+     * Drops the task without running it, calling `cancel()` of the functor
+     * first, if it has one.
+     */
+    inline void cancel() noexcept
+    {
+        if (operations != nullptr && operations->cancel != nullptr)
+        {
+            operations->cancel(storage.data());
+        }
+        reset();
+    }
+
+    [[nodiscard]] inline explicit operator bool() const noexcept { return operations != nullptr; }
+
+    template <class Functor>
+    [[nodiscard]] static constexpr bool isStoredInline() noexcept
+    {
+        return fitsInline<std::remove_cvref_t<Functor>>;
+    }
+
+  private:
+    struct Operations
+    {
+        void (*invoke)(std::byte* storage);
+        void (*relocate)(std::byte* from, std::byte* to) noexcept;
+        void (*destroy)(std::byte* storage) noexcept;
+        void (*cancel)(std::byte* storage) noexcept;
+    };
+
+    template <class Functor>
+    static constexpr bool fitsInline = sizeof(Functor) <= inline_storage_size &&
+                                       alignof(Functor) <= alignof(std::max_align_t) &&
+                                       std::is_nothrow_move_constructible_v<Functor>;
+
+    template <class Functor>
+    static constexpr bool isCancellable = requires(Functor& func) {
+        { func.cancel() } noexcept;
+    };
+
+    template <class Pointee>
+    [[nodiscard]] static inline Pointee* as(std::byte* storage) noexcept
+    {
+        return std::launder(static_cast<Pointee*>(static_cast<void*>(storage)));
+    }
+
+    template <class Functor, bool onHeap>
+    [[nodiscard]] static constexpr auto cancelOperation() noexcept -> decltype(Operations::cancel)
+    {
+        if constexpr (!isCancellable<Functor>)
+        {
+            return nullptr;
+        }
+        else if constexpr (onHeap)
+        {
+            return [](std::byte* storage) noexcept { (*as<Functor*>(storage))->cancel(); };
+        }
+        else
+        {
+            return [](std::byte* storage) noexcept { as<Functor>(storage)->cancel(); };
+        }
+    }
+
+    template <class Functor>
+    static constexpr Operations inline_operations{
+        .invoke   = [](std::byte* storage) { std::invoke(*as<Functor>(storage)); },
+        .relocate = [](std::byte* from, std::byte* to) noexcept {
+            std::construct_at(as<Functor>(to), std::move(*as<Functor>(from)));
+            std::destroy_at(as<Functor>(from));
+        },
+        .destroy = [](std::byte* storage) noexcept { std::destroy_at(as<Functor>(storage)); },
+        .cancel  = cancelOperation<Functor, false>(),
+    };
+
+    template <class Functor>
+    static constexpr Operations heap_operations{
+        .invoke   = [](std::byte* storage) { std::invoke(**as<Functor*>(storage)); },
+        .relocate = [](std::byte* from, std::byte* to) noexcept {
+            std::construct_at(as<Functor*>(to), *as<Functor*>(from));
+        },
+        .destroy = [](std::byte* storage) noexcept {
+            auto owner = std::unique_ptr<Functor>{*as<Functor*>(storage)};
+        },
+        .cancel = cancelOperation<Functor, true>(),
+    };
+
+    inline void reset() noexcept
+    {
+        if (operations != nullptr)
+        {
+            operations->destroy(storage.data());
+            operations = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) std::array<std::byte, inline_storage_size> storage{};
+    const Operations* operations{nullptr};
+};
+
+/**
+ * Anything which can schedule a task for asynchronous execution, like the
+ * ThreadPool. Continuations and other callbacks are posted to executors.
+ */
+template <class E>
+concept Executor = requires(E& executor, Task task) { executor.post(std::move(task)); };
+} // namespace cfdp::runtime::thread_pool
+
+template <class Functor>
+    requires(!std::same_as<std::remove_cvref_t<Functor>, cfdp::runtime::thread_pool::Task> &&
+             std::invocable<std::remove_cvref_t<Functor>&>)
+cfdp::runtime::thread_pool::Task::Task(Functor&& func)
+{
+    using Stored = std::remove_cvref_t<Functor>;
+
+    if constexpr (fitsInline<Stored>)
+    {
+        std::construct_at(as<Stored>(storage.data()), std::forward<Functor>(func));
+        operations = &inline_operations<Stored>;
+    }
+    else
+    {
+        auto owner = std::make_unique<Stored>(std::forward<Functor>(func));
+        std::construct_at(as<Stored*>(storage.data()), owner.release());
+        operations = &heap_operations<Stored>;
+    }
+}
+
+inline cfdp::runtime::thread_pool::Task::Task(Task&& other) noexcept : operations(other.operations)
+{
+    if (operations != nullptr)
+    {
+        operations->relocate(other.storage.data(), storage.data());
+        other.operations = nullptr;
+    }
+}
+
+inline auto cfdp::runtime::thread_pool::Task::operator=(Task&& other) noexcept -> Task&
+{
+    if (this != &other)
+    {
+        reset();
+
+        if (other.operations != nullptr)
+        {
+            other.operations->relocate(other.storage.data(), storage.data());
+            operations       = other.operations;
+            other.operations = nullptr;
+        }
+    }
+
+    return *this;
+}
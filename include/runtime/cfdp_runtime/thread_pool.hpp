@@ -1,24 +1,198 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <future>
+#include <latch>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <semaphore>
+#include <stop_token>
+#include <string>
+#include <system_error>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 #include "atomic_queue.hpp"
 #include "future.hpp"
+#include "hardware.hpp"
 #include "logger.hpp"
+#include "metrics.hpp"
+#include "mpmc_queue.hpp"
+#include "task.hpp"
+#include "work_stealing_deque.hpp"
 
 namespace cfdp::runtime::thread_pool
 {
+/**
+ * Placement of the thread pool workers on the machine.
+ */
+struct WorkerPlacement
+{
+    // CPUs of every worker, worker `i` is pinned to `cpuSets[i % cpuSets.size()]`.
+    // Empty means no pinning, unless a NUMA node is given.
+    std::vector<hardware::CpuSet> cpuSets{};
+
+    // NUMA node whose memory the workers allocate from. Unless `cpuSets`
+    // are given, the workers are also pinned to the CPUs of that node.
+    std::optional<size_t> numaNode{};
+};
+
+/**
+ * Priority classes of the tasks, each one has its own lane in the pool.
+ * Protocol control work (ACK, NAK, EOF, keep alive) should go to the High
+ * lane, so it never waits behind a burst of bulk FileData work.
+ */
+enum class Priority : uint8_t
+{
+    High = 0,
+    Normal,
+    Low,
+};
+
+constexpr size_t num_priorities = 3;
+
+/**
+ * How the workers choose between the lanes.
+ *
+ * Strict always takes a task from the highest non-empty lane, which can
+ * starve the lower ones. Weighted takes up to `weight` tasks from every
+ * lane in turn, so the lower lanes keep making progress under load.
+ */
+enum class LaneScheduling : uint8_t
+{
+    Strict = 0,
+    Weighted,
+};
+
+struct LaneOptions
+{
+    // Tasks dispatched with an explicit priority are rejected once that
+    // many of them wait in the lane.
+    size_t maxDepth{std::numeric_limits<size_t>::max()};
+    uint32_t weight{1};
+};
+
+struct LanePolicy
+{
+    LaneScheduling scheduling{LaneScheduling::Strict};
+    std::array<LaneOptions, num_priorities> lanes{{{.weight = 8}, {.weight = 4}, {.weight = 1}}};
+};
+
+/**
+ * What happens to the queued tasks when the pool is shut down.
+ *
+ * Cancel lets the running tasks finish and cancels the queued ones, the
+ * futures of those fail with std::errc::operation_canceled. Drain waits
+ * until every queued task, including the ones spawned by other tasks, ran.
+ */
+enum class ShutdownMode : uint8_t
+{
+    Cancel = 0,
+    Drain,
+};
+
+/**
+ * Sizing of an elastic pool, which starts workers only when the load asks
+ * for them and retires them once they sit idle for too long.
+ */
+struct ElasticPolicy
+{
+    // Workers started with the pool, the pool never shrinks below that.
+    size_t minWorkers{0};
+
+    // A new worker is started once tasks have been waiting in the queues
+    // for that long, with every worker busy.
+    std::chrono::microseconds spawnLatency{std::chrono::milliseconds{1}};
+
+    // Workers above the minimum exit after being idle for that long.
+    std::chrono::milliseconds idleTimeout{std::chrono::seconds{10}};
+};
+
+struct ThreadPoolOptions
+{
+    // Number of workers, or their maximum number in an elastic pool.
+    size_t numWorkers{std::thread::hardware_concurrency() * 2 + 1};
+    WorkerPlacement placement{};
+    LanePolicy lanes{};
+    std::optional<ElasticPolicy> elastic{};
+
+    // Records the latencies and the load of the workers, see `stats`. It
+    // costs two clock reads per task, disabled it is a single branch.
+    bool collectStats{false};
+};
+
+struct WorkerStats
+{
+    size_t index{0};
+    uint64_t tasksRun{0};
+
+    // Tasks the worker took from the deques of other workers.
+    uint64_t steals{0};
+
+    // Time spent running tasks, out of the time since the worker was
+    // first started.
+    std::chrono::nanoseconds busy{0};
+    std::chrono::nanoseconds lifetime{0};
+
+    [[nodiscard]] double utilisation() const noexcept;
+};
+
+struct ThreadPoolStats
+{
+    // Nanoseconds from dispatching a task until a worker starts it.
+    metrics::HistogramSnapshot waitTime{};
+
+    // Nanoseconds a task was running.
+    metrics::HistogramSnapshot runTime{};
+
+    std::vector<WorkerStats> workers{};
+
+    // Most tasks ever waiting in each lane at once.
+    std::array<size_t, num_priorities> laneHighWater{};
+};
+
+/**
+ * Work stealing thread pool.
+ *
+ * Every worker owns a Chase-Lev deque. Tasks dispatched from a worker land
+ * in its own deque, tasks dispatched from the outside go through shared
+ * injection queues, one lane per priority. Workers pick the lanes as the
+ * LanePolicy says, treating their own deque as a part of the Normal lane,
+ * and when all of them are empty, steal from randomly chosen victims.
+ * When there is nothing to do, a worker spins for a short while and then
+ * parks on a semaphore until a new task arrives, so an idle pool does not
+ * consume any CPU.
+ *
+ * Every worker allocates its own structures (deque, semaphore, memory
+ * resource) on its own thread, after the placement is applied, so they
+ * end up on the NUMA node the worker runs on.
+ *
+ * An elastic pool starts with `minWorkers` and grows up to `numWorkers`
+ * whenever all the workers are busy and the queues are backlogged for
+ * longer than `spawnLatency`. The first task of a pool with no workers
+ * starts one right away. The backlog is noticed by the producers and the
+ * workers, a monitor thread sleeping until then measures how long it
+ * lasts. A retired worker keeps its structures, they are reused by the
+ * next worker started in its place.
+ */
 class ThreadPool
 {
   public:
     explicit ThreadPool(size_t numWorkers = std::thread::hardware_concurrency() * 2 + 1);
-    ~ThreadPool() { shutdown(); };
+    ThreadPool(size_t numWorkers, WorkerPlacement workerPlacement);
+    explicit ThreadPool(ThreadPoolOptions options);
+    ~ThreadPool();
 
     ThreadPool(const ThreadPool&)            = delete;
     ThreadPool& operator=(ThreadPool const&) = delete;
@@ -29,15 +203,370 @@ class ThreadPool
         requires std::invocable<Functor>
     auto dispatchTask(Functor&& func) noexcept -> future::Future<decltype(func())>;
 
-    void shutdown() noexcept;
+    /**
+     * Dispatches a task into the lane of the given priority.
+     *
+     * @return future of the task, holding std::system_error with
+     *         std::errc::resource_unavailable_try_again if the lane is full.
+     */
+    template <class Functor>
+        requires std::invocable<Functor>
+    auto dispatchTask(Priority priority, Functor&& func) noexcept
+        -> future::Future<decltype(func())>;
+
+    /**
+     * Dispatches a task which is skipped once a stop is requested through
+     * the token, its future fails with std::errc::operation_canceled then.
+     * The token is checked right before the task would run, a running task
+     * has to check it on its own.
+     */
+    template <class Functor>
+        requires std::invocable<Functor>
+    auto dispatchTask(std::stop_token token, Functor&& func) noexcept
+        -> future::Future<decltype(func())>;
+
+    template <class Functor>
+        requires std::invocable<Functor>
+    auto dispatchTask(Priority priority, std::stop_token token, Functor&& func) noexcept
+        -> future::Future<decltype(func())>;
+
+    /**
+     * Dispatches every functor from the range, synchronizing with the
+     * workers only once for the whole batch.
+     *
+     * @param functors range of functors, each one is copied into its task, or moved when the
+     *                 range is passed as an rvalue.
+     * @return futures of the dispatched tasks, in the order of the range.
+     */
+    template <std::ranges::input_range Range>
+        requires std::invocable<std::ranges::range_value_t<Range>&>
+    auto dispatchBulk(Range&& functors) noexcept
+        -> std::vector<future::Future<std::invoke_result_t<std::ranges::range_value_t<Range>&>>>;
+
+    /**
+     * Schedules a task without creating a future for it, which makes the
+     * pool an executor for future continuations.
+     *
+     * @param task task to be run on one of the workers.
+     */
+    inline void post(Task&& task) noexcept { enqueue(std::move(task)); }
+
+    /**
+     * Schedules a task into the lane of the given priority without a future.
+     * Like the tasks posted without a priority, it is never rejected, even
+     * when the lane is already deeper than its limit.
+     *
+     * @param priority lane to schedule the task into.
+     * @param task task to be run on one of the workers.
+     */
+    void post(Priority priority, Task&& task) noexcept;
+
+    /**
+     * Schedules a batch of tasks, synchronizing with the workers only once.
+     *
+     * @param tasks tasks to be run on the workers.
+     */
+    inline void postBulk(std::vector<Task>&& tasks) noexcept { enqueueBulk(std::move(tasks)); }
+
+    /**
+     * Schedules a task into the lane of the given priority, respecting the
+     * depth limit of the lane. Unlike the prioritized tasks, the ones
+     * scheduled without a priority are never rejected.
+     *
+     * @return false if the lane is full, the task is dropped then.
+     */
+    [[nodiscard]] bool tryPost(Priority priority, Task&& task) noexcept;
+
+    [[nodiscard]] size_t laneSize(Priority priority) const noexcept;
+
+    [[nodiscard]] inline size_t numWorkersNow() const noexcept
+    {
+        return numRunning.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Reads the statistics of the pool. Every counter is read separately
+     * while the workers keep running, so the values are not consistent
+     * with each other to the last task.
+     *
+     * @return std::nullopt unless the pool collects them.
+     */
+    [[nodiscard]] std::optional<ThreadPoolStats> stats() const;
+
+    /**
+     * Stops the workers, either cancelling or running the queued tasks
+     * first. Tasks dispatched after the shutdown are never run. With the
+     * Drain mode it must not be called from a task, and it does not return
+     * while other threads keep dispatching new tasks.
+     */
+    void shutdown(ShutdownMode mode = ShutdownMode::Cancel) noexcept;
+
+    /**
+     * Returns the memory resource of the worker running the calling thread,
+     * allocating from it keeps the memory local to that worker. It is not
+     * synchronized, memory taken from it has to be released on the same
+     * worker, like the scratch buffers of a single task.
+     *
+     * @return resource of the worker, or the default resource if the
+     *         calling thread is not a worker.
+     */
+    [[nodiscard]] static std::pmr::memory_resource* localMemoryResource() noexcept;
 
   private:
+    static constexpr auto log_module = logging::LogModule::ThreadPool;
+
+    template <class Functor, class Token>
+    [[nodiscard]] static auto makeTask(Functor&& func, Token token)
+        -> std::pair<Task, future::Future<std::invoke_result_t<std::decay_t<Functor>&>>>;
+
+    template <class Result>
+    [[nodiscard]] auto enqueuePrioritized(Priority priority, Task&& task,
+                                          future::Future<Result>&& future) noexcept
+        -> future::Future<Result>;
+
+    // Task waiting in one of the queues.
+    struct QueuedTask
+    {
+        Task task;
+
+        // Steady clock time of the dispatch, only set when collecting stats.
+        int64_t queuedAt{0};
+    };
+
+    // Spare nodes kept by every worker, and shared by the whole pool.
+    static constexpr size_t local_free_nodes  = 256;
+    static constexpr size_t shared_free_nodes = 1024;
+
+    struct Worker
+    {
+        Worker(ThreadPool& owner, size_t index) : owner(owner), index(index)
+        {
+            freeNodes.reserve(local_free_nodes);
+        }
+
+        ThreadPool& owner;
+        size_t index;
+        atomic::WorkStealingDeque<QueuedTask*> deque{};
+        std::binary_semaphore wakeup{0};
+        std::pmr::unsynchronized_pool_resource memory{};
+
+        // Tasks the worker can still take from every lane in the current
+        // round of weighted scheduling.
+        std::array<uint32_t, num_priorities> credits{};
+
+        // Nodes of the tasks the worker ran, reused for the tasks it queues,
+        // so dispatching from a worker does not allocate. Only the thread
+        // running the worker touches them.
+        std::vector<std::unique_ptr<QueuedTask>> freeNodes{};
+
+        // Stats, written only by the thread running the worker.
+        int64_t createdAt{0};
+        std::atomic<uint64_t> tasksRun{0};
+        std::atomic<uint64_t> steals{0};
+        std::atomic<uint64_t> busyNanos{0};
+    };
+
+    struct Lane
+    {
+        atomic::AtomicQueue<QueuedTask*> queue{};
+        std::atomic<size_t> size{0};
+    };
+
+    // Place of a single worker. Its Worker object is created by the first
+    // thread started in the slot and lives as long as the pool, so other
+    // workers can keep stealing from it after the thread is retired.
+    struct Slot
+    {
+        std::atomic<Worker*> worker{nullptr};
+        std::unique_ptr<Worker> owned{};
+
+        // Guarded by `spawnMutex`.
+        std::thread thread{};
+        bool running{false};
+
+        // Set by the thread as the very last thing it does, it can be
+        // joined without waiting on anything else from then on.
+        std::atomic_bool exited{true};
+    };
+
+    // How many times an idle worker looks for work before parking.
+    static constexpr size_t spin_rounds = 64;
+
+    // Worker of this pool running on the calling thread, if any.
+    static thread_local Worker* localWorker;
+
+    void enqueue(Task&& task) noexcept;
+    // Pushes into a lane where a place was reserved for the task already.
+    void enqueueToLane(Task&& task, Priority priority) noexcept;
+    void enqueueBulk(std::vector<Task>&& tasks) noexcept;
+    void notifyEnqueued(size_t numTasks) noexcept;
+    void noteLaneDepth(size_t lane, size_t depth) noexcept;
+
+    void runTask(Worker& self, std::unique_ptr<QueuedTask> task) noexcept;
+
+    // Tasks are counted into a lane before they are pushed, so a worker
+    // which pops one never takes the size below zero.
+    void reserveLane(size_t lane, size_t numTasks) noexcept;
+
+    // Reserves a place in the lane unless `maxDepth` tasks are there
+    // already. Refusals are counted as rejected tasks.
+    [[nodiscard]] bool admit(Priority priority) noexcept;
+
+    bool spawnWorker(bool initial = false) noexcept;
+    void startWorker(size_t index, bool initial) noexcept;
+    void runWorker(Worker& self) noexcept;
+
+    // Marks the start or the end of a backlog, for the monitor to time it.
+    void noteBacklog(bool backlogged) noexcept;
+
+    // Starts a new worker whenever the queues stay backlogged for too long.
+    void monitorLoad() noexcept;
+
+    // Tries to take an idle worker out of the pool, false if it has to stay.
+    [[nodiscard]] bool retire(Worker& self) noexcept;
+
+    [[nodiscard]] QueuedTask* makeQueued(Task&& task) noexcept;
+    [[nodiscard]] std::unique_ptr<QueuedTask> takeNode() noexcept;
+    void recycleNode(Worker& self, std::unique_ptr<QueuedTask> node) noexcept;
+    [[nodiscard]] std::unique_ptr<QueuedTask> findTask(Worker& self) noexcept;
+    [[nodiscard]] std::unique_ptr<QueuedTask> takeFromLane(size_t lane) noexcept;
+    [[nodiscard]] std::unique_ptr<QueuedTask> stealTask(Worker& self) noexcept;
+    [[nodiscard]] std::array<size_t, num_priorities> laneOrder(Worker& self) const noexcept;
+    [[nodiscard]] bool hasLaneTasks() const noexcept;
+    [[nodiscard]] bool hasQueuedTasks() const noexcept;
+
+    void waitUntilDrained() noexcept;
+    void cancelQueued() noexcept;
+
+    // Series of the pool in the global metrics registry, labelled with the
+    // number of the pool. Unregistering removes the callback gauges first,
+    // they capture the pool.
+    void registerMetrics();
+    void unregisterMetrics() noexcept;
+
+    [[nodiscard]] inline bool isLocalWorker() const noexcept
+    {
+        return localWorker != nullptr && &localWorker->owner == this;
+    }
+
+    // Returns false if the worker was retired instead of woken up.
+    [[nodiscard]] bool park(Worker& self) noexcept;
+    void wake(size_t count) noexcept;
+    void wakeAll() noexcept;
+
     std::atomic_bool shutdownFlag;
-    std::vector<std::thread> workers;
-    atomic::AtomicQueue<std::function<void()>> queue;
+    WorkerPlacement placement;
+    LanePolicy lanePolicy;
+    std::optional<ElasticPolicy> elastic;
+    std::vector<Slot> slots;
+    std::latch started;
+
+    std::mutex spawnMutex;
+    std::atomic<size_t> numRunning;
+
+    // Time since epoch of the steady clock when the backlog was first
+    // noticed, zero if there is none.
+    std::atomic<int64_t> backlogSince;
+
+    std::mutex monitorMutex;
+    std::condition_variable monitorCondition;
+    std::thread monitor;
+
+    std::array<Lane, num_priorities> lanes;
+
+    // Spare nodes of the workers whose own lists are full, taken by the
+    // threads dispatching from outside of the pool.
+    atomic::MpmcQueue<QueuedTask*> sharedNodes;
+
+    std::mutex idleMutex;
+    std::vector<Worker*> idleWorkers;
+    std::atomic<size_t> numIdle;
+
+    // Signalled under `idleMutex` whenever all the running workers are idle.
+    std::condition_variable drained;
+
+    metrics::Labels metricsLabels;
+    // Rendered up front, so the series can be removed without allocating.
+    std::string metricsKey;
+    std::array<std::string, num_priorities> laneMetricsKeys;
+    // Registered in the constructor body, so a failure removes them again.
+    metrics::Counter* submittedTasks{nullptr};
+    metrics::Counter* executedTasks{nullptr};
+    metrics::Counter* rejectedTasks{nullptr};
+
+    struct Statistics
+    {
+        metrics::Histogram& waitTime;
+        metrics::Histogram& runTime;
+        std::array<std::atomic<size_t>, num_priorities> laneHighWater{};
+    };
+
+    // Present only if the pool collects stats.
+    std::unique_ptr<Statistics> statistics;
 };
 } // namespace cfdp::runtime::thread_pool
 
+namespace cfdp::runtime::thread_pool::detail
+{
+// Stands for the stop token of tasks dispatched without one, so they do
+// not pay for it in the inline storage.
+struct NoStopToken
+{
+    [[nodiscard]] static constexpr bool stop_requested() noexcept { return false; }
+};
+
+// Body of a dispatched task, which fulfills the promise of its future.
+template <class Functor, class Token>
+struct PromisedTask
+{
+    using Result = std::invoke_result_t<Functor&>;
+
+    ::cfdp::runtime::future::Promise<Result> promise;
+    Functor func;
+    [[no_unique_address]] Token token;
+
+    void operator()()
+    {
+        if (token.stop_requested())
+        {
+            cancel();
+            return;
+        }
+
+        try
+        {
+            if constexpr (std::is_void_v<Result>)
+            {
+                std::invoke(func);
+                promise.setValue();
+            }
+            else
+            {
+                promise.setValue(std::invoke(func));
+            }
+        }
+        catch (...)
+        {
+            promise.setException(std::current_exception());
+        }
+    }
+
+    void cancel() noexcept
+    {
+        try
+        {
+            promise.setException(std::make_exception_ptr(std::system_error{
+                std::make_error_code(std::errc::operation_canceled), "task was cancelled"}));
+        }
+        catch (const std::future_error& error)
+        {
+            ::cfdp::runtime::logging::error<::cfdp::runtime::logging::LogModule::ThreadPool>(
+                "could not cancel a task: {}", error.what());
+        }
+    }
+};
+} // namespace cfdp::runtime::thread_pool::detail
+
 namespace
 {
 using ::cfdp::runtime::atomic::AtomicQueue;
@@ -45,30 +574,140 @@ using ::cfdp::runtime::future::Future;
 using ::cfdp::runtime::thread_pool::ThreadPool;
 } // namespace
 
+template <class Functor, class Token>
+auto ThreadPool::makeTask(Functor&& func, Token token)
+    -> std::pair<Task, Future<std::invoke_result_t<std::decay_t<Functor>&>>>
+{
+    using Result = std::invoke_result_t<std::decay_t<Functor>&>;
+
+    auto promise = future::Promise<Result>{};
+    auto future  = promise.getFuture();
+
+    // The promise is moved into the task itself, for small functors the
+    // whole wrapper fits in the inline storage of the task.
+    auto task = Task{detail::PromisedTask<std::decay_t<Functor>, Token>{
+        .promise = std::move(promise),
+        .func    = std::forward<Functor>(func),
+        .token   = std::move(token),
+    }};
+
+    return {std::move(task), std::move(future)};
+}
+
+template <class Result>
+auto ThreadPool::enqueuePrioritized(Priority priority, Task&& task,
+                                    Future<Result>&& future) noexcept -> Future<Result>
+{
+    if (!admit(priority))
+    {
+        logging::warn<log_module>("lane of priority {} is full, rejecting a task",
+                                  static_cast<int>(priority));
+
+        // Dropping the task breaks its promise, so fail it explicitly.
+        auto rejected = future::Promise<Result>{};
+        rejected.setException(std::make_exception_ptr(
+            std::system_error{std::make_error_code(std::errc::resource_unavailable_try_again),
+                              "thread pool lane is full"}));
+
+        return rejected.getFuture();
+    }
+
+    enqueueToLane(std::move(task), priority);
+
+    return std::move(future);
+}
+
 template <class Functor>
     requires std::invocable<Functor>
 auto ThreadPool::dispatchTask(Functor&& func) noexcept -> Future<decltype(func())>
 {
-    // Unfortunately std::function does not provide a constructor for
-    // moving lambdas. We can't directly move the promise to the task,
-    // so as a W/A we can wrap it into std::shared_ptr and copy it.
-    auto promise = std::make_shared<std::promise<decltype(func())>>();
+    logging::trace<log_module>("dispatching a new task, queue size: {}",
+                               laneSize(Priority::Normal));
 
-    logging::trace("dispatching a new task, queue size: {}", queue.sizeNow());
+    auto [task, future] = makeTask(std::forward<Functor>(func), detail::NoStopToken{});
+    enqueue(std::move(task));
 
-    std::function<void()> wrapper = [promise, func]() mutable {
-        try
-        {
-            auto result = std::invoke(func);
-            promise->set_value(result);
-        }
-        catch (...)
-        {
-            promise->set_exception(std::current_exception());
-        }
-    };
+    return std::move(future);
+}
+
+template <class Functor>
+    requires std::invocable<Functor>
+auto ThreadPool::dispatchTask(Priority priority, Functor&& func) noexcept
+    -> Future<decltype(func())>
+{
+    logging::trace<log_module>("dispatching a new task with priority {}, lane size: {}",
+                               static_cast<int>(priority), laneSize(priority));
+
+    auto [task, future] = makeTask(std::forward<Functor>(func), detail::NoStopToken{});
+
+    return enqueuePrioritized(priority, std::move(task), std::move(future));
+}
+
+template <class Functor>
+    requires std::invocable<Functor>
+auto ThreadPool::dispatchTask(std::stop_token token, Functor&& func) noexcept
+    -> Future<decltype(func())>
+{
+    logging::trace<log_module>("dispatching a new cancellable task, queue size: {}",
+                               laneSize(Priority::Normal));
+
+    auto [task, future] = makeTask(std::forward<Functor>(func), std::move(token));
+    enqueue(std::move(task));
+
+    return std::move(future);
+}
+
+template <class Functor>
+    requires std::invocable<Functor>
+auto ThreadPool::dispatchTask(Priority priority, std::stop_token token, Functor&& func) noexcept
+    -> Future<decltype(func())>
+{
+    logging::trace<log_module>("dispatching a new cancellable task with priority {}, lane size: {}",
+                               static_cast<int>(priority), laneSize(priority));
+
+    auto [task, future] = makeTask(std::forward<Functor>(func), std::move(token));
+
+    return enqueuePrioritized(priority, std::move(task), std::move(future));
+}
+
+template <std::ranges::input_range Range>
+    requires std::invocable<std::ranges::range_value_t<Range>&>
+auto ThreadPool::dispatchBulk(Range&& functors) noexcept
+    -> std::vector<Future<std::invoke_result_t<std::ranges::range_value_t<Range>&>>>
+{
+    using Functor = std::ranges::range_value_t<Range>;
+    using Result  = std::invoke_result_t<Functor&>;
+
+    auto tasks   = std::vector<Task>{};
+    auto futures = std::vector<Future<Result>>{};
+
+    if constexpr (std::ranges::sized_range<Range>)
+    {
+        tasks.reserve(std::ranges::size(functors));
+        futures.reserve(std::ranges::size(functors));
+    }
+
+    for (auto&& func : functors)
+    {
+        // Functors of a range passed as an rvalue are moved, not copied.
+        auto [task, future] = [&func]() {
+            if constexpr (std::is_lvalue_reference_v<Range>)
+            {
+                return makeTask(Functor{func}, detail::NoStopToken{});
+            }
+            else
+            {
+                return makeTask(Functor{std::move(func)}, detail::NoStopToken{});
+            }
+        }();
+        tasks.push_back(std::move(task));
+        futures.push_back(std::move(future));
+    }
+
+    logging::trace<log_module>("dispatching {} tasks in bulk, queue size: {}", tasks.size(),
+                               laneSize(Priority::Normal));
 
-    queue.emplace(std::move(wrapper));
+    enqueueBulk(std::move(tasks));
 
-    return Future{promise->get_future()};
+    return futures;
 }
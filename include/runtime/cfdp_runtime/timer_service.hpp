@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "task.hpp"
+#include "thread_pool.hpp"
+#include "timing_wheel.hpp"
+
+namespace cfdp::runtime::timer
+{
+/**
+ * Timer facility for the protocol timers (ACK, NAK, inactivity, keep alive).
+ *
+ * A single thread drives a TimingWheel and hands the callbacks of expired
+ * timers over to the thread pool, in one batch per tick. The thread sleeps
+ * until the next tick with something to do, arming a timer wakes it up only
+ * if the new timer is due before that, so the service stays idle no matter
+ * how many timers are pending.
+ *
+ * Timers never fire early, but they can fire up to one tick late.
+ */
+class TimerService
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerService(thread_pool::ThreadPool& pool,
+                          Clock::duration tickDuration = std::chrono::milliseconds(1));
+    ~TimerService();
+
+    TimerService(const TimerService&)            = delete;
+    TimerService& operator=(TimerService const&) = delete;
+    TimerService(TimerService&&)                 = delete;
+    TimerService& operator=(TimerService&&)      = delete;
+
+    /**
+     * Arms a timer running `callback` on the thread pool after `delay`.
+     *
+     * @return handle used to cancel or rearm the timer.
+     */
+    TimerId scheduleAfter(Clock::duration delay, thread_pool::Task&& callback);
+    TimerId scheduleAt(Clock::time_point deadline, thread_pool::Task&& callback);
+
+    /**
+     * Cancels the timer.
+     *
+     * @return false if the timer already fired or was cancelled.
+     */
+    bool cancel(TimerId id) noexcept;
+
+    /**
+     * Restarts the timer, so it fires `delay` from now. This is how the
+     * inactivity timer is pushed back every time a PDU arrives.
+     *
+     * @return false if the timer already fired or was cancelled.
+     */
+    bool rearm(TimerId id, Clock::duration delay) noexcept;
+
+    /**
+     * Stops the service thread. Pending timers never fire afterwards.
+     */
+    void stop() noexcept;
+
+    [[nodiscard]] size_t sizeNow() const noexcept;
+    [[nodiscard]] inline Clock::duration tickDuration() const noexcept { return tick; }
+
+  private:
+    static constexpr auto log_module = logging::LogModule::Timer;
+
+    static constexpr uint64_t no_wakeup = std::numeric_limits<uint64_t>::max();
+
+    // First tick at which `deadline` is already in the past.
+    [[nodiscard]] uint64_t expiryTick(Clock::time_point deadline) const noexcept;
+    [[nodiscard]] uint64_t currentTick() const noexcept;
+
+    void notifyIfEarlier(uint64_t expiry) noexcept;
+    void run() noexcept;
+
+    thread_pool::ThreadPool& pool;
+    const Clock::duration tick;
+    const Clock::time_point epoch;
+
+    mutable std::mutex mutex{};
+    std::condition_variable wakeupCond{};
+    TimingWheel wheel{};
+    uint64_t wakeupTick{no_wakeup};
+    bool stopped{false};
+
+    std::thread thread{};
+};
+} // namespace cfdp::runtime::timer
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "task.hpp"
+
+namespace cfdp::runtime::timer
+{
+/**
+ * Handle of an armed timer. It becomes stale once the timer fires or is
+ * cancelled, every operation on a stale handle is a no-op.
+ */
+struct TimerId
+{
+    static constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+    uint32_t index{invalid_index};
+    uint32_t generation{0};
+
+    [[nodiscard]] bool operator==(const TimerId&) const noexcept = default;
+};
+
+/**
+ * Anything which runs callbacks after a delay measured by its own clock,
+ * like the TimerService, or the virtual time of a simulation.
+ */
+template <class T>
+concept TimerSource = requires(T& timers, typename T::Clock::duration delay,
+                               thread_pool::Task callback, TimerId id) {
+    { timers.scheduleAfter(delay, std::move(callback)) } -> std::same_as<TimerId>;
+    { timers.cancel(id) } -> std::same_as<bool>;
+};
+
+/**
+ * Hierarchical timing wheel, counting time in abstract ticks.
+ *
+ * Timers are kept in `num_levels` wheels of `num_slots` slots each, every
+ * level covering a range `num_slots` times wider than the previous one.
+ * A timer lands in the lowest level able to hold it and moves down the
+ * levels (cascades) as the time passes, so arming, cancelling and
+ * rearming are all O(1). Timers further in the future than `max_delta`
+ * ticks simply cascade more than once.
+ *
+ * Timers live in a single slab indexed by TimerId, whose generation tells
+ * a reused node apart from the timer it used to hold. Occupancy bitmaps
+ * let `advance` jump over empty slots (and over whole empty rotations),
+ * so the cost of advancing barely depends on how much time has passed.
+ *
+ * The wheel is not thread safe, see TimerService for a threaded driver.
+ */
+class TimingWheel
+{
+  public:
+    static constexpr size_t slot_bits  = 8;
+    static constexpr size_t num_slots  = size_t{1} << slot_bits;
+    static constexpr size_t num_levels = 4;
+    static constexpr uint64_t max_delta = (uint64_t{1} << (slot_bits * num_levels)) - 1;
+
+    explicit TimingWheel(uint64_t startTick = 0) noexcept;
+
+    /**
+     * Arms a new timer. Timers armed in the past fire on the next advance.
+     *
+     * @param expiryTick tick at which the timer fires.
+     * @param callback task handed over to `advance` when the timer fires.
+     * @return handle of the timer.
+     */
+    TimerId arm(uint64_t expiryTick, thread_pool::Task&& callback);
+
+    /**
+     * Cancels the timer, dropping its callback.
+     *
+     * @return false if the timer already fired or was cancelled.
+     */
+    bool cancel(TimerId id) noexcept;
+
+    /**
+     * Moves an armed timer to another tick, keeping its callback.
+     *
+     * @return false if the timer already fired or was cancelled.
+     */
+    bool rearm(TimerId id, uint64_t expiryTick) noexcept;
+
+    /**
+     * Moves the time forward up to (and including) `tick`, appending the
+     * callbacks of all the expired timers to `expired`.
+     *
+     * @return number of expired timers.
+     */
+    size_t advance(uint64_t tick, std::vector<thread_pool::Task>& expired);
+
+    /**
+     * Returns the earliest tick at which `advance` has something to do.
+     * It is exact for timers due in the current rotation of the lowest
+     * level, otherwise it is the next cascade of a non-empty slot.
+     * Sleeping until then is always safe, no timer can expire before.
+     *
+     * @return std::nullopt if there are no timers.
+     */
+    [[nodiscard]] std::optional<uint64_t> nextExpiry() const noexcept;
+
+    [[nodiscard]] bool isArmed(TimerId id) const noexcept;
+
+    void reserve(size_t numTimers);
+
+    [[nodiscard]] inline size_t sizeNow() const noexcept { return numTimers; }
+    [[nodiscard]] inline uint64_t currentTick() const noexcept { return current; }
+
+  private:
+    static constexpr uint32_t nil           = std::numeric_limits<uint32_t>::max();
+    static constexpr uint16_t free_location = std::numeric_limits<uint16_t>::max();
+    static constexpr uint64_t slot_mask     = num_slots - 1;
+
+    struct Node
+    {
+        thread_pool::Task callback{};
+        uint64_t expiry{0};
+        uint32_t prev{nil};
+        uint32_t next{nil};
+        uint32_t generation{0};
+        // Level and slot the node is linked into, `level * num_slots + slot`.
+        uint16_t location{free_location};
+    };
+
+    struct Level
+    {
+        Level() { heads.fill(nil); }
+
+        std::array<uint32_t, num_slots> heads{};
+        std::array<uint64_t, num_slots / 64> occupied{};
+    };
+
+    void link(uint32_t index) noexcept;
+    void unlink(uint32_t index) noexcept;
+    void release(uint32_t index) noexcept;
+    void cascade(size_t level) noexcept;
+    size_t expireSlot(size_t slot, std::vector<thread_pool::Task>& expired);
+
+    // First tick at which a timer expires or a non-empty slot cascades.
+    [[nodiscard]] std::optional<uint64_t> nextEvent(bool currentSlotDone) const noexcept;
+
+    [[nodiscard]] static bool isEmpty(const Level& level) noexcept;
+    [[nodiscard]] static std::optional<size_t> nextOccupied(const Level& level,
+                                                            size_t from) noexcept;
+
+    std::vector<Node> nodes{};
+    uint32_t freeHead{nil};
+    std::array<Level, num_levels> levels{};
+    uint64_t current;
+    size_t numTimers{0};
+};
+} // namespace cfdp::runtime::timer
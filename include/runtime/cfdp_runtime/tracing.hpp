@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace cfdp::runtime::tracing
+{
+// Events kept per thread, once a buffer is full the oldest events are
+// overwritten, so the trace always ends with the most recent activity.
+constexpr size_t default_events_per_thread = size_t{1} << 16;
+
+/**
+ * Single entry of a trace. Names, categories and argument names are not
+ * copied, they have to outlive the trace, like string literals do.
+ */
+struct Event
+{
+    const char* name{nullptr};
+    const char* category{nullptr};
+    const char* argName{nullptr};
+    int64_t argValue{0};
+
+    // Steady clock nanoseconds, the duration is zero for instant events.
+    int64_t timestamp{0};
+    int64_t duration{0};
+
+    bool instant{false};
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+inline auto tracing_enabled = std::atomic_bool{false};
+
+[[nodiscard]] inline bool isEnabled() noexcept
+{
+    return tracing_enabled.load(std::memory_order_relaxed);
+}
+
+[[nodiscard]] inline int64_t now() noexcept
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+/**
+ * Clears every buffer and starts recording.
+ *
+ * @param eventsPerThread capacity of the buffer of every thread.
+ */
+void start(size_t eventsPerThread = default_events_per_thread);
+
+/**
+ * Stops recording, the recorded events are kept until the next start.
+ */
+void stop() noexcept;
+
+/**
+ * Names the calling thread in the exported traces. While tracing is stopped
+ * the name is only remembered, the thread joins a trace once it records.
+ */
+void setThreadName(std::string name);
+
+void record(const Event& event) noexcept;
+
+inline void instant(const char* name, const char* category, const char* argName = nullptr,
+                    int64_t argValue = 0) noexcept
+{
+    if (isEnabled())
+    {
+        record(Event{
+            .name      = name,
+            .category  = category,
+            .argName   = argName,
+            .argValue  = argValue,
+            .timestamp = now(),
+            .duration  = 0,
+            .instant   = true,
+        });
+    }
+}
+
+/**
+ * Renders the recorded events of all threads, including the ones which
+ * already exited, in the Chrome Trace Event JSON format, which can be
+ * opened in Perfetto or chrome://tracing. Buffers of exited threads are
+ * released once exported, a later export no longer contains them.
+ */
+[[nodiscard]] std::string exportChromeJson();
+
+/**
+ * Writes the trace to a file.
+ *
+ * @throw std::system_error if the file could not be written.
+ */
+void exportToFile(const std::filesystem::path& path);
+
+/**
+ * Records the time between its construction and destruction as a span on
+ * the calling thread. Spans nest, a span opened within another one shows
+ * up below it on the timeline.
+ *
+ * While tracing is stopped a span costs a single relaxed load.
+ */
+class Span
+{
+  public:
+    inline Span(const char* name, const char* category, const char* argName = nullptr,
+                int64_t argValue = 0) noexcept
+        : name(name), category(category), argName(argName), argValue(argValue),
+          begin(isEnabled() ? now() : 0)
+    {}
+
+    inline ~Span()
+    {
+        if (begin != 0)
+        {
+            record(Event{
+                .name      = name,
+                .category  = category,
+                .argName   = argName,
+                .argValue  = argValue,
+                .timestamp = begin,
+                .duration  = now() - begin,
+                .instant   = false,
+            });
+        }
+    }
+
+    Span(const Span&)            = delete;
+    Span& operator=(Span const&) = delete;
+    Span(Span&&)                 = delete;
+    Span& operator=(Span&&)      = delete;
+
+  private:
+    const char* name;
+    const char* category;
+    const char* argName;
+    int64_t argValue;
+    int64_t begin;
+};
+} // namespace cfdp::runtime::tracing
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+
+#include "file_descriptor.hpp"
+
+namespace cfdp::runtime::io
+{
+/**
+ * Encoded PDU handed over to a transport in two parts, which are sent as
+ * one. The file data of a File Data PDU stays in the read buffer it was
+ * read into, only the fields before it are encoded separately.
+ */
+struct OutgoingPdu
+{
+    std::span<const uint8_t> header{};
+    std::span<const uint8_t> payload{};
+};
+
+/**
+ * Destination of the encoded PDUs of a sender.
+ *
+ * Transactions transmit their PDUs in batches, in order. Concurrent
+ * transactions may transmit at the same time, so implementations have to
+ * be thread safe.
+ */
+class Transport
+{
+  public:
+    Transport()          = default;
+    virtual ~Transport() = default;
+
+    Transport(const Transport&)            = delete;
+    Transport& operator=(Transport const&) = delete;
+    Transport(Transport&&)                 = delete;
+    Transport& operator=(Transport&&)      = delete;
+
+    /**
+     * The parts of the PDUs only have to stay valid for the duration of
+     * the call.
+     *
+     * @throw std::system_error if the PDUs could not be transmitted.
+     */
+    virtual void transmit(std::span<const OutgoingPdu> pdus) = 0;
+
+    /**
+     * Largest encoded PDU, header and payload together, the transport can
+     * carry. Unlimited unless the transport says otherwise.
+     */
+    [[nodiscard]] virtual size_t maxPduSize() const noexcept
+    {
+        return std::numeric_limits<size_t>::max();
+    }
+};
+
+/**
+ * Sends every PDU as a single UDP datagram, a batch takes a single system
+ * call per `max_batch_datagrams` PDUs.
+ *
+ * Nothing is acknowledged in Class 1, so a missing receiver is not an
+ * error, the PDUs are simply lost, like on any unreliable link.
+ */
+class UdpTransport final : public Transport
+{
+  public:
+    static constexpr size_t max_batch_datagrams = 64;
+
+    // Largest UDP payload over IPv4, what is left of 65535 bytes after the
+    // IPv4 and UDP headers.
+    static constexpr size_t max_datagram_size = 65507;
+
+    /**
+     * Connects a UDP socket to the receiver.
+     *
+     * @param address IPv4 address of the receiver, like "127.0.0.1".
+     * @param port UDP port of the receiver.
+     * @throw std::system_error if the socket could not be created.
+     * @throw std::invalid_argument if the address is malformed.
+     */
+    UdpTransport(const std::string& address, uint16_t port);
+
+    void transmit(std::span<const OutgoingPdu> pdus) override;
+
+    [[nodiscard]] size_t maxPduSize() const noexcept override { return max_datagram_size; }
+
+  private:
+    FileDescriptor socket{};
+};
+} // namespace cfdp::runtime::io
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "hardware.hpp"
+
+namespace cfdp::runtime::atomic
+{
+/**
+ * Chase-Lev work stealing deque, as described in "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+ *
+ * Only the owning thread may `push` and `pop` items, both operate on the
+ * bottom end of the deque. Any other thread may `steal` from the top end.
+ * Items are kept in atomic slots, so they have to be trivially copyable,
+ * in practice these are pointers to the real payload.
+ */
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+class WorkStealingDeque
+{
+  public:
+    explicit WorkStealingDeque(size_t initialCapacity = 256);
+    ~WorkStealingDeque() = default;
+
+    WorkStealingDeque(const WorkStealingDeque&)            = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque const&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&)                 = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque&&)      = delete;
+
+    void push(T item) noexcept;
+    std::optional<T> pop() noexcept;
+    std::optional<T> steal() noexcept;
+
+    [[nodiscard]] inline size_t sizeNow() const noexcept
+    {
+        const auto size =
+            bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+
+    [[nodiscard]] inline bool isEmpty() const noexcept { return sizeNow() == 0; }
+
+  private:
+    class Buffer
+    {
+      public:
+        explicit Buffer(size_t capacity)
+            : mask(capacity - 1), slots(std::make_unique<std::atomic<T>[]>(capacity))
+        {}
+
+        [[nodiscard]] inline size_t capacity() const noexcept { return mask + 1; }
+
+        [[nodiscard]] inline T load(int64_t index) const noexcept
+        {
+            return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        inline void store(int64_t index, T item) noexcept
+        {
+            slots[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+
+      private:
+        size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Buffer* grow(Buffer* current, int64_t topIndex, int64_t bottomIndex);
+
+    // Thieves hammer the top index, while the owner mostly touches the
+    // bottom one. Keeping them on separate cache lines avoids false sharing.
+    alignas(hardware::cache_line_size) std::atomic<int64_t> top{0};
+    alignas(hardware::cache_line_size) std::atomic<int64_t> bottom{0};
+    std::atomic<Buffer*> buffer{nullptr};
+
+    // A thief may still read from a buffer which was already replaced
+    // by a larger one, so retired buffers live as long as the deque.
+    std::vector<std::unique_ptr<Buffer>> buffers{};
+};
+} // namespace cfdp::runtime::atomic
+
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+cfdp::runtime::atomic::WorkStealingDeque<T>::WorkStealingDeque(size_t initialCapacity)
+{
+    // Indexing relies on masking, so the capacity has to be a power of two.
+    auto capacity = size_t{1};
+    while (capacity < initialCapacity)
+    {
+        capacity <<= 1;
+    }
+
+    buffers.push_back(std::make_unique<Buffer>(capacity));
+    buffer.store(buffers.back().get(), std::memory_order_relaxed);
+}
+
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+void cfdp::runtime::atomic::WorkStealingDeque<T>::push(T item) noexcept
+{
+    const auto bottomIndex = bottom.load(std::memory_order_relaxed);
+    const auto topIndex    = top.load(std::memory_order_acquire);
+    auto* current          = buffer.load(std::memory_order_relaxed);
+
+    if (bottomIndex - topIndex > static_cast<int64_t>(current->capacity()) - 1)
+    {
+        current = grow(current, topIndex, bottomIndex);
+    }
+
+    current->store(bottomIndex, item);
+
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(bottomIndex + 1, std::memory_order_relaxed);
+}
+
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+std::optional<T> cfdp::runtime::atomic::WorkStealingDeque<T>::pop() noexcept
+{
+    const auto bottomIndex = bottom.load(std::memory_order_relaxed) - 1;
+    auto* current          = buffer.load(std::memory_order_relaxed);
+
+    bottom.store(bottomIndex, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    auto topIndex = top.load(std::memory_order_relaxed);
+
+    if (topIndex > bottomIndex)
+    {
+        bottom.store(bottomIndex + 1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    auto item = current->load(bottomIndex);
+
+    if (topIndex == bottomIndex)
+    {
+        // Last item in the deque, we have to race with thieves for it.
+        const auto won = top.compare_exchange_strong(topIndex, topIndex + 1,
+                                                     std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+        bottom.store(bottomIndex + 1, std::memory_order_relaxed);
+
+        if (!won)
+        {
+            return std::nullopt;
+        }
+    }
+
+    return std::make_optional(item);
+}
+
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+std::optional<T> cfdp::runtime::atomic::WorkStealingDeque<T>::steal() noexcept
+{
+    auto topIndex = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto bottomIndex = bottom.load(std::memory_order_acquire);
+
+    if (topIndex >= bottomIndex)
+    {
+        return std::nullopt;
+    }
+
+    auto* current = buffer.load(std::memory_order_acquire);
+    auto item     = current->load(topIndex);
+
+    if (!top.compare_exchange_strong(topIndex, topIndex + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed))
+    {
+        // Lost the race with the owner or another thief.
+        return std::nullopt;
+    }
+
+    return std::make_optional(item);
+}
+
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+auto cfdp::runtime::atomic::WorkStealingDeque<T>::grow(Buffer* current, int64_t topIndex,
+                                                       int64_t bottomIndex) -> Buffer*
+{
+    auto larger = std::make_unique<Buffer>(current->capacity() * 2);
+
+    for (auto i = topIndex; i < bottomIndex; ++i)
+    {
+        larger->store(i, current->load(i));
+    }
+
+    auto* raw = larger.get();
+    buffers.push_back(std::move(larger));
+    buffer.store(raw, std::memory_order_release);
+
+    return raw;
+}
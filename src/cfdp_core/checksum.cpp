@@ -0,0 +1,50 @@
+#include <cfdp_core/checksum.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+constexpr uint64_t word_size = sizeof(uint32_t);
+
+// Adds a byte at its position within the word of its file offset.
+[[nodiscard]] constexpr uint32_t byteAt(uint8_t byte, uint64_t offset) noexcept
+{
+    return uint32_t{byte} << (8 * (word_size - 1 - offset % word_size));
+}
+} // namespace
+
+void cfdp::checksum::ModularChecksum::update(uint64_t offset,
+                                             std::span<uint8_t const> data) noexcept
+{
+    auto result = sum;
+    auto index  = size_t{0};
+
+    for (; index < data.size() && (offset + index) % word_size != 0; ++index)
+    {
+        result += byteAt(data[index], offset + index);
+    }
+
+    // Whole words are loaded at once, the loop is simple enough to be
+    // vectorized by the compiler.
+    for (; index + word_size <= data.size(); index += word_size)
+    {
+        auto word = uint32_t{0};
+        std::memcpy(&word, data.data() + index, word_size);
+
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            word = std::byteswap(word);
+        }
+
+        result += word;
+    }
+
+    for (; index < data.size(); ++index)
+    {
+        result += byteAt(data[index], offset + index);
+    }
+
+    sum = result;
+}
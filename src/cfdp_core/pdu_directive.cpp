@@ -19,6 +19,11 @@ constexpr uint8_t ack_condition_code_bitmask         = 0b1111'0000;
 constexpr uint8_t ack_transaction_status_bitmask     = 0b0000'0011;
 
 constexpr uint8_t eof_condition_code_bitmask = 0b1111'0000;
+
+constexpr uint8_t metadata_closure_requested_bitmask = 0b0100'0000;
+constexpr uint8_t metadata_checksum_type_bitmask     = 0b0000'1111;
+
+constexpr size_t max_lv_value_size = UINT8_MAX;
 } // namespace
 
 namespace header    = ::cfdp::pdu::header;
@@ -223,3 +228,79 @@ std::vector<uint8_t> cfdp::pdu::directive::EndOfFile::encodeToBytes() const
 
     return encodedPdu;
 }
+
+cfdp::pdu::directive::Metadata::Metadata(bool closureRequested, ChecksumType checksumType,
+                                         uint64_t fileSize, LargeFileFlag largeFileFlag,
+                                         std::string&& sourceFileName,
+                                         std::string&& destinationFileName)
+    : closureRequested(closureRequested), checksumType(checksumType), fileSize(fileSize),
+      largeFileFlag(largeFileFlag), sourceFileName(std::move(sourceFileName)),
+      destinationFileName(std::move(destinationFileName))
+{
+    if (largeFileFlag == LargeFileFlag::SmallFile &&
+        utils::bytesNeeded(fileSize) > sizeof(uint32_t))
+    {
+        throw exception::PduConstructionException("FileSize exceeds small file size");
+    }
+
+    if (this->sourceFileName.length() > max_lv_value_size ||
+        this->destinationFileName.length() > max_lv_value_size)
+    {
+        throw exception::PduConstructionException("File name does not fit in LV value");
+    }
+}
+
+cfdp::pdu::directive::Metadata::Metadata(std::span<uint8_t const> memory,
+                                         LargeFileFlag largeFileFlag)
+    : largeFileFlag(largeFileFlag)
+{
+    if (memory.size() < static_cast<size_t>(const_pdu_size_bytes + getSizeOfFileSize()))
+    {
+        throw exception::DecodeFromBytesException("Passed memory does not contain enough bytes");
+    }
+
+    if (memory[0] != utils::toUnderlying(Directive::Metadata))
+    {
+        throw exception::DecodeFromBytesException("File Directive code is not Metadata Pdu");
+    }
+
+    const auto secondByte = memory[1];
+
+    closureRequested = (secondByte & metadata_closure_requested_bitmask) != 0;
+    checksumType     = ChecksumType(secondByte & metadata_checksum_type_bitmask);
+    fileSize         = utils::bytesToInt<uint64_t>(memory, 2, getSizeOfFileSize());
+
+    const auto sourceOffset = const_pdu_size_bytes + getSizeOfFileSize();
+    const auto sourceName   = utils::readLvValue(memory, sourceOffset);
+    sourceFileName          = std::string{sourceName.begin(), sourceName.end()};
+
+    const auto destinationName =
+        utils::readLvValue(memory, sourceOffset + sizeof(uint8_t) + sourceName.size());
+    destinationFileName = std::string{destinationName.begin(), destinationName.end()};
+}
+
+std::vector<uint8_t> cfdp::pdu::directive::Metadata::encodeToBytes() const
+{
+    const auto pdu_size = getRawSize();
+    auto encodedPdu     = std::vector<uint8_t>{};
+
+    encodedPdu.reserve(pdu_size);
+
+    encodedPdu.push_back(utils::toUnderlying(Directive::Metadata));
+
+    const uint8_t secondByte =
+        (static_cast<uint8_t>(closureRequested) << 6) | utils::toUnderlying(checksumType);
+
+    encodedPdu.push_back(secondByte);
+
+    auto fileSizeBytes = utils::intToBytes(fileSize, getSizeOfFileSize());
+    utils::concatenateVectorsInplace(fileSizeBytes, encodedPdu);
+
+    encodedPdu.push_back(static_cast<uint8_t>(sourceFileName.length()));
+    encodedPdu.insert(encodedPdu.end(), sourceFileName.begin(), sourceFileName.end());
+
+    encodedPdu.push_back(static_cast<uint8_t>(destinationFileName.length()));
+    encodedPdu.insert(encodedPdu.end(), destinationFileName.begin(), destinationFileName.end());
+
+    return encodedPdu;
+}
@@ -0,0 +1,63 @@
+#include <cfdp_core/pdu_enums.hpp>
+#include <cfdp_core/pdu_exceptions.hpp>
+#include <cfdp_core/pdu_file_data.hpp>
+#include <cfdp_core/utils.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace utils     = ::cfdp::utils;
+namespace exception = ::cfdp::pdu::exception;
+
+cfdp::pdu::file_data::FileData::FileData(uint64_t offset, std::span<uint8_t const> data,
+                                         LargeFileFlag largeFileFlag)
+    : offset(offset), data(data), largeFileFlag(largeFileFlag)
+{
+    if (largeFileFlag == LargeFileFlag::SmallFile &&
+        utils::bytesNeeded(offset + data.size()) > sizeof(uint32_t))
+    {
+        throw exception::PduConstructionException("Segment exceeds small file size");
+    }
+
+    if (data.size() > max_data_size)
+    {
+        throw exception::PduConstructionException("File data does not fit in a single PDU");
+    }
+}
+
+cfdp::pdu::file_data::FileData::FileData(std::span<uint8_t const> memory,
+                                         LargeFileFlag largeFileFlag)
+    : largeFileFlag(largeFileFlag)
+{
+    if (memory.size() < getSizeOfOffset())
+    {
+        throw exception::DecodeFromBytesException("Passed memory does not contain enough bytes");
+    }
+
+    offset = utils::bytesToInt<uint64_t>(memory, 0, getSizeOfOffset());
+    data   = memory.subspan(getSizeOfOffset());
+}
+
+std::vector<uint8_t> cfdp::pdu::file_data::FileData::encodeToBytes() const
+{
+    const auto pdu_size = getRawSize();
+    auto encodedPdu     = std::vector<uint8_t>{};
+
+    encodedPdu.reserve(pdu_size);
+
+    encodeOffsetInto(encodedPdu);
+    encodedPdu.insert(encodedPdu.end(), data.begin(), data.end());
+
+    return encodedPdu;
+}
+
+void cfdp::pdu::file_data::FileData::encodeOffsetInto(std::vector<uint8_t>& out) const
+{
+    // Big endian, like every other field of a PDU.
+    for (auto shift = getSizeOfOffset() * 8; shift > 0;)
+    {
+        shift -= 8;
+        out.push_back(static_cast<uint8_t>(offset >> shift));
+    }
+}
@@ -0,0 +1,109 @@
+#include <cfdp_runtime/coroutine.hpp>
+
+#include <array>
+#include <new>
+#include <utility>
+
+namespace
+{
+using ::cfdp::runtime::coroutine::FrameAllocator;
+
+constexpr size_t num_size_classes = FrameAllocator::max_pooled_size / FrameAllocator::granularity;
+
+struct FreeFrame
+{
+    FreeFrame* next;
+};
+
+// Set once the cache of the current thread is gone. Destructors of other
+// thread locals and statics can still free frames after that, those go
+// straight to the global allocator.
+thread_local bool frameCacheDestroyed = false;
+
+// Free frames of the current thread, one list per size class.
+class FrameCache
+{
+  public:
+    FrameCache() = default;
+    ~FrameCache()
+    {
+        frameCacheDestroyed = true;
+
+        for (auto* head : heads)
+        {
+            while (head != nullptr)
+            {
+                ::operator delete(std::exchange(head, head->next));
+            }
+        }
+    }
+
+    FrameCache(const FrameCache&)            = delete;
+    FrameCache& operator=(FrameCache const&) = delete;
+    FrameCache(FrameCache&&)                 = delete;
+    FrameCache& operator=(FrameCache&&)      = delete;
+
+    [[nodiscard]] inline void* take(size_t sizeClass) noexcept
+    {
+        auto* frame = heads[sizeClass];
+
+        if (frame != nullptr)
+        {
+            heads[sizeClass] = frame->next;
+            --counts[sizeClass];
+        }
+
+        return frame;
+    }
+
+    [[nodiscard]] inline bool give(size_t sizeClass, void* frame) noexcept
+    {
+        if (counts[sizeClass] >= FrameAllocator::max_cached_frames)
+        {
+            return false;
+        }
+
+        heads[sizeClass] = ::new (frame) FreeFrame{heads[sizeClass]};
+        ++counts[sizeClass];
+
+        return true;
+    }
+
+  private:
+    std::array<FreeFrame*, num_size_classes> heads{};
+    std::array<size_t, num_size_classes> counts{};
+};
+
+thread_local FrameCache frameCache{};
+
+[[nodiscard]] constexpr size_t sizeClassOf(size_t size) noexcept
+{
+    return (size + FrameAllocator::granularity - 1) / FrameAllocator::granularity - 1;
+}
+} // namespace
+
+void* cfdp::runtime::coroutine::FrameAllocator::allocate(size_t size)
+{
+    if (size == 0 || size > max_pooled_size || frameCacheDestroyed)
+    {
+        return ::operator new(size);
+    }
+
+    const auto sizeClass = sizeClassOf(size);
+
+    if (auto* frame = frameCache.take(sizeClass))
+    {
+        return frame;
+    }
+
+    return ::operator new((sizeClass + 1) * granularity);
+}
+
+void cfdp::runtime::coroutine::FrameAllocator::deallocate(void* frame, size_t size) noexcept
+{
+    if (size == 0 || size > max_pooled_size || frameCacheDestroyed ||
+        !frameCache.give(sizeClassOf(size), frame))
+    {
+        ::operator delete(frame);
+    }
+}
@@ -0,0 +1,19 @@
+#include <cfdp_runtime/file_descriptor.hpp>
+
+#include <unistd.h>
+
+#include <cerrno>
+
+void cfdp::runtime::io::FileDescriptor::reset(int newFd) noexcept
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+    fd = newFd;
+}
+
+std::system_error cfdp::runtime::io::lastError(const char* what)
+{
+    return std::system_error{errno, std::system_category(), what};
+}
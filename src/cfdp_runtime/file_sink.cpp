@@ -0,0 +1,290 @@
+#include <cfdp_runtime/file_sink.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+using ::cfdp::runtime::io::lastError;
+
+// Mapping less than a page would only waste the rest of it.
+constexpr auto min_segment_size = size_t{4096};
+
+// Sequence of a segment named `<baseName>.<sequence>.log`.
+[[nodiscard]] std::optional<uint64_t> parseSequence(std::string_view name,
+                                                    std::string_view baseName) noexcept
+{
+    constexpr auto extension = std::string_view{".log"};
+
+    if (name.size() <= baseName.size() + 1 + extension.size() || !name.starts_with(baseName) ||
+        name[baseName.size()] != '.' || !name.ends_with(extension))
+    {
+        return std::nullopt;
+    }
+
+    name.remove_prefix(baseName.size() + 1);
+    name.remove_suffix(extension.size());
+
+    auto sequence        = uint64_t{0};
+    const auto [end, ec] = std::from_chars(name.data(), name.data() + name.size(), sequence);
+    if (ec != std::errc{} || end != name.data() + name.size())
+    {
+        return std::nullopt;
+    }
+
+    return sequence;
+}
+
+[[nodiscard]] std::vector<uint64_t> findSegments(const std::filesystem::path& directory,
+                                                 std::string_view baseName)
+{
+    auto sequences = std::vector<uint64_t>{};
+
+    for (const auto& entry : std::filesystem::directory_iterator{directory})
+    {
+        if (const auto sequence = parseSequence(entry.path().filename().native(), baseName))
+        {
+            sequences.push_back(*sequence);
+        }
+    }
+
+    std::ranges::sort(sequences);
+
+    return sequences;
+}
+
+void writeToStderr(std::string_view lines) noexcept
+{
+    std::fwrite(lines.data(), 1, lines.size(), stderr);
+}
+} // namespace
+
+cfdp::runtime::logging::MappedFileSink::MappedFileSink(FileSinkOptions options)
+    : options(std::move(options))
+{
+    this->options.segmentSize = std::max(this->options.segmentSize, min_segment_size);
+
+    std::filesystem::create_directories(this->options.directory);
+
+    const auto existing = findSegments(this->options.directory, this->options.baseName);
+    if (!existing.empty())
+    {
+        sequence = existing.back() + 1;
+    }
+
+    openSegment();
+}
+
+cfdp::runtime::logging::MappedFileSink::~MappedFileSink()
+{
+    closeSegment();
+}
+
+void cfdp::runtime::logging::MappedFileSink::write(std::string_view lines)
+{
+    if (options.maxSegmentAge.has_value() && used > 0 &&
+        Clock::now() - openedAt >= *options.maxSegmentAge)
+    {
+        if (!rotate())
+        {
+            writeToStderr(lines);
+            return;
+        }
+    }
+
+    while (!lines.empty())
+    {
+        if (mapping.empty() && !rotate())
+        {
+            writeToStderr(lines);
+            return;
+        }
+
+        const auto remaining = mapping.size() - used;
+        auto chunk           = lines.substr(0, remaining);
+
+        // Lines are not split between segments, unless a single line does
+        // not fit into an empty one.
+        if (chunk.size() < lines.size())
+        {
+            if (const auto end = chunk.rfind('\n'); end != std::string_view::npos)
+            {
+                chunk = chunk.substr(0, end + 1);
+            }
+            else if (used > 0)
+            {
+                chunk = {};
+            }
+        }
+
+        std::memcpy(mapping.data() + used, chunk.data(), chunk.size());
+        used += chunk.size();
+        lines.remove_prefix(chunk.size());
+
+        if (!lines.empty() && !rotate())
+        {
+            writeToStderr(lines);
+            return;
+        }
+    }
+
+    sync(false);
+}
+
+void cfdp::runtime::logging::MappedFileSink::flush()
+{
+    sync(true);
+}
+
+void cfdp::runtime::logging::MappedFileSink::openSegment()
+{
+    const auto next = segmentPath(sequence);
+
+    auto created = io::FileDescriptor{
+        ::open(next.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644)};
+    if (!created.isValid())
+    {
+        throw lastError("open");
+    }
+
+    // Allocating the blocks up front turns a full disk into an error here,
+    // instead of a SIGBUS while writing into the mapping.
+    if (const auto error = ::posix_fallocate(created.get(), 0,
+                                             static_cast<off_t>(options.segmentSize));
+        error != 0)
+    {
+        ::unlink(next.c_str());
+        throw std::system_error{error, std::system_category(), "posix_fallocate"};
+    }
+
+    auto* const data = ::mmap(nullptr, options.segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                              created.get(), 0);
+    if (data == MAP_FAILED) // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    {
+        const auto error = lastError("mmap");
+        ::unlink(next.c_str());
+        throw error;
+    }
+
+    ::madvise(data, options.segmentSize, MADV_SEQUENTIAL);
+
+    path     = next;
+    file     = std::move(created);
+    mapping  = {static_cast<char*>(data), options.segmentSize};
+    used     = 0;
+    synced   = 0;
+    openedAt = Clock::now();
+    syncedAt = openedAt;
+
+    removeOldSegments();
+}
+
+void cfdp::runtime::logging::MappedFileSink::closeSegment() noexcept
+{
+    if (!file.isValid())
+    {
+        return;
+    }
+
+    ::munmap(mapping.data(), mapping.size());
+    mapping = {};
+
+    // Drops the unused, zeroed tail, the written pages stay in the page
+    // cache and are written back like any other file.
+    if (::ftruncate(file.get(), static_cast<off_t>(used)) != 0)
+    {
+        std::fprintf(stderr, "could not truncate the log segment %s: %s\n", path.c_str(),
+                     std::strerror(errno));
+    }
+
+    if (options.syncInterval.has_value())
+    {
+        ::fdatasync(file.get());
+    }
+
+    file.reset();
+}
+
+bool cfdp::runtime::logging::MappedFileSink::rotate() noexcept
+{
+    closeSegment();
+    ++sequence;
+
+    try
+    {
+        openSegment();
+        return true;
+    }
+    catch (const std::exception& error)
+    {
+        std::fprintf(stderr, "could not open the log segment %s: %s\n",
+                     segmentPath(sequence).c_str(), error.what());
+        return false;
+    }
+}
+
+void cfdp::runtime::logging::MappedFileSink::removeOldSegments() noexcept
+{
+    if (options.maxSegments == 0)
+    {
+        return;
+    }
+
+    try
+    {
+        const auto existing = findSegments(options.directory, options.baseName);
+
+        const auto excess = existing.size() > options.maxSegments
+                                ? existing.size() - options.maxSegments
+                                : size_t{0};
+        for (auto i = size_t{0}; i < excess; ++i)
+        {
+            std::filesystem::remove(segmentPath(existing[i]));
+        }
+    }
+    catch (const std::exception& error)
+    {
+        std::fprintf(stderr, "could not remove old log segments: %s\n", error.what());
+    }
+}
+
+void cfdp::runtime::logging::MappedFileSink::sync(bool force) noexcept
+{
+    if (!file.isValid() || used == synced)
+    {
+        return;
+    }
+
+    const auto now = Clock::now();
+    if (!force && (!options.syncInterval.has_value() || now - syncedAt < *options.syncInterval))
+    {
+        return;
+    }
+
+    // The mapping is shared, so syncing the file writes its dirty pages too.
+    if (::fdatasync(file.get()) != 0)
+    {
+        std::fprintf(stderr, "could not sync the log segment %s: %s\n", path.c_str(),
+                     std::strerror(errno));
+        return;
+    }
+
+    synced   = used;
+    syncedAt = now;
+}
+
+auto cfdp::runtime::logging::MappedFileSink::segmentPath(uint64_t index) const
+    -> std::filesystem::path
+{
+    return options.directory / std::format("{}.{:06}.log", options.baseName, index);
+}
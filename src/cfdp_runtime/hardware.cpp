@@ -0,0 +1,138 @@
+#include <cfdp_runtime/hardware.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <climits>
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace
+{
+// From linux/mempolicy.h, to avoid depending on libnuma headers.
+constexpr int mpol_preferred = 1;
+
+constexpr std::string_view sysfs_node_dir = "/sys/devices/system/node";
+
+[[nodiscard]] std::optional<size_t> parseNumber(std::string_view text) noexcept
+{
+    auto value        = size_t{0};
+    const auto* last  = text.data() + text.size();
+    const auto result = std::from_chars(text.data(), last, value);
+
+    if (result.ec != std::errc{} || result.ptr != last)
+    {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+[[nodiscard]] std::optional<std::string> readLine(const std::string& path) noexcept
+{
+    auto file = std::ifstream{path};
+    auto line = std::string{};
+
+    if (!file || !std::getline(file, line))
+    {
+        return std::nullopt;
+    }
+
+    return line;
+}
+} // namespace
+
+auto cfdp::runtime::hardware::parseCpuList(std::string_view list) noexcept
+    -> std::optional<CpuSet>
+{
+    auto cpus = CpuSet{};
+
+    while (!list.empty() && (list.back() == '\n' || list.back() == ' '))
+    {
+        list.remove_suffix(1);
+    }
+
+    while (!list.empty())
+    {
+        const auto comma = list.find(',');
+        const auto range = list.substr(0, comma);
+        const auto dash  = range.find('-');
+
+        const auto first = parseNumber(range.substr(0, dash));
+        const auto last =
+            dash == std::string_view::npos ? first : parseNumber(range.substr(dash + 1));
+
+        if (!first.has_value() || !last.has_value() || first.value() > last.value())
+        {
+            return std::nullopt;
+        }
+
+        for (auto cpu = first.value(); cpu <= last.value(); ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+    }
+
+    return cpus;
+}
+
+auto cfdp::runtime::hardware::numaNodeCpus(size_t node) noexcept -> CpuSet
+{
+    const auto line = readLine(std::format("{}/node{}/cpulist", sysfs_node_dir, node));
+
+    if (!line.has_value())
+    {
+        return {};
+    }
+
+    return parseCpuList(line.value()).value_or(CpuSet{});
+}
+
+size_t cfdp::runtime::hardware::numNumaNodes() noexcept
+{
+    const auto line  = readLine(std::format("{}/online", sysfs_node_dir));
+    const auto nodes = line.has_value() ? parseCpuList(line.value()) : std::nullopt;
+
+    if (!nodes.has_value() || nodes->empty())
+    {
+        return 1;
+    }
+
+    return nodes->size();
+}
+
+bool cfdp::runtime::hardware::pinCurrentThread(const CpuSet& cpus) noexcept
+{
+    auto set = cpu_set_t{};
+    CPU_ZERO(&set);
+
+    for (auto cpu : cpus)
+    {
+        if (cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool cfdp::runtime::hardware::preferNumaNode(size_t node) noexcept
+{
+    constexpr auto bits_per_word = sizeof(unsigned long) * CHAR_BIT;
+
+    auto mask = std::vector<unsigned long>(node / bits_per_word + 1, 0);
+    mask[node / bits_per_word] |= 1UL << (node % bits_per_word);
+
+    // The kernel expects the number of mask bits plus one.
+    const auto maxNode = mask.size() * bits_per_word + 1;
+
+    return ::syscall(SYS_set_mempolicy, mpol_preferred, mask.data(), maxNode) == 0;
+}
@@ -1,32 +1,560 @@
 #include <cfdp_runtime/logger.hpp>
+#include <cfdp_runtime/metrics.hpp>
+#include <cfdp_runtime/spsc_queue.hpp>
 
-#include <iostream>
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace
 {
 using ::cfdp::runtime::logging::LogLevel;
+using ::cfdp::runtime::logging::LogSink;
 
-const std::unordered_map<LogLevel, std::string> coloredLevelNames{
-    {LogLevel::Trace, "\x1b[37;1m[TRACE]\x1b[0m"},
-    {LogLevel::Debug, "\x1b[34;1m[DEBUG]\x1b[0m"},
-    { LogLevel::Info, "\x1b[32;1m[INFO]\x1b[0m "},
-    { LogLevel::Warn, "\x1b[33;1m[WARN]\x1b[0m "},
-    {LogLevel::Error, "\x1b[31;1m[ERROR]\x1b[0m"},
+constexpr auto coloredLevelNames = std::array<std::string_view, 5>{
+    "\x1b[37;1m[TRACE]\x1b[0m",
+    "\x1b[34;1m[DEBUG]\x1b[0m",
+    "\x1b[32;1m[INFO]\x1b[0m ",
+    "\x1b[33;1m[WARN]\x1b[0m ",
+    "\x1b[31;1m[ERROR]\x1b[0m",
+};
+
+constexpr auto level_names = std::array<std::string_view, 5>{
+    "trace", "debug", "info", "warn", "error",
+};
+
+constexpr auto module_names =
+    std::array<std::string_view, ::cfdp::runtime::logging::num_log_modules>{
+        "general", "thread_pool", "timer", "reactor", "simulation", "sender",
+    };
+
+// The wall clock is read again after this period, so the timestamps follow
+// adjustments of the system time.
+constexpr auto calibration_period = std::chrono::seconds(1);
+
+// Records per thread, the producer waits once its ring is full.
+constexpr size_t ring_capacity = 1024;
+
+// Records formatted into a single batch, before it is written.
+constexpr size_t max_batch_records = 4096;
+
+// A record carries either a formatted message, or everything needed to
+// format it on the backend.
+struct LogRecord
+{
+    LogLevel level;
+    std::chrono::steady_clock::time_point time;
+    std::thread::id thread;
+    std::string message;
+
+    ::cfdp::runtime::logging::DeferredFormatter formatter;
+    std::string_view format;
+    std::array<std::byte, ::cfdp::runtime::logging::max_deferred_size> arguments;
+};
+
+// Turns the monotonic time of the records into wall clock timestamps. The
+// system clock is only read once per calibration period, the date itself is
+// only formatted once per second.
+class Timestamps
+{
+  public:
+    std::string_view format(std::chrono::steady_clock::time_point time)
+    {
+        if (time - anchorSteady >= calibration_period)
+        {
+            anchorSteady = std::chrono::steady_clock::now();
+            anchorSystem = std::chrono::system_clock::now();
+        }
+
+        const auto offset = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            time - anchorSteady);
+        const auto second = std::chrono::floor<std::chrono::seconds>(anchorSystem + offset);
+
+        if (second != cachedSecond || cached.empty())
+        {
+            cachedSecond = second;
+            cached.clear();
+            std::format_to(std::back_inserter(cached), "{:%d-%m-%Y %H:%M:%S}", second);
+        }
+
+        return cached;
+    }
+
+  private:
+    std::chrono::steady_clock::time_point anchorSteady{};
+    std::chrono::system_clock::time_point anchorSystem{};
+
+    std::chrono::sys_seconds cachedSecond{};
+    std::string cached{};
+};
+
+void formatRecord(const LogRecord& record, Timestamps& timestamps, std::string& out)
+{
+    std::format_to(std::back_inserter(out), "{}  {}  ThreadID({}): ",
+                   timestamps.format(record.time),
+                   coloredLevelNames[static_cast<size_t>(record.level)], record.thread);
+
+    if (record.formatter == nullptr)
+    {
+        out.append(record.message);
+    }
+    else
+    {
+        try
+        {
+            record.formatter(out, record.format, record.arguments.data());
+        }
+        catch (const std::format_error& error)
+        {
+            out.append("could not format a log message: ").append(error.what());
+        }
+    }
+
+    out.push_back('\n');
+}
+
+// Ring of a single thread, it outlives the thread until the backend has
+// drained it.
+struct Producer
+{
+    ::cfdp::runtime::atomic::SpscQueue<LogRecord, ring_capacity,
+                                       ::cfdp::runtime::atomic::WaitStrategy::Spin>
+        ring{};
+    std::atomic_bool closed{false};
+};
+
+struct ProducerHandle
+{
+    ProducerHandle()                                 = default;
+    ProducerHandle(const ProducerHandle&)            = delete;
+    ProducerHandle& operator=(ProducerHandle const&) = delete;
+    ProducerHandle(ProducerHandle&&)                 = delete;
+    ProducerHandle& operator=(ProducerHandle&&)      = delete;
+
+    ~ProducerHandle()
+    {
+        if (producer != nullptr)
+        {
+            producer->closed.store(true, std::memory_order_release);
+        }
+    }
+
+    std::shared_ptr<Producer> producer{};
+};
+
+// Ring positions a flush waits for, it is acknowledged once everything
+// pushed before the request has been popped.
+struct FlushTarget
+{
+    uint64_t ticket{0};
+    std::vector<std::pair<std::shared_ptr<Producer>, size_t>> positions{};
+};
+
+// Set once the backend is gone at exit, whatever is logged later is
+// written directly, on the calling thread.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic_bool backendDestroyed{false};
+
+class Backend
+{
+  public:
+    Backend() : sink(std::make_unique<::cfdp::runtime::logging::StdoutSink>())
+    {
+        thread = std::thread{[this]() { run(); }};
+    }
+
+    ~Backend()
+    {
+        stopping.store(true, std::memory_order_release);
+        wake();
+        thread.join();
+
+        backendDestroyed.store(true, std::memory_order_release);
+    }
+
+    Backend(const Backend&)            = delete;
+    Backend& operator=(Backend const&) = delete;
+    Backend(Backend&&)                 = delete;
+    Backend& operator=(Backend&&)      = delete;
+
+    static Backend& instance()
+    {
+        static auto backend = Backend{};
+        return backend;
+    }
+
+    void publish(LogRecord&& record) noexcept
+    {
+        auto& ring = localProducer().ring;
+
+        while (!ring.tryEmplace(std::move(record)))
+        {
+            wake();
+            std::this_thread::yield();
+        }
+
+        // Pairs with the fence in `run`, either the backend sees the record
+        // before parking, or we see it parked and wake it up.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (parked.load(std::memory_order_relaxed))
+        {
+            wake();
+        }
+    }
+
+    void flush() noexcept
+    {
+        const auto ticket = flushRequested.fetch_add(1, std::memory_order_acq_rel) + 1;
+        wake();
+
+        auto done = flushed.load(std::memory_order_acquire);
+        while (done < ticket)
+        {
+            flushed.wait(done, std::memory_order_acquire);
+            done = flushed.load(std::memory_order_acquire);
+        }
+    }
+
+    void setSink(std::unique_ptr<LogSink> newSink)
+    {
+        flush();
+
+        std::scoped_lock<std::mutex> lock{sinkMutex};
+        sink = std::move(newSink);
+    }
+
+  private:
+    Producer& localProducer()
+    {
+        thread_local auto handle = ProducerHandle{};
+
+        if (handle.producer == nullptr)
+        {
+            handle.producer = std::make_shared<Producer>();
+
+            std::scoped_lock<std::mutex> lock{producersMutex};
+            producers.push_back(handle.producer);
+        }
+
+        return *handle.producer;
+    }
+
+    void wake() noexcept
+    {
+        signal.store(true, std::memory_order_release);
+        signal.notify_one();
+    }
+
+    size_t drain(std::string& batch)
+    {
+        auto numRecords = size_t{0};
+
+        // Formatting runs without the lock, a thread registering its first
+        // ring must not wait for a whole batch.
+        {
+            std::scoped_lock<std::mutex> lock{producersMutex};
+            draining.assign(producers.begin(), producers.end());
+        }
+
+        // Every round starts at the next ring and takes at most a ring's
+        // worth from each, so threads refilling their rings as fast as they
+        // are drained cannot keep the others waiting.
+        const auto numProducers = draining.size();
+        for (auto i = size_t{0}; i < numProducers && numRecords < max_batch_records; ++i)
+        {
+            auto& producer = draining[(nextProducer + i) % numProducers];
+
+            for (auto taken = size_t{0}; taken < ring_capacity && numRecords < max_batch_records;
+                 ++taken)
+            {
+                auto record = producer->ring.tryPop();
+                if (!record.has_value())
+                {
+                    break;
+                }
+
+                formatRecord(record.value(), timestamps, batch);
+                ++numRecords;
+            }
+        }
+        nextProducer = numProducers == 0 ? 0 : (nextProducer + 1) % numProducers;
+        draining.clear();
+
+        std::scoped_lock<std::mutex> lock{producersMutex};
+
+        // The closed flag is checked first, a thread could log one more
+        // message between our drain and its exit otherwise.
+        std::erase_if(producers, [](const std::shared_ptr<Producer>& producer) {
+            return producer->closed.load(std::memory_order_acquire) &&
+                   producer->ring.sizeNow() == 0;
+        });
+
+        return numRecords;
+    }
+
+    [[nodiscard]] FlushTarget snapshot(uint64_t ticket)
+    {
+        auto target = FlushTarget{.ticket = ticket};
+
+        std::scoped_lock<std::mutex> lock{producersMutex};
+
+        target.positions.reserve(producers.size());
+        for (const auto& producer : producers)
+        {
+            target.positions.emplace_back(producer, producer->ring.pushedNow());
+        }
+
+        return target;
+    }
+
+    // Rings removed since the snapshot were empty, the shared pointers keep
+    // their final positions readable.
+    [[nodiscard]] static bool reached(const FlushTarget& target)
+    {
+        return std::ranges::all_of(target.positions, [](const auto& position) {
+            return position.first->ring.poppedNow() >= position.second;
+        });
+    }
+
+    [[nodiscard]] bool hasPending()
+    {
+        std::scoped_lock<std::mutex> lock{producersMutex};
+
+        return std::ranges::any_of(producers, [](const std::shared_ptr<Producer>& producer) {
+            return producer->ring.sizeNow() > 0;
+        });
+    }
+
+    void run() noexcept
+    {
+        auto batch        = std::string{};
+        auto pendingFlush = std::optional<FlushTarget>{};
+
+        while (true)
+        {
+            // The request is read before the rings, whatever the requesting
+            // threads logged before it is below the positions taken here.
+            const auto request = flushRequested.load(std::memory_order_acquire);
+            if (!pendingFlush.has_value() && request > flushed.load(std::memory_order_relaxed))
+            {
+                pendingFlush = snapshot(request);
+            }
+
+            const auto numRecords = drain(batch);
+
+            writtenRecords.add(numRecords);
+
+            {
+                std::scoped_lock<std::mutex> lock{sinkMutex};
+
+                if (!batch.empty())
+                {
+                    sink->write(batch);
+                    batch.clear();
+                }
+
+                if (pendingFlush.has_value() && reached(pendingFlush.value()))
+                {
+                    sink->flush();
+                    flushed.store(pendingFlush->ticket, std::memory_order_release);
+                    flushed.notify_all();
+                    pendingFlush.reset();
+                }
+            }
+
+            if (numRecords > 0)
+            {
+                continue;
+            }
+
+            if (stopping.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // Requests newer than the acknowledged one are served first.
+            if (!hasPending() && flushRequested.load(std::memory_order_acquire) ==
+                                     flushed.load(std::memory_order_relaxed))
+            {
+                signal.wait(false, std::memory_order_acquire);
+            }
+
+            signal.store(false, std::memory_order_relaxed);
+            parked.store(false, std::memory_order_relaxed);
+        }
+
+        std::scoped_lock<std::mutex> lock{sinkMutex};
+        sink->flush();
+    }
+
+    std::mutex producersMutex{};
+    std::vector<std::shared_ptr<Producer>> producers{};
+
+    // Used only by the backend thread, it keeps its capacity between drains.
+    std::vector<std::shared_ptr<Producer>> draining{};
+    size_t nextProducer{0};
+
+    Timestamps timestamps{};
+
+    std::mutex sinkMutex{};
+    std::unique_ptr<LogSink> sink;
+
+    std::atomic_bool parked{false};
+    std::atomic_bool signal{false};
+    std::atomic_bool stopping{false};
+
+    std::atomic<uint64_t> flushRequested{0};
+    std::atomic<uint64_t> flushed{0};
+
+    ::cfdp::runtime::metrics::Counter& writtenRecords =
+        ::cfdp::runtime::metrics::Registry::global().counter("cfdp_log_records_total",
+                                                             "Log records written to the sink.");
+
+    std::thread thread{};
 };
 } // namespace
 
-void cfdp::runtime::logging::Logger::log(LogLevel level, std::string msg) const noexcept
+void cfdp::runtime::logging::StdoutSink::write(std::string_view lines)
+{
+    std::fwrite(lines.data(), 1, lines.size(), stdout);
+}
+
+void cfdp::runtime::logging::StdoutSink::flush()
+{
+    std::fflush(stdout);
+}
+
+auto cfdp::runtime::logging::parseLevel(std::string_view name) noexcept -> std::optional<LogLevel>
 {
-    auto threadID  = getThreadID();
-    auto timestamp = getCurrentTimestamp();
-    auto levelName = coloredLevelNames.at(level);
+    const auto found = std::ranges::find(level_names, name);
+    if (found == level_names.end())
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<LogLevel>(found - level_names.begin());
+}
+
+auto cfdp::runtime::logging::parseModule(std::string_view name) noexcept
+    -> std::optional<LogModule>
+{
+    const auto found = std::ranges::find(module_names, name);
+    if (found == module_names.end())
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<LogModule>(found - module_names.begin());
+}
 
-    auto finalMsg = std::format("{}  {}  ThreadID({}): {}", std::move(timestamp),
-                                std::move(levelName), threadID, std::move(msg));
+bool cfdp::runtime::logging::configureLevels(std::string_view spec) noexcept
+{
+    auto valid = true;
 
+    for (const auto entry : std::views::split(spec, ','))
     {
-        std::scoped_lock<std::mutex> lock{mutex};
-        std::cout << finalMsg << std::endl;
+        const auto item      = std::string_view{entry.begin(), entry.end()};
+        const auto separator = item.find('=');
+
+        if (item.empty())
+        {
+            continue;
+        }
+
+        if (separator == std::string_view::npos)
+        {
+            const auto level = parseLevel(item);
+            if (level.has_value())
+            {
+                setLevel(level.value());
+            }
+            valid = valid && level.has_value();
+            continue;
+        }
+
+        const auto module = parseModule(item.substr(0, separator));
+        const auto level  = parseLevel(item.substr(separator + 1));
+        if (module.has_value() && level.has_value())
+        {
+            setLevel(module.value(), level.value());
+        }
+        valid = valid && module.has_value() && level.has_value();
     }
+
+    return valid;
+}
+
+void cfdp::runtime::logging::setSink(std::unique_ptr<LogSink> sink)
+{
+    Backend::instance().setSink(std::move(sink));
+}
+
+void cfdp::runtime::logging::flush() noexcept
+{
+    if (!backendDestroyed.load(std::memory_order_acquire))
+    {
+        Backend::instance().flush();
+    }
+}
+
+namespace
+{
+void publish(LogRecord&& record) noexcept
+{
+    if (backendDestroyed.load(std::memory_order_acquire))
+    {
+        auto timestamps = Timestamps{};
+        auto line       = std::string{};
+        formatRecord(record, timestamps, line);
+        cfdp::runtime::logging::StdoutSink{}.write(line);
+        return;
+    }
+
+    Backend::instance().publish(std::move(record));
+}
+} // namespace
+
+void cfdp::runtime::logging::Logger::log(LogLevel level, std::string msg) const noexcept
+{
+    publish(LogRecord{
+        .level     = level,
+        .time      = std::chrono::steady_clock::now(),
+        .thread    = std::this_thread::get_id(),
+        .message   = std::move(msg),
+        .formatter = nullptr,
+        .format    = {},
+        .arguments = {},
+    });
+}
+
+void cfdp::runtime::logging::Logger::logDeferred(
+    LogLevel level, std::string_view format, DeferredFormatter formatter,
+    std::span<const std::byte> arguments) const noexcept
+{
+    auto record = LogRecord{
+        .level     = level,
+        .time      = std::chrono::steady_clock::now(),
+        .thread    = std::this_thread::get_id(),
+        .message   = {},
+        .formatter = formatter,
+        .format    = format,
+        .arguments = {},
+    };
+
+    std::ranges::copy(arguments.first(std::min(arguments.size(), record.arguments.size())),
+                      record.arguments.begin());
+
+    publish(std::move(record));
 }
@@ -0,0 +1,414 @@
+#include <cfdp_runtime/file_descriptor.hpp>
+#include <cfdp_runtime/metrics.hpp>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+namespace
+{
+using ::cfdp::runtime::io::lastError;
+using ::cfdp::runtime::metrics::Counter;
+using ::cfdp::runtime::metrics::Gauge;
+using ::cfdp::runtime::metrics::Histogram;
+using ::cfdp::runtime::metrics::Labels;
+
+constexpr std::string_view counter_type   = "counter";
+constexpr std::string_view gauge_type     = "gauge";
+constexpr std::string_view histogram_type = "histogram";
+
+[[nodiscard]] bool isValidName(std::string_view name) noexcept
+{
+    const auto isFirst = [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+    };
+
+    return !name.empty() && isFirst(name.front()) &&
+           std::ranges::all_of(name, [&](char c) { return isFirst(c) || (c >= '0' && c <= '9'); });
+}
+
+void appendEscaped(std::string& out, std::string_view value)
+{
+    for (const auto c : value)
+    {
+        switch (c)
+        {
+        case '\\':
+            out.append("\\\\");
+            break;
+        case '"':
+            out.append("\\\"");
+            break;
+        case '\n':
+            out.append("\\n");
+            break;
+        default:
+            out.push_back(c);
+        }
+    }
+}
+
+// Renders the labels in the exposition format, like `lane="high",pool="0"`,
+// without the braces, so more labels can be appended.
+[[nodiscard]] std::string renderLabels(const Labels& labels)
+{
+    auto sorted = labels;
+    std::ranges::sort(sorted);
+
+    auto out = std::string{};
+    for (const auto& [name, value] : sorted)
+    {
+        if (!isValidName(name))
+        {
+            throw std::invalid_argument{std::format("invalid metric label name: {}", name)};
+        }
+
+        if (!out.empty())
+        {
+            out.push_back(',');
+        }
+        out.append(name).append("=\"");
+        appendEscaped(out, value);
+        out.push_back('"');
+    }
+
+    return out;
+}
+
+void appendSample(std::string& out, std::string_view name, std::string_view suffix,
+                  std::string_view labels, std::string_view extra, auto value)
+{
+    out.append(name).append(suffix);
+
+    if (!labels.empty() || !extra.empty())
+    {
+        out.push_back('{');
+        out.append(labels);
+        if (!labels.empty() && !extra.empty())
+        {
+            out.push_back(',');
+        }
+        out.append(extra);
+        out.push_back('}');
+    }
+
+    std::format_to(std::back_inserter(out), " {}\n", value);
+}
+
+void appendHistogram(std::string& out, std::string_view name, std::string_view labels,
+                     const Histogram& histogram)
+{
+    const auto snapshot = histogram.snapshot();
+
+    auto cumulative = uint64_t{0};
+    for (const auto& [upperBound, count] : snapshot.buckets)
+    {
+        cumulative += count;
+        appendSample(out, name, "_bucket", labels, std::format("le=\"{}\"", upperBound),
+                     cumulative);
+    }
+
+    appendSample(out, name, "_bucket", labels, "le=\"+Inf\"", snapshot.count);
+    appendSample(out, name, "_sum", labels, "", snapshot.sum);
+    appendSample(out, name, "_count", labels, "", snapshot.count);
+}
+
+// Writes the whole text, `write` has the signature of `::write`.
+void writeAll(int fd, std::string_view text, const char* what, auto write)
+{
+    while (!text.empty())
+    {
+        const auto written = write(fd, text.data(), text.size());
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw lastError(what);
+        }
+
+        text.remove_prefix(static_cast<size_t>(written));
+    }
+}
+} // namespace
+
+uint64_t cfdp::runtime::metrics::Counter::value() const noexcept
+{
+    auto total = uint64_t{0};
+
+    for (const auto& cell : cells)
+    {
+        total += cell.value.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+uint64_t cfdp::runtime::metrics::HistogramSnapshot::quantile(double q) const noexcept
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) *
+                                                      static_cast<double>(count)));
+
+    auto seen = uint64_t{0};
+    for (const auto& [upperBound, numValues] : buckets)
+    {
+        seen += numValues;
+        if (seen >= std::max(rank, uint64_t{1}))
+        {
+            return upperBound;
+        }
+    }
+
+    return buckets.back().first;
+}
+
+auto cfdp::runtime::metrics::Histogram::snapshot() const -> HistogramSnapshot
+{
+    auto result = HistogramSnapshot{};
+
+    for (auto index = size_t{0}; index < num_buckets; ++index)
+    {
+        auto count = uint64_t{0};
+        for (const auto& shard : shards)
+        {
+            count += shard.buckets[index].load(std::memory_order_relaxed);
+        }
+
+        if (count > 0)
+        {
+            result.buckets.emplace_back(bucketUpperBound(index), count);
+            result.count += count;
+        }
+    }
+
+    for (const auto& shard : shards)
+    {
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+auto cfdp::runtime::metrics::Registry::global() -> Registry&
+{
+    // Never destroyed, runtime objects with static lifetime can still
+    // unregister their metrics at exit.
+    static auto* const registry = new Registry{}; // NOLINT(cppcoreguidelines-owning-memory)
+    return *registry;
+}
+
+auto cfdp::runtime::metrics::Registry::counter(std::string_view name, std::string_view help,
+                                               const Labels& labels) -> Counter&
+{
+    auto& metric = findOrInsert(name, help, counter_type, labels,
+                                []() { return Metric{std::make_unique<Counter>()}; });
+    return *std::get<std::unique_ptr<Counter>>(metric);
+}
+
+auto cfdp::runtime::metrics::Registry::gauge(std::string_view name, std::string_view help,
+                                             const Labels& labels) -> Gauge&
+{
+    auto& metric = findOrInsert(name, help, gauge_type, labels,
+                                []() { return Metric{std::make_unique<Gauge>()}; });
+
+    if (!std::holds_alternative<std::unique_ptr<Gauge>>(metric))
+    {
+        throw std::invalid_argument{std::format("metric {} is a callback gauge", name)};
+    }
+    return *std::get<std::unique_ptr<Gauge>>(metric);
+}
+
+auto cfdp::runtime::metrics::Registry::histogram(std::string_view name, std::string_view help,
+                                                 const Labels& labels) -> Histogram&
+{
+    auto& metric = findOrInsert(name, help, histogram_type, labels,
+                                []() { return Metric{std::make_unique<Histogram>()}; });
+    return *std::get<std::unique_ptr<Histogram>>(metric);
+}
+
+void cfdp::runtime::metrics::Registry::callbackGauge(std::string_view name, std::string_view help,
+                                                     const Labels& labels,
+                                                     std::function<double()> read)
+{
+    // Replaces the previous callback, the new one could capture another
+    // object, like a recreated queue.
+    remove(name, labels);
+    findOrInsert(name, help, gauge_type, labels, [&read]() { return Metric{std::move(read)}; });
+}
+
+bool cfdp::runtime::metrics::Registry::remove(std::string_view name, const Labels& labels)
+{
+    return remove(name, std::string_view{renderLabels(labels)});
+}
+
+bool cfdp::runtime::metrics::Registry::remove(std::string_view name, std::string_view key) noexcept
+{
+    std::scoped_lock<std::mutex> lock{mutex};
+
+    const auto family = families.find(name);
+    if (family == families.end())
+    {
+        return false;
+    }
+
+    const auto series = family->second.series.find(key);
+    if (series == family->second.series.end())
+    {
+        return false;
+    }
+
+    family->second.series.erase(series);
+    if (family->second.series.empty())
+    {
+        families.erase(family);
+    }
+
+    return true;
+}
+
+std::string cfdp::runtime::metrics::Registry::seriesKey(const Labels& labels)
+{
+    return renderLabels(labels);
+}
+
+auto cfdp::runtime::metrics::Registry::findOrInsert(std::string_view name, std::string_view help,
+                                                    std::string_view type, const Labels& labels,
+                                                    const std::function<Metric()>& create)
+    -> Metric&
+{
+    if (!isValidName(name))
+    {
+        throw std::invalid_argument{std::format("invalid metric name: {}", name)};
+    }
+
+    auto key = renderLabels(labels);
+
+    std::scoped_lock<std::mutex> lock{mutex};
+
+    auto family = families.find(name);
+    if (family == families.end())
+    {
+        auto created = Family{.help = std::string{help}, .type = type};
+        family       = families.emplace(std::string{name}, std::move(created)).first;
+    }
+    else if (family->second.type != type)
+    {
+        throw std::invalid_argument{
+            std::format("metric {} is already registered as a {}", name, family->second.type)};
+    }
+
+    auto series = family->second.series.find(key);
+    if (series == family->second.series.end())
+    {
+        series = family->second.series.emplace(std::move(key), create()).first;
+    }
+
+    return series->second;
+}
+
+std::string cfdp::runtime::metrics::Registry::exportText() const
+{
+    auto out = std::string{};
+
+    std::scoped_lock<std::mutex> lock{mutex};
+
+    for (const auto& [name, family] : families)
+    {
+        std::format_to(std::back_inserter(out), "# HELP {} ", name);
+        appendEscaped(out, family.help);
+        std::format_to(std::back_inserter(out), "\n# TYPE {} {}\n", name, family.type);
+
+        for (const auto& [labels, metric] : family.series)
+        {
+            std::visit(
+                [&](const auto& value) {
+                    using Type = std::remove_cvref_t<decltype(value)>;
+
+                    if constexpr (std::is_same_v<Type, std::unique_ptr<Histogram>>)
+                    {
+                        appendHistogram(out, name, labels, *value);
+                    }
+                    else if constexpr (std::is_same_v<Type, std::function<double()>>)
+                    {
+                        appendSample(out, name, "", labels, "", value ? value() : 0.0);
+                    }
+                    else
+                    {
+                        appendSample(out, name, "", labels, "", value->value());
+                    }
+                },
+                metric);
+        }
+    }
+
+    return out;
+}
+
+void cfdp::runtime::metrics::Registry::exportToFile(const std::filesystem::path& path) const
+{
+    const auto text      = exportText();
+    const auto temporary = std::filesystem::path{path}.concat(".tmp");
+
+    {
+        auto file = io::FileDescriptor{
+            ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+        if (!file.isValid())
+        {
+            throw lastError("open");
+        }
+
+        writeAll(file.get(), text, "write", ::write);
+    }
+
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        throw lastError("rename");
+    }
+}
+
+void cfdp::runtime::metrics::Registry::exportToSocket(const std::filesystem::path& path) const
+{
+    auto address       = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+
+    const auto& native = path.native();
+    if (native.size() >= sizeof(address.sun_path))
+    {
+        throw std::system_error{std::make_error_code(std::errc::filename_too_long), "socket"};
+    }
+    std::ranges::copy(native, std::begin(address.sun_path));
+
+    auto socket = io::FileDescriptor{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (!socket.isValid())
+    {
+        throw lastError("socket");
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (::connect(socket.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        throw lastError("connect");
+    }
+
+    // Without MSG_NOSIGNAL an agent going away would kill us with SIGPIPE.
+    writeAll(socket.get(), exportText(), "send", [](int fd, const char* data, size_t size) {
+        return ::send(fd, data, size, MSG_NOSIGNAL);
+    });
+}
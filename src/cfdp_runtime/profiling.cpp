@@ -0,0 +1,128 @@
+#include <cfdp_runtime/profiling.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+using ::cfdp::runtime::metrics::Histogram;
+
+constexpr auto calibration_period = std::chrono::milliseconds{10};
+
+class Profiler
+{
+  public:
+    static Profiler& instance()
+    {
+        // Never destroyed, the report is written by an exit handler.
+        static auto* const profiler = new Profiler{}; // NOLINT(cppcoreguidelines-owning-memory)
+        return *profiler;
+    }
+
+    Histogram& site(const char* name)
+    {
+        std::scoped_lock<std::mutex> lock{mutex};
+
+        if (const auto found = sites.find(name); found != sites.end())
+        {
+            return *found->second;
+        }
+
+        auto& histogram = ::cfdp::runtime::metrics::Registry::global().histogram(
+            "cfdp_profile_scope_cycles", "Counter ticks spent in profiled scopes.",
+            {{"scope", name}});
+        sites.emplace(name, &histogram);
+
+        if (!reportAtExit)
+        {
+            std::atexit(writeReport);
+            reportAtExit = true;
+        }
+
+        return histogram;
+    }
+
+    std::string report()
+    {
+        const auto nanos   = ::cfdp::runtime::profiling::nanosPerCycle();
+        const auto toNanos = [nanos](uint64_t cycles) {
+            return std::llround(static_cast<double>(cycles) * nanos);
+        };
+
+        auto out = std::format("{:<40}{:>12}{:>12}{:>12}{:>12}\n", "scope", "runs", "p50 ns",
+                               "p99 ns", "max ns");
+
+        std::scoped_lock<std::mutex> lock{mutex};
+
+        for (const auto& [name, histogram] : sites)
+        {
+            const auto snapshot = histogram->snapshot();
+
+            std::format_to(std::back_inserter(out), "{:<40}{:>12}{:>12}{:>12}{:>12}\n", name,
+                           snapshot.count, toNanos(snapshot.quantile(0.5)),
+                           toNanos(snapshot.quantile(0.99)), toNanos(snapshot.quantile(1.0)));
+        }
+
+        return out;
+    }
+
+  private:
+    Profiler() = default;
+
+    static void writeReport()
+    {
+        const auto text = instance().report();
+        std::fwrite(text.data(), 1, text.size(), stderr);
+    }
+
+    std::mutex mutex{};
+    std::map<std::string, Histogram*, std::less<>> sites{};
+    bool reportAtExit{false};
+};
+
+[[nodiscard]] double calibrate() noexcept
+{
+    using std::chrono::steady_clock;
+
+    const auto startTime   = steady_clock::now();
+    const auto startCycles = ::cfdp::runtime::profiling::readCyclesOrdered();
+
+    // The counter ticks at a constant rate, so the thread does not have to
+    // stay on the CPU meanwhile.
+    std::this_thread::sleep_for(calibration_period);
+
+    const auto endCycles = ::cfdp::runtime::profiling::readCyclesOrdered();
+    const auto endTime   = steady_clock::now();
+
+    if (endCycles <= startCycles)
+    {
+        return 1.0;
+    }
+
+    const auto nanos = std::chrono::duration<double, std::nano>{endTime - startTime}.count();
+    return nanos / static_cast<double>(endCycles - startCycles);
+}
+} // namespace
+
+double cfdp::runtime::profiling::nanosPerCycle() noexcept
+{
+    static const auto nanos = calibrate();
+    return nanos;
+}
+
+auto cfdp::runtime::profiling::site(const char* name) -> metrics::Histogram&
+{
+    return Profiler::instance().site(name);
+}
+
+std::string cfdp::runtime::profiling::report()
+{
+    return Profiler::instance().report();
+}
@@ -0,0 +1,491 @@
+#include <cfdp_runtime/logger.hpp>
+#include <cfdp_runtime/metrics.hpp>
+#include <cfdp_runtime/reactor.hpp>
+#include <cfdp_runtime/tracing.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <span>
+#include <system_error>
+
+namespace
+{
+[[nodiscard]] cfdp::runtime::metrics::Counter& dispatchedEvents()
+{
+    static auto& counter = cfdp::runtime::metrics::Registry::global().counter(
+        "cfdp_reactor_events_total", "Readiness events dispatched by the reactors.");
+    return counter;
+}
+
+[[nodiscard]] uint64_t makeKey(int fd, uint32_t generation) noexcept
+{
+    return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+}
+
+// Reads the counter of a timerfd or an eventfd, so it can trigger again.
+void drainCounter(int fd) noexcept
+{
+    auto counter = uint64_t{0};
+    while (::read(fd, &counter, sizeof(counter)) == sizeof(counter))
+    {
+    }
+}
+
+[[nodiscard]] timespec toTimespec(std::chrono::nanoseconds duration) noexcept
+{
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
+
+    return timespec{
+        .tv_sec  = static_cast<time_t>(seconds.count()),
+        .tv_nsec = static_cast<long>((duration - seconds).count()),
+    };
+}
+} // namespace
+
+cfdp::runtime::io::Reactor::Reactor(thread_pool::ThreadPool& pool)
+    : pool(pool), poller(std::make_shared<Poller>())
+{
+    poller->epoll.reset(::epoll_create1(EPOLL_CLOEXEC));
+    if (!poller->epoll.isValid())
+    {
+        throw lastError("epoll_create1");
+    }
+
+    wakeup.reset(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+    if (!wakeup.isValid())
+    {
+        throw lastError("eventfd");
+    }
+
+    auto event = epoll_event{
+        .events = EPOLLIN | EPOLLET,
+        .data   = {.u64 = makeKey(wakeup.get(), 0)},
+    };
+    if (::epoll_ctl(poller->epoll.get(), EPOLL_CTL_ADD, wakeup.get(), &event) != 0)
+    {
+        throw lastError("epoll_ctl");
+    }
+
+    logging::trace<log_module>("creating a reactor object, epoll fd: {}", poller->epoll.get());
+
+    thread = std::thread{[this]() { run(); }};
+}
+
+cfdp::runtime::io::Reactor::~Reactor()
+{
+    stop();
+}
+
+int cfdp::runtime::io::Reactor::watch(FileDescriptor&& fd, uint32_t events, Handler&& handler,
+                                      Dispatch dispatch)
+{
+    const auto number = fd.get();
+
+    return add(Registration{
+        .owned      = std::move(fd),
+        .fd         = number,
+        .generation = 0,
+        .events     = events,
+        .kind       = Kind::Descriptor,
+        .dispatch   = dispatch,
+        .once       = false,
+        .inFlight   = false,
+        .handler    = std::move(handler),
+    });
+}
+
+void cfdp::runtime::io::Reactor::watchOnce(int fd, uint32_t events, Handler&& handler,
+                                           Dispatch dispatch)
+{
+    add(Registration{
+        .owned      = FileDescriptor{},
+        .fd         = fd,
+        .generation = 0,
+        .events     = events,
+        .kind       = Kind::Descriptor,
+        .dispatch   = dispatch,
+        .once       = true,
+        .inFlight   = false,
+        .handler    = std::move(handler),
+    });
+}
+
+int cfdp::runtime::io::Reactor::addTimer(std::chrono::nanoseconds initial,
+                                         std::chrono::nanoseconds interval, Handler&& handler,
+                                         Dispatch dispatch)
+{
+    auto timer = FileDescriptor{::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)};
+    if (!timer.isValid())
+    {
+        throw lastError("timerfd_create");
+    }
+
+    // A zero initial expiration would disarm the timer instead.
+    const auto spec = itimerspec{
+        .it_interval = toTimespec(interval),
+        .it_value    = toTimespec(std::max(initial, std::chrono::nanoseconds{1})),
+    };
+
+    if (::timerfd_settime(timer.get(), 0, &spec, nullptr) != 0)
+    {
+        throw lastError("timerfd_settime");
+    }
+
+    const auto number = timer.get();
+
+    return add(Registration{
+        .owned      = std::move(timer),
+        .fd         = number,
+        .generation = 0,
+        .events     = readable,
+        .kind       = Kind::Timer,
+        .dispatch   = dispatch,
+        .once       = false,
+        .inFlight   = false,
+        .handler    = std::move(handler),
+    });
+}
+
+int cfdp::runtime::io::Reactor::addEvent(Handler&& handler, Dispatch dispatch)
+{
+    auto event = FileDescriptor{::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)};
+    if (!event.isValid())
+    {
+        throw lastError("eventfd");
+    }
+
+    const auto number = event.get();
+
+    return add(Registration{
+        .owned      = std::move(event),
+        .fd         = number,
+        .generation = 0,
+        .events     = readable,
+        .kind       = Kind::Event,
+        .dispatch   = dispatch,
+        .once       = false,
+        .inFlight   = false,
+        .handler    = std::move(handler),
+    });
+}
+
+void cfdp::runtime::io::Reactor::signal(int eventFd) noexcept
+{
+    const auto increment = uint64_t{1};
+
+    if (::write(eventFd, &increment, sizeof(increment)) != sizeof(increment))
+    {
+        logging::error<log_module>("could not signal eventfd {}: {}", eventFd,
+                                   std::strerror(errno));
+    }
+}
+
+bool cfdp::runtime::io::Reactor::modify(int fd, uint32_t events) noexcept
+{
+    std::scoped_lock<std::mutex> lock{poller->mutex};
+
+    const auto found = poller->registrations.find(fd);
+    if (found == poller->registrations.end())
+    {
+        return false;
+    }
+
+    found->second->events = events;
+
+    // A pool handler still running rearms the descriptor once it returns,
+    // with the new events.
+    if (!found->second->inFlight)
+    {
+        poller->rearm(*found->second);
+    }
+
+    return true;
+}
+
+bool cfdp::runtime::io::Reactor::remove(int fd) noexcept
+{
+    auto removed = std::shared_ptr<Registration>{};
+
+    {
+        std::scoped_lock<std::mutex> lock{poller->mutex};
+
+        const auto found = poller->registrations.find(fd);
+        if (found == poller->registrations.end())
+        {
+            return false;
+        }
+
+        ::epoll_ctl(poller->epoll.get(), EPOLL_CTL_DEL, fd, nullptr);
+
+        removed = std::move(found->second);
+        poller->registrations.erase(found);
+    }
+
+    // An owned descriptor is closed here, unless a handler still runs.
+    return true;
+}
+
+void cfdp::runtime::io::Reactor::post(thread_pool::Task&& task) noexcept
+{
+    {
+        std::scoped_lock<std::mutex> lock{postedMutex};
+        posted.push_back(std::move(task));
+    }
+    signal(wakeup.get());
+}
+
+void cfdp::runtime::io::Reactor::stop() noexcept
+{
+    if (!stopped.exchange(true))
+    {
+        logging::trace<log_module>("stopping a reactor object, epoll fd: {}",
+                                   poller->epoll.get());
+        signal(wakeup.get());
+    }
+
+    // Called from a handler or a posted task, the reactor thread finishes
+    // the current round and exits, the next call from another thread, at
+    // the latest the destructor, joins it.
+    if (std::this_thread::get_id() == thread.get_id())
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock<std::mutex> lock{stopMutex};
+
+        if (!thread.joinable())
+        {
+            return;
+        }
+        thread.join();
+    }
+
+    auto registrations = decltype(poller->registrations){};
+
+    {
+        std::scoped_lock<std::mutex> lock{poller->mutex};
+        registrations.swap(poller->registrations);
+    }
+}
+
+size_t cfdp::runtime::io::Reactor::sizeNow() const noexcept
+{
+    std::scoped_lock<std::mutex> lock{poller->mutex};
+    return poller->registrations.size();
+}
+
+int cfdp::runtime::io::Reactor::add(Registration&& registration)
+{
+    auto shared = std::make_shared<Registration>(std::move(registration));
+
+    std::scoped_lock<std::mutex> lock{poller->mutex};
+
+    // Generation 0 is reserved for the wakeup eventfd.
+    shared->generation = ++poller->nextGeneration;
+
+    auto flags = shared->events | EPOLLET;
+    if (shared->once || shared->dispatch == Dispatch::Pool)
+    {
+        flags |= EPOLLONESHOT;
+    }
+
+    auto event = epoll_event{
+        .events = flags,
+        .data   = {.u64 = makeKey(shared->fd, shared->generation)},
+    };
+    if (::epoll_ctl(poller->epoll.get(), EPOLL_CTL_ADD, shared->fd, &event) != 0)
+    {
+        throw lastError("epoll_ctl");
+    }
+
+    const auto fd = shared->fd;
+    poller->registrations.insert_or_assign(fd, std::move(shared));
+
+    return fd;
+}
+
+void cfdp::runtime::io::Reactor::Poller::rearm(const Registration& registration) noexcept
+{
+    // Has to be called with the mutex held, the registration could be gone otherwise.
+    auto flags = registration.events | EPOLLET;
+    if (registration.once || registration.dispatch == Dispatch::Pool)
+    {
+        flags |= EPOLLONESHOT;
+    }
+
+    auto event = epoll_event{
+        .events = flags,
+        .data   = {.u64 = makeKey(registration.fd, registration.generation)},
+    };
+
+    if (::epoll_ctl(epoll.get(), EPOLL_CTL_MOD, registration.fd, &event) != 0)
+    {
+        logging::warn<log_module>("could not rearm fd {}: {}", registration.fd,
+                                  std::strerror(errno));
+    }
+}
+
+void cfdp::runtime::io::Reactor::dispatch(std::shared_ptr<Registration>&& registration,
+                                          uint32_t events) noexcept
+{
+    if (registration->kind != Kind::Descriptor)
+    {
+        drainCounter(registration->fd);
+    }
+
+    if (registration->dispatch == Dispatch::Inline)
+    {
+        try
+        {
+            registration->handler(events);
+        }
+        catch (const std::exception& error)
+        {
+            logging::error<log_module>("reactor handler of fd {} failed: {}", registration->fd,
+                                       error.what());
+        }
+        catch (...)
+        {
+            logging::error<log_module>("reactor handler of fd {} failed", registration->fd);
+        }
+        return;
+    }
+
+    pool.post([poller = poller, registration = std::move(registration), events]() mutable {
+        try
+        {
+            registration->handler(events);
+        }
+        catch (const std::exception& error)
+        {
+            logging::error<log_module>("reactor handler of fd {} failed: {}", registration->fd,
+                                       error.what());
+        }
+        catch (...)
+        {
+            logging::error<log_module>("reactor handler of fd {} failed", registration->fd);
+        }
+
+        if (registration->once)
+        {
+            return;
+        }
+
+        std::scoped_lock<std::mutex> lock{poller->mutex};
+
+        registration->inFlight = false;
+
+        // The descriptor could have been removed while the handler was running.
+        const auto found = poller->registrations.find(registration->fd);
+        if (found != poller->registrations.end() && found->second == registration)
+        {
+            poller->rearm(*registration);
+        }
+    });
+}
+
+void cfdp::runtime::io::Reactor::runPosted() noexcept
+{
+    auto tasks = std::vector<thread_pool::Task>{};
+
+    {
+        std::scoped_lock<std::mutex> lock{postedMutex};
+        tasks.swap(posted);
+    }
+
+    for (auto& task : tasks)
+    {
+        task();
+    }
+}
+
+void cfdp::runtime::io::Reactor::run() noexcept
+{
+    tracing::setThreadName("cfdp reactor");
+
+    auto events = std::array<epoll_event, max_events>{};
+    auto ready  = std::vector<std::pair<std::shared_ptr<Registration>, uint32_t>>{};
+
+    while (!stopped.load(std::memory_order_acquire))
+    {
+        const auto count =
+            ::epoll_wait(poller->epoll.get(), events.data(), static_cast<int>(events.size()), -1);
+
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            logging::error<log_module>("reactor could not wait for events: {}",
+                                       std::strerror(errno));
+            return;
+        }
+
+        {
+            std::scoped_lock<std::mutex> lock{poller->mutex};
+
+            for (const auto& event : std::span{events.data(), static_cast<size_t>(count)})
+            {
+                const auto fd         = static_cast<int>(static_cast<uint32_t>(event.data.u64));
+                const auto generation = static_cast<uint32_t>(event.data.u64 >> 32);
+
+                if (fd == wakeup.get())
+                {
+                    drainCounter(fd);
+                    continue;
+                }
+
+                const auto found = poller->registrations.find(fd);
+                if (found == poller->registrations.end() || found->second->generation != generation)
+                {
+                    continue;
+                }
+
+                if (found->second->once)
+                {
+                    ::epoll_ctl(poller->epoll.get(), EPOLL_CTL_DEL, fd, nullptr);
+                    ready.emplace_back(std::move(found->second), event.events);
+                    poller->registrations.erase(found);
+                }
+                else if (found->second->dispatch == Dispatch::Pool)
+                {
+                    // An edge reported before the running handler rearmed
+                    // the descriptor is picked up by that rearm.
+                    if (found->second->inFlight)
+                    {
+                        continue;
+                    }
+
+                    found->second->inFlight = true;
+                    ready.emplace_back(found->second, event.events);
+                }
+                else
+                {
+                    ready.emplace_back(found->second, event.events);
+                }
+            }
+        }
+
+        dispatchedEvents().add(ready.size());
+
+        const auto span =
+            tracing::Span{"dispatch", "reactor", "events", static_cast<int64_t>(ready.size())};
+
+        for (auto& [registration, occurred] : ready)
+        {
+            dispatch(std::move(registration), occurred);
+        }
+        ready.clear();
+
+        runPosted();
+    }
+}
@@ -0,0 +1,500 @@
+#include <cfdp_core/checksum.hpp>
+#include <cfdp_core/pdu_directive.hpp>
+#include <cfdp_core/pdu_enums.hpp>
+#include <cfdp_core/pdu_file_data.hpp>
+#include <cfdp_core/pdu_header.hpp>
+#include <cfdp_core/utils.hpp>
+
+#include <cfdp_runtime/logger.hpp>
+#include <cfdp_runtime/metrics.hpp>
+#include <cfdp_runtime/profiling.hpp>
+#include <cfdp_runtime/sender.hpp>
+#include <cfdp_runtime/tracing.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <exception>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+namespace directive = ::cfdp::pdu::directive;
+namespace header    = ::cfdp::pdu::header;
+namespace logging   = ::cfdp::runtime::logging;
+namespace metrics   = ::cfdp::runtime::metrics;
+namespace tracing   = ::cfdp::runtime::tracing;
+
+using ::cfdp::checksum::ModularChecksum;
+using ::cfdp::pdu::file_data::FileData;
+using ::cfdp::runtime::future::Promise;
+using ::cfdp::runtime::io::FileDescriptor;
+using ::cfdp::runtime::io::lastError;
+using ::cfdp::runtime::io::OutgoingPdu;
+using ::cfdp::runtime::io::Transport;
+using ::cfdp::runtime::sender::SenderOptions;
+using ::cfdp::runtime::sender::TransferSummary;
+using ::cfdp::runtime::thread_pool::Priority;
+using ::cfdp::runtime::thread_pool::ThreadPool;
+
+constexpr auto log_module = logging::LogModule::Sender;
+
+// Length of a file name in the Metadata PDU is a single byte.
+constexpr size_t max_file_name_size = UINT8_MAX;
+
+// What a File Data PDU adds to its segment at most: the fixed part of the
+// header, entity IDs and sequence number of 8 bytes each, a 64 bit offset.
+constexpr size_t max_file_data_overhead =
+    sizeof(uint32_t) + (3 * sizeof(uint64_t)) + sizeof(uint64_t);
+
+struct SenderMetrics
+{
+    metrics::Counter& metadataPdus;
+    metrics::Counter& fileDataPdus;
+    metrics::Counter& eofPdus;
+    metrics::Counter& fileBytes;
+};
+
+[[nodiscard]] const SenderMetrics& senderMetrics()
+{
+    static const auto instance = [] {
+        auto& registry  = metrics::Registry::global();
+        const auto pdus = [&registry](const char* type) -> metrics::Counter& {
+            return registry.counter("cfdp_sender_pdus_total",
+                                    "PDUs handed over to the transport by senders.",
+                                    {{"type", type}});
+        };
+
+        return SenderMetrics{
+            .metadataPdus = pdus("metadata"),
+            .fileDataPdus = pdus("file_data"),
+            .eofPdus      = pdus("eof"),
+            .fileBytes    = registry.counter("cfdp_sender_file_bytes_total",
+                                             "File data handed over to the transport by senders."),
+        };
+    }();
+    return instance;
+}
+
+struct TransactionId
+{
+    uint64_t sourceEntity;
+    uint64_t sequenceNumber;
+    uint64_t destinationEntity;
+};
+
+/**
+ * A single transfer, owned by the tasks of its pipeline.
+ *
+ * Step `k` transmits chunk `k` from one buffer while chunk `k + 1` is read
+ * into the other one. Whichever of the two tasks finishes last starts the
+ * next step, so the buffers are never used by two tasks at once. Bulk file
+ * data goes through the low priority lane, so it does not delay the more
+ * urgent work sharing the pool.
+ */
+class Transaction : public std::enable_shared_from_this<Transaction>
+{
+  public:
+    Transaction(ThreadPool& pool, Transport& transport, const SenderOptions& options,
+                TransactionId id, FileDescriptor&& file, uint64_t fileSize,
+                std::string&& sourceFileName, std::string&& destinationFileName)
+        : pool(pool), transport(transport), id(id), file(std::move(file)), fileSize(fileSize),
+          segmentSize(options.segmentSize),
+          readSize(options.readSize / options.segmentSize * options.segmentSize),
+          numChunks((fileSize + readSize - 1) / readSize),
+          largeFileFlag(fileSize > UINT32_MAX ? header::LargeFileFlag::LargeFile
+                                              : header::LargeFileFlag::SmallFile),
+          sourceFileName(std::move(sourceFileName)),
+          destinationFileName(std::move(destinationFileName))
+    {}
+
+    [[nodiscard]] inline auto getFuture() { return promise.getFuture(); }
+
+    void start()
+    {
+        pool.post(Priority::Low, [self = shared_from_this()] {
+            self->run([&self] {
+                self->transmitMetadata();
+                if (self->numChunks > 0)
+                {
+                    self->readChunk(0);
+                }
+            });
+            self->arrive(0);
+        });
+    }
+
+  private:
+    void step(uint64_t chunk)
+    {
+        if (chunk == numChunks)
+        {
+            finish();
+            return;
+        }
+
+        pending.store(2, std::memory_order_relaxed);
+
+        if (chunk + 1 < numChunks)
+        {
+            pool.post(Priority::Low, [self = shared_from_this(), chunk] {
+                self->run([&self, chunk] { self->readChunk(chunk + 1); });
+                self->arrive(chunk + 1);
+            });
+        }
+        else
+        {
+            arrive(chunk + 1);
+        }
+
+        pool.post(Priority::Low, [self = shared_from_this(), chunk] {
+            self->run([&self, chunk] { self->transmitChunk(chunk); });
+            self->arrive(chunk + 1);
+        });
+    }
+
+    // Called by both tasks of a step, the last one continues the pipeline.
+    void arrive(uint64_t nextChunk)
+    {
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+
+        if (failed.load(std::memory_order_relaxed))
+        {
+            logging::error<log_module>("transaction {} failed after {} of {} chunk(s)",
+                                       id.sequenceNumber, nextChunk, numChunks);
+            promise.setException(error);
+            return;
+        }
+
+        step(nextChunk);
+    }
+
+    template <class Stage>
+    void run(Stage&& stage) noexcept
+    {
+        try
+        {
+            stage();
+        }
+        catch (...)
+        {
+            if (!failed.exchange(true, std::memory_order_relaxed))
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    [[nodiscard]] std::vector<uint8_t>& buffer(uint64_t chunk) noexcept
+    {
+        return buffers[chunk % buffers.size()];
+    }
+
+    [[nodiscard]] uint64_t chunkSize(uint64_t chunk) const noexcept
+    {
+        return std::min<uint64_t>(readSize, fileSize - (chunk * readSize));
+    }
+
+    void readChunk(uint64_t chunk)
+    {
+        const auto span = tracing::Span{"read", "sender", "chunk", static_cast<int64_t>(chunk)};
+
+        auto& data = buffer(chunk);
+        data.resize(chunkSize(chunk));
+
+        auto done = size_t{0};
+        while (done < data.size())
+        {
+            const auto offset = static_cast<off_t>((chunk * readSize) + done);
+            const auto got    = ::pread(file.get(), data.data() + done, data.size() - done, offset);
+
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (got < 0)
+            {
+                throw lastError("pread");
+            }
+            if (got == 0)
+            {
+                throw std::system_error{std::make_error_code(std::errc::io_error),
+                                        "file shrank while being sent"};
+            }
+            done += static_cast<size_t>(got);
+        }
+    }
+
+    void transmitChunk(uint64_t chunk)
+    {
+        const auto span =
+            tracing::Span{"transmit", "sender", "chunk", static_cast<int64_t>(chunk)};
+
+        const auto& data       = buffer(chunk);
+        const auto chunkOffset = chunk * readSize;
+
+        {
+            CFDP_PROFILE_SCOPE("sender.checksum");
+            checksum.update(chunkOffset, data);
+        }
+
+        const auto numSegments = (data.size() + segmentSize - 1) / segmentSize;
+        const auto segmentAt   = [this, &data](size_t index) {
+            const auto begin = index * segmentSize;
+            return std::span<uint8_t const>{data}.subspan(
+                begin, std::min(segmentSize, data.size() - begin));
+        };
+
+        {
+            CFDP_PROFILE_SCOPE("sender.encode_file_data");
+
+            // Every segment but the last one of the file is full, so they
+            // share the header. Only the headers and offsets are encoded,
+            // the segments are sent straight from the read buffer.
+            if (fullHeader.empty())
+            {
+                fullHeader = encodeHeader(header::PduType::FileData,
+                                          FileData{0, {}, largeFileFlag}.getRawSize() +
+                                              segmentSize);
+            }
+
+            headers.clear();
+            for (auto i = size_t{0}; i < numSegments; ++i)
+            {
+                const auto offset  = chunkOffset + (i * segmentSize);
+                const auto segment = segmentAt(i);
+                const auto pdu     = FileData{offset, segment, largeFileFlag};
+
+                if (segment.size() == segmentSize)
+                {
+                    headers.insert(headers.end(), fullHeader.begin(), fullHeader.end());
+                }
+                else
+                {
+                    const auto shortHeader =
+                        encodeHeader(header::PduType::FileData, pdu.getRawSize());
+                    headers.insert(headers.end(), shortHeader.begin(), shortHeader.end());
+                }
+                pdu.encodeOffsetInto(headers);
+            }
+
+            // The headers are all of the same size, their buffer is only
+            // referred to once it stopped growing.
+            const auto encoded    = std::span<uint8_t const>{headers};
+            const auto headerSize = encoded.size() / numSegments;
+
+            batch.resize(numSegments);
+            for (auto i = size_t{0}; i < numSegments; ++i)
+            {
+                batch[i] = OutgoingPdu{
+                    .header  = encoded.subspan(i * headerSize, headerSize),
+                    .payload = segmentAt(i),
+                };
+            }
+        }
+
+        transport.transmit(batch);
+
+        numFileDataPdus += numSegments;
+        senderMetrics().fileDataPdus.add(numSegments);
+        senderMetrics().fileBytes.add(data.size());
+    }
+
+    void transmitMetadata()
+    {
+        const auto metadata =
+            directive::Metadata{false,        directive::ChecksumType::Modular,
+                                fileSize,     largeFileFlag,
+                                std::string{sourceFileName},
+                                std::string{destinationFileName}};
+
+        transmitDirective(metadata.getRawSize(), metadata.encodeToBytes());
+        tracing::instant("metadata", "sender", "transaction",
+                         static_cast<int64_t>(id.sequenceNumber));
+        senderMetrics().metadataPdus.add();
+    }
+
+    void finish() noexcept
+    {
+        run([this] {
+            const auto eof = directive::EndOfFile{directive::Condition::NoError,
+                                                  checksum.value(), fileSize, largeFileFlag};
+
+            transmitDirective(eof.getRawSize(), eof.encodeToBytes());
+            tracing::instant("eof", "sender", "transaction",
+                             static_cast<int64_t>(id.sequenceNumber));
+            senderMetrics().eofPdus.add();
+        });
+
+        if (failed.load(std::memory_order_relaxed))
+        {
+            logging::error<log_module>("transaction {} could not send the EOF PDU",
+                                       id.sequenceNumber);
+            promise.setException(error);
+            return;
+        }
+
+        logging::trace<log_module>("transaction {} sent {} byte(s) in {} file data PDU(s)",
+                                   id.sequenceNumber, fileSize, numFileDataPdus);
+
+        promise.setValue(TransferSummary{
+            .transaction  = id.sequenceNumber,
+            .fileSize     = fileSize,
+            .checksum     = checksum.value(),
+            .fileDataPdus = numFileDataPdus,
+        });
+    }
+
+    void transmitDirective(uint16_t dataFieldLength, std::vector<uint8_t>&& body)
+    {
+        headers = encodeHeader(header::PduType::FileDirective, dataFieldLength);
+
+        batch.resize(1);
+        batch[0] = OutgoingPdu{.header = headers, .payload = body};
+
+        transport.transmit(batch);
+    }
+
+    [[nodiscard]] std::vector<uint8_t> encodeHeader(header::PduType type,
+                                                    size_t dataFieldLength) const
+    {
+        const auto lengthOfEntityIDs = std::max(cfdp::utils::bytesNeeded(id.sourceEntity),
+                                                cfdp::utils::bytesNeeded(id.destinationEntity));
+
+        return header::PduHeader{1,
+                                 type,
+                                 header::Direction::TowardsReceiver,
+                                 header::TransmissionMode::Unacknowledged,
+                                 header::CrcFlag::CrcNotPresent,
+                                 largeFileFlag,
+                                 static_cast<uint16_t>(dataFieldLength),
+                                 header::SegmentationControl::BoundariesNotPreserved,
+                                 static_cast<uint8_t>(lengthOfEntityIDs),
+                                 header::SegmentMetadataFlag::NotPresent,
+                                 static_cast<uint8_t>(cfdp::utils::bytesNeeded(id.sequenceNumber)),
+                                 id.sourceEntity,
+                                 id.sequenceNumber,
+                                 id.destinationEntity}
+            .encodeToBytes();
+    }
+
+    ThreadPool& pool;
+    Transport& transport;
+    TransactionId id;
+    FileDescriptor file;
+
+    uint64_t fileSize;
+    size_t segmentSize;
+    size_t readSize;
+    uint64_t numChunks;
+    header::LargeFileFlag largeFileFlag;
+
+    std::string sourceFileName;
+    std::string destinationFileName;
+
+    // The stages of a transaction never overlap, apart from the read of the
+    // next chunk, which only touches its own buffer.
+    std::array<std::vector<uint8_t>, 2> buffers{};
+    std::vector<uint8_t> fullHeader{};
+    std::vector<uint8_t> headers{};
+    std::vector<OutgoingPdu> batch{};
+    ModularChecksum checksum{};
+    uint64_t numFileDataPdus{0};
+
+    std::atomic<int> pending{1};
+    std::atomic_bool failed{false};
+    std::exception_ptr error{};
+
+    Promise<TransferSummary> promise{};
+};
+} // namespace
+
+cfdp::runtime::sender::Sender::Sender(thread_pool::ThreadPool& pool, io::Transport& transport,
+                                      SenderOptions options)
+    : pool(pool), transport(transport), options(options)
+{
+    if (options.segmentSize == 0 || options.segmentSize > FileData::max_data_size)
+    {
+        throw std::invalid_argument{"segment size has to be between 1 and 65527 bytes"};
+    }
+    if (options.segmentSize + max_file_data_overhead > transport.maxPduSize())
+    {
+        throw std::invalid_argument{
+            std::format("segment size is limited to {} bytes by the transport",
+                        transport.maxPduSize() - std::min(transport.maxPduSize(),
+                                                          max_file_data_overhead))};
+    }
+    if (options.readSize < options.segmentSize)
+    {
+        throw std::invalid_argument{"read size has to fit at least a single segment"};
+    }
+}
+
+auto cfdp::runtime::sender::Sender::send(const std::filesystem::path& file,
+                                         uint64_t destinationEntity)
+    -> future::Future<TransferSummary>
+{
+    if (destinationEntity == options.sourceEntity)
+    {
+        throw std::invalid_argument{"destination entity is the sender itself"};
+    }
+
+    auto sourceFileName      = file.string();
+    auto destinationFileName = file.filename().string();
+
+    if (sourceFileName.size() > max_file_name_size ||
+        destinationFileName.size() > max_file_name_size)
+    {
+        throw std::invalid_argument{"file names are limited to 255 bytes"};
+    }
+
+    auto descriptor = io::FileDescriptor{::open(sourceFileName.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (!descriptor.isValid())
+    {
+        throw lastError("open");
+    }
+
+    struct stat status{};
+    if (::fstat(descriptor.get(), &status) != 0)
+    {
+        throw lastError("fstat");
+    }
+    if (!S_ISREG(status.st_mode))
+    {
+        throw std::invalid_argument{"only regular files can be sent"};
+    }
+
+    // Sequential reads, the kernel can read ahead further.
+    ::posix_fadvise(descriptor.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    const auto id = TransactionId{
+        .sourceEntity      = options.sourceEntity,
+        .sequenceNumber    = nextTransaction.fetch_add(1, std::memory_order_relaxed),
+        .destinationEntity = destinationEntity,
+    };
+    const auto fileSize = static_cast<uint64_t>(status.st_size);
+
+    logging::trace<log_module>("starting transaction {} of {} ({} byte(s)) to entity {}",
+                               id.sequenceNumber, sourceFileName, fileSize, destinationEntity);
+
+    auto transaction = std::make_shared<Transaction>(
+        pool, transport, options, id, std::move(descriptor), fileSize, std::move(sourceFileName),
+        std::move(destinationFileName));
+
+    auto result = transaction->getFuture();
+    transaction->start();
+
+    return result;
+}
@@ -0,0 +1,140 @@
+#include <cfdp_runtime/logger.hpp>
+#include <cfdp_runtime/simulation.hpp>
+
+#include <algorithm>
+#include <limits>
+
+cfdp::runtime::simulation::Scheduler::Scheduler(Clock::duration tickDuration)
+    : tick(std::max(tickDuration, Clock::duration{1}))
+{
+    logging::trace<log_module>("creating a simulation scheduler with a tick of {} ns",
+                               tick.count());
+}
+
+auto cfdp::runtime::simulation::Scheduler::scheduleAfter(Clock::duration delay,
+                                                         thread_pool::Task&& callback)
+    -> timer::TimerId
+{
+    return scheduleAt(time + delay, std::move(callback));
+}
+
+auto cfdp::runtime::simulation::Scheduler::scheduleAt(Clock::time_point deadline,
+                                                      thread_pool::Task&& callback)
+    -> timer::TimerId
+{
+    return wheel.arm(expiryTick(deadline), std::move(callback));
+}
+
+bool cfdp::runtime::simulation::Scheduler::cancel(timer::TimerId id) noexcept
+{
+    return wheel.cancel(id);
+}
+
+bool cfdp::runtime::simulation::Scheduler::rearm(timer::TimerId id, Clock::duration delay) noexcept
+{
+    return wheel.rearm(id, expiryTick(time + delay));
+}
+
+bool cfdp::runtime::simulation::Scheduler::step()
+{
+    while (ready.empty())
+    {
+        if (!advanceTimers(std::numeric_limits<uint64_t>::max()))
+        {
+            return false;
+        }
+    }
+
+    return runReady();
+}
+
+size_t cfdp::runtime::simulation::Scheduler::runUntilIdle()
+{
+    auto numTasks = size_t{0};
+
+    while (step())
+    {
+        ++numTasks;
+    }
+
+    return numTasks;
+}
+
+size_t cfdp::runtime::simulation::Scheduler::runUntil(Clock::time_point deadline)
+{
+    // Timers due exactly at the deadline fire as well.
+    const auto limitTick = deadline < Clock::time_point{}
+                               ? uint64_t{0}
+                               : static_cast<uint64_t>(deadline.time_since_epoch() / tick);
+
+    auto numTasks = size_t{0};
+
+    while (true)
+    {
+        if (runReady())
+        {
+            ++numTasks;
+            continue;
+        }
+
+        if (!advanceTimers(limitTick))
+        {
+            break;
+        }
+    }
+
+    time = std::max(time, deadline);
+
+    return numTasks;
+}
+
+uint64_t cfdp::runtime::simulation::Scheduler::expiryTick(Clock::time_point deadline) const noexcept
+{
+    if (deadline <= Clock::time_point{})
+    {
+        return 0;
+    }
+
+    const auto elapsed = deadline.time_since_epoch();
+    return static_cast<uint64_t>((elapsed + tick - Clock::duration{1}) / tick);
+}
+
+bool cfdp::runtime::simulation::Scheduler::advanceTimers(uint64_t limitTick)
+{
+    const auto next = wheel.nextExpiry();
+
+    if (!next.has_value() || next.value() > limitTick)
+    {
+        return false;
+    }
+
+    // The wheel never moves backwards, timers armed in the past fire on
+    // the current tick.
+    const auto target = std::max(next.value(), wheel.currentTick());
+
+    wheel.advance(target, expired);
+    time = std::max(time, Clock::time_point{tick * static_cast<Clock::rep>(target)});
+
+    for (auto& callback : expired)
+    {
+        ready.push_back(std::move(callback));
+    }
+    expired.clear();
+
+    return true;
+}
+
+bool cfdp::runtime::simulation::Scheduler::runReady()
+{
+    if (ready.empty())
+    {
+        return false;
+    }
+
+    auto task = std::move(ready.front());
+    ready.pop_front();
+
+    task();
+
+    return true;
+}
@@ -1,52 +1,1127 @@
 #include <cfdp_runtime/logger.hpp>
+#include <cfdp_runtime/profiling.hpp>
 #include <cfdp_runtime/thread_pool.hpp>
+#include <cfdp_runtime/tracing.hpp>
 
-cfdp::runtime::thread_pool::ThreadPool::ThreadPool(size_t numWorkers) : shutdownFlag(false), queue()
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+// Cheap per-thread xorshift generator, used only to pick steal victims.
+[[nodiscard]] uint64_t nextRandom() noexcept
+{
+    thread_local uint64_t state =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) | uint64_t{1};
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+[[nodiscard]] size_t initialWorkers(const cfdp::runtime::thread_pool::ThreadPoolOptions& options)
+{
+    if (!options.elastic.has_value())
+    {
+        return options.numWorkers;
+    }
+
+    return std::min(options.elastic->minWorkers, options.numWorkers);
+}
+
+[[nodiscard]] int64_t steadyNow() noexcept
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+using ::cfdp::runtime::thread_pool::num_priorities;
+
+constexpr auto lane_names = std::array<std::string_view, num_priorities>{"high", "normal", "low"};
+
+[[nodiscard]] cfdp::runtime::metrics::Labels nextPoolLabels()
+{
+    static auto nextPool = std::atomic<size_t>{0};
+
+    return {{"pool", std::to_string(nextPool.fetch_add(1, std::memory_order_relaxed))}};
+}
+
+[[nodiscard]] std::array<std::string, num_priorities>
+laneSeriesKeys(const cfdp::runtime::metrics::Labels& poolLabels)
+{
+    auto keys = std::array<std::string, num_priorities>{};
+
+    for (auto lane = size_t{0}; lane < num_priorities; ++lane)
+    {
+        auto labels = poolLabels;
+        labels.emplace_back("lane", lane_names[lane]);
+        keys[lane] = cfdp::runtime::metrics::Registry::seriesKey(labels);
+    }
+
+    return keys;
+}
+
+[[nodiscard]] cfdp::runtime::metrics::Counter& poolCounter(
+    std::string_view name, std::string_view help, const cfdp::runtime::metrics::Labels& labels)
+{
+    return cfdp::runtime::metrics::Registry::global().counter(name, help, labels);
+}
+} // namespace
+
+thread_local cfdp::runtime::thread_pool::ThreadPool::Worker*
+    cfdp::runtime::thread_pool::ThreadPool::localWorker = nullptr;
+
+cfdp::runtime::thread_pool::ThreadPool::ThreadPool(size_t numWorkers)
+    : ThreadPool(numWorkers, WorkerPlacement{})
+{}
+
+cfdp::runtime::thread_pool::ThreadPool::ThreadPool(size_t numWorkers,
+                                                   WorkerPlacement workerPlacement)
+    : ThreadPool(ThreadPoolOptions{
+          .numWorkers = numWorkers,
+          .placement  = std::move(workerPlacement),
+      })
+{}
+
+cfdp::runtime::thread_pool::ThreadPool::ThreadPool(ThreadPoolOptions options)
+    : shutdownFlag(false), placement(std::move(options.placement)), lanePolicy(options.lanes),
+      elastic(options.elastic), slots(options.numWorkers), started(initialWorkers(options) + 1),
+      numRunning(0), backlogSince(0), lanes(), sharedNodes(shared_free_nodes), numIdle(0),
+      metricsLabels(nextPoolLabels()), metricsKey(metrics::Registry::seriesKey(metricsLabels)),
+      laneMetricsKeys(laneSeriesKeys(metricsLabels))
+{
+    try
+    {
+        submittedTasks = &poolCounter("cfdp_thread_pool_tasks_submitted_total",
+                                      "Tasks queued in the thread pool.", metricsLabels);
+        executedTasks =
+            &poolCounter("cfdp_thread_pool_tasks_executed_total",
+                         "Tasks run by the workers of the thread pool.", metricsLabels);
+        rejectedTasks = &poolCounter("cfdp_thread_pool_tasks_rejected_total",
+                                     "Tasks refused because their lane was full.", metricsLabels);
+
+        if (options.collectStats)
+        {
+            auto& registry = metrics::Registry::global();
+
+            statistics = std::make_unique<Statistics>(
+                registry.histogram("cfdp_thread_pool_task_wait_ns",
+                                   "Time from dispatching a task until it starts.", metricsLabels),
+                registry.histogram("cfdp_thread_pool_task_run_ns", "Time a task was running.",
+                                   metricsLabels));
+        }
+
+        registerMetrics();
+    }
+    catch (...)
+    {
+        // No destructor runs for a pool which failed to construct.
+        unregisterMetrics();
+        throw;
+    }
+
+    const auto numWorkers = initialWorkers(options);
+
+    logging::trace<log_module>("creating a thread pool object with {} worker(s), up to {}",
+                               numWorkers, slots.size());
+
+    if (placement.cpuSets.empty() && placement.numaNode.has_value())
+    {
+        const auto node = placement.numaNode.value();
+        auto cpus       = hardware::numaNodeCpus(node);
+
+        if (cpus.empty())
+        {
+            logging::warn<log_module>("could not find CPUs of NUMA node {}, workers are not pinned",
+                                      node);
+        }
+        else
+        {
+            placement.cpuSets.push_back(std::move(cpus));
+        }
+    }
+
+    idleWorkers.reserve(slots.size());
+
+    for (size_t i = 0; i < numWorkers; ++i)
+    {
+        spawnWorker(true);
+    }
+
+    if (elastic.has_value())
+    {
+        try
+        {
+            monitor = std::thread{[this]() { monitorLoad(); }};
+        }
+        catch (const std::system_error& error)
+        {
+            logging::error<log_module>("could not start the load monitor: {}", error.what());
+
+            // No destructor runs for a pool which failed to construct, the
+            // started workers are released and joined here.
+            started.count_down();
+            shutdown(ShutdownMode::Cancel);
+            unregisterMetrics();
+            throw;
+        }
+    }
+
+    // Initial workers are placed and ready before the first dispatch.
+    started.arrive_and_wait();
+}
+
+cfdp::runtime::thread_pool::ThreadPool::~ThreadPool()
+{
+    shutdown();
+
+    // Catches the tasks dispatched after the shutdown.
+    cancelQueued();
+
+    while (auto node = sharedNodes.tryPop())
+    {
+        const auto owned = std::unique_ptr<QueuedTask>{node.value()};
+    }
+
+    unregisterMetrics();
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::shutdown(ShutdownMode mode) noexcept
+{
+    if (shutdownFlag.load(std::memory_order_relaxed))
+    {
+        logging::warn<log_module>("thread pool object was already closed, skipping shutdown");
+        return;
+    }
+
+    if (mode == ShutdownMode::Drain)
+    {
+        waitUntilDrained();
+    }
+
+    if (shutdownFlag.exchange(true, std::memory_order_seq_cst))
+    {
+        logging::warn<log_module>("thread pool object was already closed, skipping shutdown");
+        return;
+    }
+
+    logging::trace<log_module>("shutting down a thread pool object");
+
+    wakeAll();
+
+    {
+        std::scoped_lock<std::mutex> lock{monitorMutex};
+        monitorCondition.notify_all();
+    }
+
+    if (monitor.joinable())
+    {
+        monitor.join();
+    }
+
+    auto threads = std::vector<std::thread>{};
+
+    {
+        // No worker is started once the flag is set, retired ones are
+        // joined here as well.
+        std::scoped_lock<std::mutex> lock{spawnMutex};
+
+        for (auto& slot : slots)
+        {
+            if (slot.thread.joinable())
+            {
+                threads.push_back(std::move(slot.thread));
+            }
+        }
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Workers are joined, whatever is left in the queues will never run.
+    cancelQueued();
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::waitUntilDrained() noexcept
+{
+    logging::trace<log_module>("draining a thread pool object");
+
+    std::unique_lock<std::mutex> lock{idleMutex};
+
+    drained.wait(lock, [this]() {
+        return idleWorkers.size() == numRunning.load(std::memory_order_relaxed) &&
+               !hasQueuedTasks();
+    });
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::cancelQueued() noexcept
+{
+    auto numCancelled = size_t{0};
+
+    for (auto& slot : slots)
+    {
+        if (slot.owned == nullptr)
+        {
+            continue;
+        }
+
+        while (auto task = slot.owned->deque.pop())
+        {
+            std::unique_ptr<QueuedTask>{task.value()}->task.cancel();
+            ++numCancelled;
+        }
+    }
+
+    for (auto& lane : lanes)
+    {
+        while (auto task = lane.queue.popIfAny())
+        {
+            lane.size.fetch_sub(1, std::memory_order_relaxed);
+            std::unique_ptr<QueuedTask>{task.value()}->task.cancel();
+            ++numCancelled;
+        }
+    }
+
+    if (numCancelled > 0)
+    {
+        logging::trace<log_module>("cancelled {} queued task(s)", numCancelled);
+    }
+}
+
+std::pmr::memory_resource* cfdp::runtime::thread_pool::ThreadPool::localMemoryResource() noexcept
+{
+    if (localWorker == nullptr)
+    {
+        return std::pmr::get_default_resource();
+    }
+
+    return &localWorker->memory;
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::post(Priority priority, Task&& task) noexcept
+{
+    reserveLane(static_cast<size_t>(priority), 1);
+    enqueueToLane(std::move(task), priority);
+}
+
+bool cfdp::runtime::thread_pool::ThreadPool::tryPost(Priority priority, Task&& task) noexcept
+{
+    if (!admit(priority))
+    {
+        return false;
+    }
+
+    enqueueToLane(std::move(task), priority);
+
+    return true;
+}
+
+size_t cfdp::runtime::thread_pool::ThreadPool::laneSize(Priority priority) const noexcept
+{
+    return lanes[static_cast<size_t>(priority)].size.load(std::memory_order_relaxed);
+}
+
+bool cfdp::runtime::thread_pool::ThreadPool::admit(Priority priority) noexcept
+{
+    const auto lane = static_cast<size_t>(priority);
+    auto& size      = lanes[lane].size;
+
+    // The place is taken before it is checked, so concurrent producers
+    // cannot overshoot the limit together.
+    const auto previous = size.fetch_add(1, std::memory_order_relaxed);
+
+    if (previous < lanePolicy.lanes[lane].maxDepth)
+    {
+        if (statistics != nullptr)
+        {
+            noteLaneDepth(lane, previous + 1);
+        }
+
+        return true;
+    }
+
+    size.fetch_sub(1, std::memory_order_relaxed);
+
+    rejectedTasks->add();
+    return false;
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::reserveLane(size_t lane, size_t numTasks) noexcept
+{
+    const auto depth = lanes[lane].size.fetch_add(numTasks, std::memory_order_relaxed) + numTasks;
+
+    if (statistics != nullptr)
+    {
+        noteLaneDepth(lane, depth);
+    }
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::enqueue(Task&& task) noexcept
+{
+    if (!isLocalWorker())
+    {
+        reserveLane(static_cast<size_t>(Priority::Normal), 1);
+        enqueueToLane(std::move(task), Priority::Normal);
+        return;
+    }
+
+    localWorker->deque.push(makeQueued(std::move(task)));
+    notifyEnqueued(1);
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::enqueueToLane(Task&& task, Priority priority) noexcept
+{
+    CFDP_PROFILE_SCOPE("thread_pool.enqueue");
+
+    lanes[static_cast<size_t>(priority)].queue.emplace(makeQueued(std::move(task)));
+
+    notifyEnqueued(1);
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::enqueueBulk(std::vector<Task>&& tasks) noexcept
+{
+    const auto numTasks = tasks.size();
+
+    if (numTasks == 0)
+    {
+        return;
+    }
+
+    auto nodes = std::vector<QueuedTask*>{};
+    nodes.reserve(numTasks);
+
+    for (auto& task : tasks)
+    {
+        nodes.push_back(makeQueued(std::move(task)));
+    }
+
+    if (isLocalWorker())
+    {
+        for (auto* node : nodes)
+        {
+            localWorker->deque.push(node);
+        }
+    }
+    else
+    {
+        const auto lane = static_cast<size_t>(Priority::Normal);
+
+        reserveLane(lane, numTasks);
+        lanes[lane].queue.emplaceBulk(std::move(nodes));
+    }
+
+    notifyEnqueued(numTasks);
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::notifyEnqueued(size_t numTasks) noexcept
+{
+    submittedTasks->add(numTasks);
+
+    // Pairs with the fence in `park`, either the parking worker sees the
+    // new task, or we see the worker registered as idle and wake it up.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (numIdle.load(std::memory_order_relaxed) > 0)
+    {
+        wake(numTasks);
+        return;
+    }
+
+    if (!elastic.has_value())
+    {
+        return;
+    }
+
+    // The same fence pairs with the one in `retire`, either the last
+    // retiring worker sees the new task, or we see the pool empty.
+    if (numRunning.load(std::memory_order_relaxed) == 0)
+    {
+        spawnWorker();
+        return;
+    }
+
+    noteBacklog(true);
+}
+
+bool cfdp::runtime::thread_pool::ThreadPool::spawnWorker(bool initial) noexcept
+{
+    std::scoped_lock<std::mutex> lock{spawnMutex};
+
+    if (shutdownFlag.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    // Slots of retired workers which have not exited yet are skipped, their
+    // threads could be waiting for this very mutex.
+    auto slot = std::ranges::find_if(slots, [](const Slot& slot) {
+        return !slot.running && slot.exited.load(std::memory_order_acquire);
+    });
+
+    if (slot == slots.end())
+    {
+        return false;
+    }
+
+    const auto index = static_cast<size_t>(std::distance(slots.begin(), slot));
+
+    if (slot->thread.joinable())
+    {
+        slot->thread.join();
+    }
+
+    slot->running = true;
+    slot->exited.store(false, std::memory_order_relaxed);
+    numRunning.fetch_add(1, std::memory_order_relaxed);
+
+    try
+    {
+        // We can safely pass a `this` reference to every worker.
+        // ThreadPool object should always outlive its children.
+        slot->thread = std::thread{[this, index, initial]() { startWorker(index, initial); }};
+    }
+    catch (const std::system_error& error)
+    {
+        logging::error<log_module>("could not start worker {}: {}", index, error.what());
+
+        slot->running = false;
+        slot->exited.store(true, std::memory_order_relaxed);
+        numRunning.fetch_sub(1, std::memory_order_relaxed);
+
+        if (initial)
+        {
+            started.count_down();
+        }
+        return false;
+    }
+
+    logging::trace<log_module>("started worker {}, {} worker(s) running", index,
+                               numRunning.load(std::memory_order_relaxed));
+
+    return true;
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::noteBacklog(bool backlogged) noexcept
+{
+    // Checked first, so the hot paths only read a shared cache line, it is
+    // written once at the start and once at the end of a backlog.
+    const auto since = backlogSince.load(std::memory_order_relaxed);
+
+    if (!backlogged)
+    {
+        if (since != 0)
+        {
+            backlogSince.store(0, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    if (since != 0)
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock<std::mutex> lock{monitorMutex};
+        backlogSince.store(steadyNow(), std::memory_order_relaxed);
+    }
+
+    monitorCondition.notify_one();
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::monitorLoad() noexcept
+{
+    const auto latency =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(elastic->spawnLatency);
+
+    const auto isStopped = [this]() { return shutdownFlag.load(std::memory_order_relaxed); };
+
+    auto lock = std::unique_lock<std::mutex>{monitorMutex};
+
+    while (!isStopped())
+    {
+        monitorCondition.wait(lock, [this, &isStopped]() {
+            return isStopped() || backlogSince.load(std::memory_order_relaxed) != 0;
+        });
+
+        const auto since = backlogSince.load(std::memory_order_relaxed);
+        const auto due   = std::chrono::steady_clock::time_point{
+            std::chrono::steady_clock::duration{since}} + latency;
+
+        if (monitorCondition.wait_until(lock, due, isStopped))
+        {
+            break;
+        }
+
+        // The backlog could have ended, or ended and started again since.
+        if (backlogSince.load(std::memory_order_relaxed) != since)
+        {
+            continue;
+        }
+
+        if (numIdle.load(std::memory_order_relaxed) > 0 || !hasQueuedTasks())
+        {
+            backlogSince.store(0, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Restarting the measurement lets the pool grow by one worker per
+        // `spawnLatency` at most, every new worker gets a chance to catch up.
+        backlogSince.store(steadyNow(), std::memory_order_relaxed);
+
+        lock.unlock();
+        spawnWorker();
+        lock.lock();
+    }
+}
+
+bool cfdp::runtime::thread_pool::ThreadPool::retire(Worker& self) noexcept
 {
-    logging::trace("creating a thread pool object with {} worker(s)", numWorkers);
+    auto& slot = slots[self.index];
 
-    workers = std::vector<std::thread>{};
-    workers.reserve(numWorkers);
+    {
+        std::scoped_lock<std::mutex> idleLock{idleMutex};
 
-    for (size_t i = 0; i < numWorkers; ++i)
+        const auto it = std::ranges::find(idleWorkers, &self);
+        if (it == idleWorkers.end())
+        {
+            // Taken off the idle list right after the timeout, the wakeup
+            // is on its way.
+            return false;
+        }
+
+        std::scoped_lock<std::mutex> spawnLock{spawnMutex};
+
+        if (numRunning.load(std::memory_order_relaxed) <= elastic->minWorkers)
+        {
+            return false;
+        }
+
+        idleWorkers.erase(it);
+        numIdle.fetch_sub(1, std::memory_order_relaxed);
+
+        slot.running = false;
+        numRunning.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (hasQueuedTasks())
     {
-        // We can safely pass a `this` reference to every worker.
-        // ThreadPool object should always outlive its children.
-        auto worker = std::thread{[this]() mutable {
-            while (!shutdownFlag.load(std::memory_order_relaxed))
+        // A task arrived while we were leaving and the producer could have
+        // counted on us. Nobody can take the slot before the thread exits.
+        std::scoped_lock<std::mutex> spawnLock{spawnMutex};
+
+        slot.running = true;
+        numRunning.fetch_add(1, std::memory_order_relaxed);
+        self.wakeup.release();
+
+        return false;
+    }
+
+    logging::trace<log_module>("worker {} retired after being idle, {} worker(s) running",
+                               self.index, numRunning.load(std::memory_order_relaxed));
+
+    return true;
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::startWorker(size_t index, bool initial) noexcept
+{
+    tracing::setThreadName(std::format("cfdp worker {}", index));
+
+    const auto& cpuSets = placement.cpuSets;
+
+    if (!cpuSets.empty() && !hardware::pinCurrentThread(cpuSets[index % cpuSets.size()]))
+    {
+        logging::warn<log_module>("could not pin worker {} to its CPUs", index);
+    }
+
+    if (placement.numaNode.has_value() && !hardware::preferNumaNode(placement.numaNode.value()))
+    {
+        logging::warn<log_module>("could not bind memory of worker {} to NUMA node {}", index,
+                                  placement.numaNode.value());
+    }
+
+    auto& slot = slots[index];
+
+    // Allocated only after the placement is applied, so the first touch
+    // happens on the right node. Workers started later in the same slot
+    // take over the structures.
+    if (slot.owned == nullptr)
+    {
+        slot.owned            = std::make_unique<Worker>(*this, index);
+        slot.owned->createdAt = steadyNow();
+        slot.worker.store(slot.owned.get(), std::memory_order_release);
+    }
+
+    if (initial)
+    {
+        started.arrive_and_wait();
+    }
+
+    runWorker(*slot.owned);
+
+    slot.exited.store(true, std::memory_order_release);
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::runWorker(Worker& self) noexcept
+{
+    localWorker = &self;
+
+    while (!shutdownFlag.load(std::memory_order_acquire))
+    {
+        auto task = findTask(self);
+
+        for (size_t round = 0; task == nullptr && round < spin_rounds; ++round)
+        {
+            std::this_thread::yield();
+            task = findTask(self);
+        }
+
+        if (task == nullptr)
+        {
+            if (!park(self))
+            {
+                break;
+            }
+            continue;
+        }
+
+        if (elastic.has_value())
+        {
+            noteBacklog(numIdle.load(std::memory_order_relaxed) == 0 &&
+                        (!self.deque.isEmpty() || hasLaneTasks()));
+        }
+
+        logging::trace<log_module>("worker {} picked up a task", self.index);
+
+        runTask(self, std::move(task));
+    }
+
+    localWorker = nullptr;
+}
+
+auto cfdp::runtime::thread_pool::ThreadPool::findTask(Worker& self) noexcept
+    -> std::unique_ptr<QueuedTask>
+{
+    for (auto lane : laneOrder(self))
+    {
+        auto task = std::unique_ptr<QueuedTask>{};
+
+        // Tasks in the own deque belong to the Normal lane.
+        if (lane == static_cast<size_t>(Priority::Normal))
+        {
+            if (auto local = self.deque.pop())
+            {
+                task.reset(local.value());
+            }
+        }
+
+        if (task == nullptr)
+        {
+            task = takeFromLane(lane);
+        }
+
+        if (task != nullptr)
+        {
+            if (self.credits[lane] > 0)
             {
-                auto potentialTask = queue.tryPop();
+                --self.credits[lane];
+            }
+            return task;
+        }
+
+        // An empty lane gives up the rest of its turn, otherwise its unused
+        // credits would hold back the next round forever.
+        self.credits[lane] = 0;
+    }
+
+    return stealTask(self);
+}
+
+auto cfdp::runtime::thread_pool::ThreadPool::takeFromLane(size_t lane) noexcept
+    -> std::unique_ptr<QueuedTask>
+{
+    CFDP_PROFILE_SCOPE("thread_pool.dequeue");
+
+    auto& source = lanes[lane];
+
+    if (source.size.load(std::memory_order_relaxed) == 0)
+    {
+        return nullptr;
+    }
+
+    if (auto task = source.queue.popIfAny())
+    {
+        source.size.fetch_sub(1, std::memory_order_relaxed);
+        return std::unique_ptr<QueuedTask>{task.value()};
+    }
+
+    return nullptr;
+}
+
+auto cfdp::runtime::thread_pool::ThreadPool::laneOrder(Worker& self) const noexcept
+    -> std::array<size_t, num_priorities>
+{
+    auto order = std::array<size_t, num_priorities>{};
+
+    for (size_t lane = 0; lane < num_priorities; ++lane)
+    {
+        order[lane] = lane;
+    }
+
+    if (lanePolicy.scheduling == LaneScheduling::Strict)
+    {
+        return order;
+    }
+
+    // A new round starts once every lane used up its credits, or had no
+    // work left to spend them on.
+    if (std::ranges::all_of(self.credits, [](uint32_t credit) { return credit == 0; }))
+    {
+        for (size_t lane = 0; lane < num_priorities; ++lane)
+        {
+            self.credits[lane] = std::max(lanePolicy.lanes[lane].weight, uint32_t{1});
+        }
+    }
+
+    // Lanes with credits left go first, the rest only if those are empty,
+    // so the scheduling stays work conserving.
+    std::ranges::stable_partition(order, [&self](size_t lane) { return self.credits[lane] > 0; });
+
+    return order;
+}
+
+auto cfdp::runtime::thread_pool::ThreadPool::stealTask(Worker& self) noexcept
+    -> std::unique_ptr<QueuedTask>
+{
+    const auto numSlots = slots.size();
+    const auto offset   = nextRandom() % numSlots;
 
-                if (potentialTask.has_value())
-                {
-                    auto task = potentialTask.value();
+    for (size_t i = 0; i < numSlots; ++i)
+    {
+        auto* victim = slots[(offset + i) % numSlots].worker.load(std::memory_order_acquire);
 
-                    logging::trace("worker picked up a task, queue size: {}", queue.sizeNow());
+        if (victim == nullptr || victim == &self)
+        {
+            continue;
+        }
 
-                    task();
-                }
+        if (auto task = victim->deque.steal())
+        {
+            if (statistics != nullptr)
+            {
+                self.steals.fetch_add(1, std::memory_order_relaxed);
             }
-        }};
+            return std::unique_ptr<QueuedTask>{task.value()};
+        }
+    }
 
-        workers.emplace_back(std::move(worker));
+    return nullptr;
+}
+
+bool cfdp::runtime::thread_pool::ThreadPool::hasLaneTasks() const noexcept
+{
+    return std::ranges::any_of(
+        lanes, [](const Lane& lane) { return lane.size.load(std::memory_order_relaxed) > 0; });
+}
+
+bool cfdp::runtime::thread_pool::ThreadPool::hasQueuedTasks() const noexcept
+{
+    if (hasLaneTasks())
+    {
+        return true;
+    }
+
+    return std::ranges::any_of(slots, [](const Slot& slot) {
+        const auto* worker = slot.worker.load(std::memory_order_acquire);
+        return worker != nullptr && !worker->deque.isEmpty();
+    });
+}
+
+bool cfdp::runtime::thread_pool::ThreadPool::park(Worker& self) noexcept
+{
+    if (elastic.has_value())
+    {
+        noteBacklog(false);
+    }
+
+    {
+        std::scoped_lock<std::mutex> lock{idleMutex};
+        idleWorkers.push_back(&self);
+        numIdle.fetch_add(1, std::memory_order_relaxed);
+
+        if (idleWorkers.size() == numRunning.load(std::memory_order_relaxed))
+        {
+            drained.notify_all();
+        }
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (hasQueuedTasks() || shutdownFlag.load(std::memory_order_relaxed))
+    {
+        std::unique_lock<std::mutex> lock{idleMutex};
+        auto it = std::ranges::find(idleWorkers, &self);
+
+        if (it != idleWorkers.end())
+        {
+            idleWorkers.erase(it);
+            numIdle.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Somebody already took us off the idle list and is about to
+        // wake us up. Consume that wakeup, so it does not leak into the
+        // next park.
+        lock.unlock();
+    }
+
+    if (!elastic.has_value())
+    {
+        self.wakeup.acquire();
+        return true;
+    }
+
+    while (!self.wakeup.try_acquire_for(elastic->idleTimeout))
+    {
+        if (retire(self))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::wake(size_t count) noexcept
+{
+    auto parked = std::vector<Worker*>{};
+
+    {
+        std::scoped_lock<std::mutex> lock{idleMutex};
+
+        // The most recently parked workers have the warmest caches.
+        while (!idleWorkers.empty() && parked.size() < count)
+        {
+            parked.push_back(idleWorkers.back());
+            idleWorkers.pop_back();
+        }
+
+        numIdle.fetch_sub(parked.size(), std::memory_order_relaxed);
+    }
+
+    for (auto* worker : parked)
+    {
+        worker->wakeup.release();
+    }
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::wakeAll() noexcept
+{
+    auto parked = std::vector<Worker*>{};
+
+    {
+        std::scoped_lock<std::mutex> lock{idleMutex};
+        parked.swap(idleWorkers);
+        numIdle.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto* worker : parked)
+    {
+        worker->wakeup.release();
+    }
+}
+
+auto cfdp::runtime::thread_pool::ThreadPool::makeQueued(Task&& task) noexcept -> QueuedTask*
+{
+    auto queued      = takeNode();
+    queued->task     = std::move(task);
+    queued->queuedAt = statistics != nullptr ? steadyNow() : 0;
+
+    return queued.release();
+}
+
+auto cfdp::runtime::thread_pool::ThreadPool::takeNode() noexcept -> std::unique_ptr<QueuedTask>
+{
+    if (isLocalWorker() && !localWorker->freeNodes.empty())
+    {
+        auto node = std::move(localWorker->freeNodes.back());
+        localWorker->freeNodes.pop_back();
+        return node;
+    }
+
+    if (auto node = sharedNodes.tryPop())
+    {
+        return std::unique_ptr<QueuedTask>{node.value()};
+    }
+
+    return std::make_unique<QueuedTask>();
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::recycleNode(Worker& self,
+                                                         std::unique_ptr<QueuedTask> node) noexcept
+{
+    // Releases whatever the task captured now, not once the node is reused.
+    node->task = Task{};
+
+    if (self.freeNodes.size() < local_free_nodes)
+    {
+        self.freeNodes.push_back(std::move(node));
+        return;
+    }
+
+    if (sharedNodes.tryPush(node.get()))
+    {
+        static_cast<void>(node.release());
     }
 }
 
-void cfdp::runtime::thread_pool::ThreadPool::shutdown() noexcept
+void cfdp::runtime::thread_pool::ThreadPool::runTask(Worker& self,
+                                                     std::unique_ptr<QueuedTask> task) noexcept
 {
-    if (shutdownFlag.exchange(true, std::memory_order_relaxed))
+    const auto span = tracing::Span{"task", "thread_pool"};
+
+    if (statistics == nullptr)
     {
-        logging::warn("thread pool object was already closed, skipping shutdown");
+        task->task();
+        executedTasks->add();
+        recycleNode(self, std::move(task));
         return;
     }
 
-    logging::trace("shutting down a thread pool object");
+    const auto startedAt = steadyNow();
+    task->task();
+    const auto finishedAt = steadyNow();
+
+    const auto runTime = static_cast<uint64_t>(finishedAt - startedAt);
+
+    // Tasks queued before the stats were on carry no time.
+    if (task->queuedAt != 0)
+    {
+        statistics->waitTime.record(static_cast<uint64_t>(std::max(startedAt - task->queuedAt,
+                                                                   int64_t{0})));
+    }
+    statistics->runTime.record(runTime);
+
+    self.tasksRun.fetch_add(1, std::memory_order_relaxed);
+    self.busyNanos.fetch_add(runTime, std::memory_order_relaxed);
+    executedTasks->add();
+    recycleNode(self, std::move(task));
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::noteLaneDepth(size_t lane, size_t depth) noexcept
+{
+    auto& highWater = statistics->laneHighWater[lane];
+
+    auto current = highWater.load(std::memory_order_relaxed);
+    while (depth > current &&
+           !highWater.compare_exchange_weak(current, depth, std::memory_order_relaxed))
+    {
+    }
+}
+
+auto cfdp::runtime::thread_pool::ThreadPool::stats() const -> std::optional<ThreadPoolStats>
+{
+    if (statistics == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    auto result = ThreadPoolStats{
+        .waitTime = statistics->waitTime.snapshot(),
+        .runTime  = statistics->runTime.snapshot(),
+    };
+
+    const auto now = steadyNow();
 
-    for (auto& worker : workers)
+    for (const auto& slot : slots)
     {
-        if (worker.joinable())
+        const auto* worker = slot.worker.load(std::memory_order_acquire);
+        if (worker == nullptr)
         {
-            worker.join();
+            continue;
         }
+
+        result.workers.push_back(WorkerStats{
+            .index    = worker->index,
+            .tasksRun = worker->tasksRun.load(std::memory_order_relaxed),
+            .steals   = worker->steals.load(std::memory_order_relaxed),
+            .busy     = std::chrono::nanoseconds{worker->busyNanos.load(std::memory_order_relaxed)},
+            .lifetime = std::chrono::nanoseconds{now - worker->createdAt},
+        });
+    }
+
+    for (size_t lane = 0; lane < num_priorities; ++lane)
+    {
+        result.laneHighWater[lane] =
+            statistics->laneHighWater[lane].load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+double cfdp::runtime::thread_pool::WorkerStats::utilisation() const noexcept
+{
+    if (lifetime.count() <= 0)
+    {
+        return 0.0;
+    }
+
+    return std::min(static_cast<double>(busy.count()) / static_cast<double>(lifetime.count()),
+                    1.0);
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::registerMetrics()
+{
+    auto& registry = metrics::Registry::global();
+
+    for (auto lane = size_t{0}; lane < num_priorities; ++lane)
+    {
+        auto labels = metricsLabels;
+        labels.emplace_back("lane", lane_names[lane]);
+
+        registry.callbackGauge("cfdp_thread_pool_lane_depth", "Tasks waiting in a lane.", labels,
+                               [this, lane]() {
+                                   return static_cast<double>(
+                                       lanes[lane].size.load(std::memory_order_relaxed));
+                               });
+    }
+
+    registry.callbackGauge("cfdp_thread_pool_workers", "Workers currently running.", metricsLabels,
+                           [this]() { return static_cast<double>(numWorkersNow()); });
+    registry.callbackGauge(
+        "cfdp_thread_pool_idle_workers", "Workers parked while waiting for tasks.", metricsLabels,
+        [this]() { return static_cast<double>(numIdle.load(std::memory_order_relaxed)); });
+}
+
+void cfdp::runtime::thread_pool::ThreadPool::unregisterMetrics() noexcept
+{
+    auto& registry = metrics::Registry::global();
+
+    for (const auto& key : laneMetricsKeys)
+    {
+        registry.remove("cfdp_thread_pool_lane_depth", key);
+    }
+
+    for (const auto name :
+         {"cfdp_thread_pool_workers", "cfdp_thread_pool_idle_workers",
+          "cfdp_thread_pool_tasks_submitted_total", "cfdp_thread_pool_tasks_executed_total",
+          "cfdp_thread_pool_tasks_rejected_total", "cfdp_thread_pool_task_wait_ns",
+          "cfdp_thread_pool_task_run_ns"})
+    {
+        registry.remove(name, metricsKey);
     }
 }
@@ -0,0 +1,162 @@
+#include <cfdp_runtime/logger.hpp>
+#include <cfdp_runtime/metrics.hpp>
+#include <cfdp_runtime/timer_service.hpp>
+#include <cfdp_runtime/tracing.hpp>
+
+#include <algorithm>
+
+namespace
+{
+[[nodiscard]] cfdp::runtime::metrics::Counter& expiredTimers()
+{
+    static auto& counter = cfdp::runtime::metrics::Registry::global().counter(
+        "cfdp_timers_expired_total", "Timers fired by the timer services.");
+    return counter;
+}
+} // namespace
+
+cfdp::runtime::timer::TimerService::TimerService(thread_pool::ThreadPool& pool,
+                                                 Clock::duration tickDuration)
+    : pool(pool), tick(std::max(tickDuration, Clock::duration{1})), epoch(Clock::now())
+{
+    logging::trace<log_module>("creating a timer service with a tick of {} ns",
+                               std::chrono::duration_cast<std::chrono::nanoseconds>(tick).count());
+
+    // Thread is started last, once every other member is initialized.
+    thread = std::thread{[this]() { run(); }};
+}
+
+cfdp::runtime::timer::TimerService::~TimerService()
+{
+    stop();
+}
+
+auto cfdp::runtime::timer::TimerService::scheduleAfter(Clock::duration delay,
+                                                       thread_pool::Task&& callback) -> TimerId
+{
+    return scheduleAt(Clock::now() + delay, std::move(callback));
+}
+
+auto cfdp::runtime::timer::TimerService::scheduleAt(Clock::time_point deadline,
+                                                    thread_pool::Task&& callback) -> TimerId
+{
+    const auto expiry = expiryTick(deadline);
+
+    std::scoped_lock<std::mutex> lock{mutex};
+
+    auto id = wheel.arm(expiry, std::move(callback));
+    notifyIfEarlier(expiry);
+
+    return id;
+}
+
+bool cfdp::runtime::timer::TimerService::cancel(TimerId id) noexcept
+{
+    std::scoped_lock<std::mutex> lock{mutex};
+    return wheel.cancel(id);
+}
+
+bool cfdp::runtime::timer::TimerService::rearm(TimerId id, Clock::duration delay) noexcept
+{
+    const auto expiry = expiryTick(Clock::now() + delay);
+
+    std::scoped_lock<std::mutex> lock{mutex};
+
+    if (!wheel.rearm(id, expiry))
+    {
+        return false;
+    }
+
+    notifyIfEarlier(expiry);
+
+    return true;
+}
+
+void cfdp::runtime::timer::TimerService::stop() noexcept
+{
+    {
+        std::scoped_lock<std::mutex> lock{mutex};
+
+        if (stopped)
+        {
+            return;
+        }
+        stopped = true;
+    }
+    wakeupCond.notify_one();
+
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+}
+
+size_t cfdp::runtime::timer::TimerService::sizeNow() const noexcept
+{
+    std::scoped_lock<std::mutex> lock{mutex};
+    return wheel.sizeNow();
+}
+
+uint64_t cfdp::runtime::timer::TimerService::expiryTick(Clock::time_point deadline) const noexcept
+{
+    if (deadline <= epoch)
+    {
+        return 0;
+    }
+
+    const auto elapsed = deadline - epoch;
+    return static_cast<uint64_t>((elapsed + tick - Clock::duration{1}) / tick);
+}
+
+uint64_t cfdp::runtime::timer::TimerService::currentTick() const noexcept
+{
+    return static_cast<uint64_t>((Clock::now() - epoch) / tick);
+}
+
+void cfdp::runtime::timer::TimerService::notifyIfEarlier(uint64_t expiry) noexcept
+{
+    // The service thread wakes up on its own for anything due later.
+    if (expiry < wakeupTick)
+    {
+        wakeupTick = expiry;
+        wakeupCond.notify_one();
+    }
+}
+
+void cfdp::runtime::timer::TimerService::run() noexcept
+{
+    tracing::setThreadName("cfdp timers");
+
+    auto expired = std::vector<thread_pool::Task>{};
+    auto lock    = std::unique_lock<std::mutex>{mutex};
+
+    while (!stopped)
+    {
+        if (wheel.advance(currentTick(), expired) > 0)
+        {
+            lock.unlock();
+
+            logging::trace<log_module>("{} timer(s) expired", expired.size());
+            expiredTimers().add(expired.size());
+            tracing::instant("timers expired", "timer", "count",
+                             static_cast<int64_t>(expired.size()));
+            pool.postBulk(std::move(expired));
+            expired = std::vector<thread_pool::Task>{};
+
+            lock.lock();
+            continue;
+        }
+
+        const auto next = wheel.nextExpiry();
+        wakeupTick      = next.value_or(no_wakeup);
+
+        if (next.has_value())
+        {
+            wakeupCond.wait_until(lock, epoch + tick * static_cast<Clock::rep>(next.value()));
+        }
+        else
+        {
+            wakeupCond.wait(lock);
+        }
+    }
+}
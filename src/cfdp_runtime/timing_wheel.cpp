@@ -0,0 +1,284 @@
+#include <cfdp_runtime/timing_wheel.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+cfdp::runtime::timer::TimingWheel::TimingWheel(uint64_t startTick) noexcept : current(startTick) {}
+
+auto cfdp::runtime::timer::TimingWheel::arm(uint64_t expiryTick, thread_pool::Task&& callback)
+    -> TimerId
+{
+    auto index = freeHead;
+
+    if (index == nil)
+    {
+        index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+    }
+    else
+    {
+        freeHead = nodes[index].next;
+    }
+
+    auto& node    = nodes[index];
+    node.callback = std::move(callback);
+    node.expiry   = std::max(expiryTick, current);
+
+    link(index);
+    ++numTimers;
+
+    return TimerId{.index = index, .generation = node.generation};
+}
+
+bool cfdp::runtime::timer::TimingWheel::cancel(TimerId id) noexcept
+{
+    if (!isArmed(id))
+    {
+        return false;
+    }
+
+    unlink(id.index);
+    nodes[id.index].callback = thread_pool::Task{};
+    release(id.index);
+    --numTimers;
+
+    return true;
+}
+
+bool cfdp::runtime::timer::TimingWheel::rearm(TimerId id, uint64_t expiryTick) noexcept
+{
+    if (!isArmed(id))
+    {
+        return false;
+    }
+
+    unlink(id.index);
+    nodes[id.index].expiry = std::max(expiryTick, current);
+    link(id.index);
+
+    return true;
+}
+
+size_t cfdp::runtime::timer::TimingWheel::advance(uint64_t tick,
+                                                  std::vector<thread_pool::Task>& expired)
+{
+    auto numExpired = size_t{0};
+
+    while (current <= tick)
+    {
+        numExpired += expireSlot(current & slot_mask, expired);
+
+        // Jump straight to the next occupied slot, or to the next cascade.
+        const auto target = nextEvent(true);
+
+        if (!target.has_value() || target.value() > tick)
+        {
+            current = tick + 1;
+        }
+        else
+        {
+            current = target.value();
+        }
+
+        for (size_t level = 1; level < num_levels; ++level)
+        {
+            if ((current & ((uint64_t{1} << (slot_bits * level)) - 1)) != 0)
+            {
+                break;
+            }
+            cascade(level);
+        }
+
+        if (current == 0)
+        {
+            // The tick counter wrapped around, there is nothing left to do.
+            break;
+        }
+    }
+
+    return numExpired;
+}
+
+auto cfdp::runtime::timer::TimingWheel::nextExpiry() const noexcept -> std::optional<uint64_t>
+{
+    return nextEvent(false);
+}
+
+bool cfdp::runtime::timer::TimingWheel::isArmed(TimerId id) const noexcept
+{
+    return id.index < nodes.size() && nodes[id.index].generation == id.generation &&
+           nodes[id.index].location != free_location;
+}
+
+void cfdp::runtime::timer::TimingWheel::reserve(size_t numTimers)
+{
+    nodes.reserve(numTimers);
+}
+
+void cfdp::runtime::timer::TimingWheel::link(uint32_t index) noexcept
+{
+    auto& node = nodes[index];
+
+    const auto delta     = std::min(node.expiry - current, max_delta);
+    const auto placement = current + delta;
+
+    auto level = size_t{0};
+    while (level + 1 < num_levels && delta >= (uint64_t{1} << (slot_bits * (level + 1))))
+    {
+        ++level;
+    }
+
+    const auto slot = (placement >> (slot_bits * level)) & slot_mask;
+    auto& wheel     = levels[level];
+
+    node.location = static_cast<uint16_t>(level * num_slots + slot);
+    node.prev     = nil;
+    node.next     = wheel.heads[slot];
+
+    if (node.next != nil)
+    {
+        nodes[node.next].prev = index;
+    }
+
+    wheel.heads[slot] = index;
+    wheel.occupied[slot / 64] |= uint64_t{1} << (slot % 64);
+}
+
+void cfdp::runtime::timer::TimingWheel::unlink(uint32_t index) noexcept
+{
+    auto& node       = nodes[index];
+    const auto level = node.location / num_slots;
+    const auto slot  = node.location % num_slots;
+    auto& wheel      = levels[level];
+
+    if (node.prev != nil)
+    {
+        nodes[node.prev].next = node.next;
+    }
+    else
+    {
+        wheel.heads[slot] = node.next;
+    }
+
+    if (node.next != nil)
+    {
+        nodes[node.next].prev = node.prev;
+    }
+
+    if (wheel.heads[slot] == nil)
+    {
+        wheel.occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+    }
+}
+
+void cfdp::runtime::timer::TimingWheel::release(uint32_t index) noexcept
+{
+    auto& node = nodes[index];
+
+    ++node.generation;
+    node.location = free_location;
+    node.prev     = nil;
+    node.next     = freeHead;
+    freeHead      = index;
+}
+
+void cfdp::runtime::timer::TimingWheel::cascade(size_t level) noexcept
+{
+    const auto slot = (current >> (slot_bits * level)) & slot_mask;
+    auto& wheel     = levels[level];
+    auto index      = std::exchange(wheel.heads[slot], nil);
+
+    wheel.occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+
+    while (index != nil)
+    {
+        const auto next = nodes[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+size_t cfdp::runtime::timer::TimingWheel::expireSlot(size_t slot,
+                                                     std::vector<thread_pool::Task>& expired)
+{
+    auto& wheel = levels[0];
+    auto index  = std::exchange(wheel.heads[slot], nil);
+    auto count  = size_t{0};
+
+    wheel.occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+
+    while (index != nil)
+    {
+        const auto next = nodes[index].next;
+
+        expired.push_back(std::move(nodes[index].callback));
+        release(index);
+        --numTimers;
+        ++count;
+
+        index = next;
+    }
+
+    return count;
+}
+
+auto cfdp::runtime::timer::TimingWheel::nextEvent(bool currentSlotDone) const noexcept
+    -> std::optional<uint64_t>
+{
+    if (numTimers == 0)
+    {
+        return std::nullopt;
+    }
+
+    // Only the lowest non-empty level matters, every level below it is
+    // empty, and every level above it cascades only after its last slot.
+    for (size_t level = 0; level < num_levels; ++level)
+    {
+        const auto shift = slot_bits * level;
+        const auto slot  = (current >> shift) & slot_mask;
+        const auto base  = (current >> shift) - slot;
+
+        // Slots of the upper levels at the current index were already
+        // cascaded, anything linked there belongs to the next rotation.
+        const auto from = (level == 0 && !currentSlotDone) ? slot : slot + 1;
+
+        if (const auto next = nextOccupied(levels[level], from))
+        {
+            return (base + next.value()) << shift;
+        }
+
+        if (!isEmpty(levels[level]))
+        {
+            return (base + num_slots) << shift;
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool cfdp::runtime::timer::TimingWheel::isEmpty(const Level& level) noexcept
+{
+    return std::ranges::all_of(level.occupied, [](uint64_t bits) { return bits == 0; });
+}
+
+auto cfdp::runtime::timer::TimingWheel::nextOccupied(const Level& level, size_t from) noexcept
+    -> std::optional<size_t>
+{
+    for (auto word = from / 64; word < level.occupied.size(); ++word)
+    {
+        auto bits = level.occupied[word];
+
+        if (word == from / 64)
+        {
+            bits &= ~uint64_t{0} << (from % 64);
+        }
+
+        if (bits != 0)
+        {
+            return word * 64 + static_cast<size_t>(std::countr_zero(bits));
+        }
+    }
+
+    return std::nullopt;
+}
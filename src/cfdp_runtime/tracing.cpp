@@ -0,0 +1,412 @@
+#include <cfdp_runtime/tracing.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+using ::cfdp::runtime::tracing::Event;
+
+// Slot of a single event. The fields are atomics, so an export can read a
+// slot the owner is overwriting, the copy is then thrown away.
+struct Slot
+{
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<const char*> argName{nullptr};
+    std::atomic<int64_t> argValue{0};
+    std::atomic<int64_t> timestamp{0};
+    std::atomic<int64_t> duration{0};
+    std::atomic_bool instant{false};
+
+    void store(const Event& event) noexcept
+    {
+        name.store(event.name, std::memory_order_relaxed);
+        category.store(event.category, std::memory_order_relaxed);
+        argName.store(event.argName, std::memory_order_relaxed);
+        argValue.store(event.argValue, std::memory_order_relaxed);
+        timestamp.store(event.timestamp, std::memory_order_relaxed);
+        duration.store(event.duration, std::memory_order_relaxed);
+        instant.store(event.instant, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] Event load() const noexcept
+    {
+        return Event{
+            .name      = name.load(std::memory_order_relaxed),
+            .category  = category.load(std::memory_order_relaxed),
+            .argName   = argName.load(std::memory_order_relaxed),
+            .argValue  = argValue.load(std::memory_order_relaxed),
+            .timestamp = timestamp.load(std::memory_order_relaxed),
+            .duration  = duration.load(std::memory_order_relaxed),
+            .instant   = instant.load(std::memory_order_relaxed),
+        };
+    }
+};
+
+// Events of a single thread during a single trace. Only the owner writes
+// them and it never takes a lock. It counts an event as started before
+// overwriting its slot and as finished after, an export keeps only the
+// events whose slots were not started over while it copied them.
+struct ThreadBuffer
+{
+    ThreadBuffer(size_t capacity, uint64_t trace) : slots(capacity), trace(trace) {}
+
+    std::vector<Slot> slots;
+    size_t next{0};
+
+    std::atomic<uint64_t> started{0};
+    std::atomic<uint64_t> finished{0};
+    std::atomic_bool exited{false};
+
+    uint64_t trace;
+    uint32_t thread{0};
+
+    // Guarded by the lock of the tracer.
+    std::string name{};
+};
+
+// Kept by every thread which used the tracer, the buffer is replaced by
+// a new one for every trace the thread records into.
+struct LocalThread
+{
+    LocalThread()                              = default;
+    LocalThread(const LocalThread&)            = delete;
+    LocalThread& operator=(LocalThread const&) = delete;
+    LocalThread(LocalThread&&)                 = delete;
+    LocalThread& operator=(LocalThread&&)      = delete;
+
+    ~LocalThread()
+    {
+        if (buffer != nullptr)
+        {
+            buffer->exited.store(true, std::memory_order_release);
+        }
+    }
+
+    std::shared_ptr<ThreadBuffer> buffer{};
+    std::string name{};
+    uint32_t thread{0};
+};
+
+class Tracer
+{
+  public:
+    static Tracer& instance()
+    {
+        // Never destroyed, threads can still record while exiting.
+        static auto* const tracer = new Tracer{}; // NOLINT(cppcoreguidelines-owning-memory)
+        return *tracer;
+    }
+
+    void start(size_t eventsPerThread)
+    {
+        std::scoped_lock<std::mutex> lock{mutex};
+
+        capacity = std::max(eventsPerThread, size_t{1});
+        origin   = ::cfdp::runtime::tracing::now();
+
+        // Threads allocate a new buffer once they record into this trace,
+        // the ones which do not, including every thread which exited, are
+        // left out of it.
+        buffers.clear();
+        trace.fetch_add(1, std::memory_order_release);
+    }
+
+    void record(const Event& event) noexcept
+    {
+        auto* const local = localBuffer();
+        if (local == nullptr)
+        {
+            return;
+        }
+
+        auto& buffer = *local;
+
+        const auto count = buffer.finished.load(std::memory_order_relaxed) + 1;
+
+        // Pairs with the fence in `copyEvents`.
+        buffer.started.store(count, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        buffer.slots[buffer.next].store(event);
+        buffer.finished.store(count, std::memory_order_release);
+
+        buffer.next = buffer.next + 1 == buffer.slots.size() ? 0 : buffer.next + 1;
+    }
+
+    void setThreadName(std::string name)
+    {
+        auto& local = localThread();
+        local.name  = std::move(name);
+
+        // A thread which is not traced only keeps the name, until it
+        // records its first event.
+        if (!::cfdp::runtime::tracing::isEnabled())
+        {
+            return;
+        }
+
+        auto* const buffer = localBuffer();
+        if (buffer == nullptr)
+        {
+            return;
+        }
+
+        std::scoped_lock<std::mutex> lock{mutex};
+        buffer->name = local.name;
+    }
+
+    std::string exportChromeJson()
+    {
+        auto out = std::string{R"({"displayTimeUnit":"ns","traceEvents":[)"};
+
+        const auto pid = ::getpid();
+        auto first     = true;
+        auto events    = std::vector<Event>{};
+
+        const auto separate = [&out, &first]() {
+            if (!first)
+            {
+                out.push_back(',');
+            }
+            first = false;
+        };
+
+        std::scoped_lock<std::mutex> lock{mutex};
+
+        for (const auto& buffer : buffers)
+        {
+            if (!buffer->name.empty())
+            {
+                separate();
+                out.append(
+                    std::format(R"({{"name":"thread_name","ph":"M","pid":{},"tid":{},"args":{{)",
+                                pid, buffer->thread));
+                out.append(R"("name":")");
+                appendEscaped(out, buffer->name);
+                out.append("\"}}");
+            }
+
+            copyEvents(*buffer, events);
+
+            for (const auto& event : events)
+            {
+                separate();
+                appendEvent(out, event, pid, buffer->thread);
+            }
+        }
+
+        // Exited threads cannot record any more, their events were just
+        // exported for the last time.
+        std::erase_if(buffers, [](const std::shared_ptr<ThreadBuffer>& buffer) {
+            return buffer->exited.load(std::memory_order_acquire);
+        });
+
+        out.append("]}\n");
+
+        return out;
+    }
+
+  private:
+    Tracer() = default;
+
+    static LocalThread& localThread() noexcept
+    {
+        thread_local auto local = LocalThread{};
+        return local;
+    }
+
+    // The buffer of a new trace is allocated outside the lock, so a thread
+    // joining the trace does not hold up the others. Without memory for it
+    // the thread stays out of the trace until an allocation succeeds.
+    ThreadBuffer* localBuffer() noexcept
+    {
+        auto& local = localThread();
+
+        if (local.buffer != nullptr &&
+            local.buffer->trace == trace.load(std::memory_order_acquire))
+        {
+            return local.buffer.get();
+        }
+
+        auto size    = size_t{0};
+        auto traceId = uint64_t{0};
+
+        {
+            std::scoped_lock<std::mutex> lock{mutex};
+
+            if (local.thread == 0)
+            {
+                local.thread = nextThread++;
+            }
+
+            size    = capacity;
+            traceId = trace.load(std::memory_order_relaxed);
+        }
+
+        try
+        {
+            auto buffer    = std::make_shared<ThreadBuffer>(size, traceId);
+            buffer->thread = local.thread;
+            buffer->name   = local.name;
+
+            {
+                std::scoped_lock<std::mutex> lock{mutex};
+
+                // A trace started in the meantime gets a buffer of its own
+                // with the next event.
+                if (trace.load(std::memory_order_relaxed) != traceId)
+                {
+                    return nullptr;
+                }
+
+                buffers.push_back(buffer);
+            }
+
+            local.buffer = std::move(buffer);
+        }
+        catch (const std::bad_alloc&)
+        {
+            return nullptr;
+        }
+
+        return local.buffer.get();
+    }
+
+    // Oldest events first, without the ones the owner overwrote meanwhile.
+    static void copyEvents(const ThreadBuffer& buffer, std::vector<Event>& events)
+    {
+        const auto size  = buffer.slots.size();
+        const auto end   = buffer.finished.load(std::memory_order_acquire);
+        const auto begin = end > size ? end - size : 0;
+
+        events.clear();
+        for (auto i = begin; i < end; ++i)
+        {
+            events.push_back(buffer.slots[i % size].load());
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        const auto started = buffer.started.load(std::memory_order_relaxed);
+        const auto valid   = started > size ? started - size : 0;
+
+        if (valid > begin)
+        {
+            events.erase(events.begin(),
+                         events.begin() + static_cast<std::ptrdiff_t>(
+                                              std::min(valid - begin, end - begin)));
+        }
+    }
+
+    static void appendEscaped(std::string& out, std::string_view text)
+    {
+        for (const auto c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out.push_back('\\');
+            }
+            out.push_back(c);
+        }
+    }
+
+    void appendEvent(std::string& out, const Event& event, int pid, uint32_t thread) const
+    {
+        // Chrome traces count in microseconds, fractions keep the precision.
+        const auto micros = [](int64_t nanos) { return static_cast<double>(nanos) / 1000.0; };
+
+        out.append(R"({"name":")");
+        appendEscaped(out, event.name == nullptr ? "" : event.name);
+        out.append(R"(","cat":")");
+        appendEscaped(out, event.category == nullptr ? "" : event.category);
+
+        if (event.instant)
+        {
+            std::format_to(std::back_inserter(out), R"(","ph":"i","s":"t","ts":{:.3f})",
+                           micros(event.timestamp - origin));
+        }
+        else
+        {
+            std::format_to(std::back_inserter(out), R"(","ph":"X","ts":{:.3f},"dur":{:.3f})",
+                           micros(event.timestamp - origin), micros(event.duration));
+        }
+
+        std::format_to(std::back_inserter(out), R"(,"pid":{},"tid":{})", pid, thread);
+
+        if (event.argName != nullptr)
+        {
+            out.append(R"(,"args":{")");
+            appendEscaped(out, event.argName);
+            std::format_to(std::back_inserter(out), R"(":{}}})", event.argValue);
+        }
+
+        out.push_back('}');
+    }
+
+    std::mutex mutex{};
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers{};
+    uint32_t nextThread{1};
+    size_t capacity{::cfdp::runtime::tracing::default_events_per_thread};
+    int64_t origin{0};
+
+    // Number of the current trace, read by the recording threads without
+    // the lock to find out whether their buffer is still part of it.
+    std::atomic<uint64_t> trace{0};
+};
+} // namespace
+
+void cfdp::runtime::tracing::start(size_t eventsPerThread)
+{
+    Tracer::instance().start(eventsPerThread);
+    tracing_enabled.store(true, std::memory_order_release);
+}
+
+void cfdp::runtime::tracing::stop() noexcept
+{
+    tracing_enabled.store(false, std::memory_order_release);
+}
+
+void cfdp::runtime::tracing::setThreadName(std::string name)
+{
+    Tracer::instance().setThreadName(std::move(name));
+}
+
+void cfdp::runtime::tracing::record(const Event& event) noexcept
+{
+    Tracer::instance().record(event);
+}
+
+std::string cfdp::runtime::tracing::exportChromeJson()
+{
+    return Tracer::instance().exportChromeJson();
+}
+
+void cfdp::runtime::tracing::exportToFile(const std::filesystem::path& path)
+{
+    const auto json = exportChromeJson();
+
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+
+    if (!file)
+    {
+        throw std::system_error{errno, std::system_category(), "could not write the trace"};
+    }
+}
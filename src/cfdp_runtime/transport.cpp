@@ -0,0 +1,86 @@
+#include <cfdp_runtime/transport.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+namespace
+{
+// Enough for a few read buffers worth of PDUs, the default is tuned for
+// small datagrams.
+constexpr int send_buffer_size = 8 << 20;
+} // namespace
+
+cfdp::runtime::io::UdpTransport::UdpTransport(const std::string& address, uint16_t port)
+{
+    auto receiver       = sockaddr_in{};
+    receiver.sin_family = AF_INET;
+    receiver.sin_port   = htons(port);
+
+    if (::inet_pton(AF_INET, address.c_str(), &receiver.sin_addr) != 1)
+    {
+        throw std::invalid_argument{"malformed IPv4 address"};
+    }
+
+    socket.reset(::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0));
+    if (!socket.isValid())
+    {
+        throw lastError("socket");
+    }
+
+    // Best effort, the kernel caps it at net.core.wmem_max.
+    ::setsockopt(socket.get(), SOL_SOCKET, SO_SNDBUF, &send_buffer_size, sizeof(send_buffer_size));
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (::connect(socket.get(), reinterpret_cast<const sockaddr*>(&receiver), sizeof(receiver)) !=
+        0)
+    {
+        throw lastError("connect");
+    }
+}
+
+void cfdp::runtime::io::UdpTransport::transmit(std::span<const OutgoingPdu> pdus)
+{
+    // Both parts of a PDU are gathered into a single datagram.
+    auto vectors  = std::array<std::array<iovec, 2>, max_batch_datagrams>{};
+    auto messages = std::array<mmsghdr, max_batch_datagrams>{};
+
+    while (!pdus.empty())
+    {
+        const auto count = std::min(pdus.size(), max_batch_datagrams);
+
+        for (auto i = size_t{0}; i < count; ++i)
+        {
+            const auto& [header, payload] = pdus[i];
+
+            // sendmmsg never writes through the iovec, the casts only drop const.
+            vectors[i][0] = iovec{const_cast<uint8_t*>(header.data()), header.size()};   // NOLINT
+            vectors[i][1] = iovec{const_cast<uint8_t*>(payload.data()), payload.size()}; // NOLINT
+
+            messages[i]                    = mmsghdr{};
+            messages[i].msg_hdr.msg_iov    = vectors[i].data();
+            messages[i].msg_hdr.msg_iovlen = vectors[i].size();
+        }
+
+        const auto sent = ::sendmmsg(socket.get(), messages.data(), count, 0);
+
+        if (sent < 0)
+        {
+            // A refused datagram only reports an earlier one, which nobody
+            // listened for, the current batch was not sent yet.
+            if (errno == EINTR || errno == ECONNREFUSED)
+            {
+                continue;
+            }
+            throw lastError("sendmmsg");
+        }
+
+        pdus = pdus.subspan(static_cast<size_t>(sent));
+    }
+}
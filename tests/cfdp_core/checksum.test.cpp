@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <cfdp_core/checksum.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+using ::cfdp::checksum::ModularChecksum;
+
+TEST(ModularChecksumTest, TestWordsAreBigEndian)
+{
+    const std::array<uint8_t, 5> data = {'a', 'b', 'c', 'd', 'e'};
+
+    auto checksum = ModularChecksum{};
+    checksum.update(0, data);
+
+    ASSERT_EQ(checksum.value(), 0x61626364u + 0x65000000u);
+}
+
+TEST(ModularChecksumTest, TestBytesFollowTheirOffset)
+{
+    const std::array<uint8_t, 2> data = {0x61, 0x62};
+
+    auto checksum = ModularChecksum{};
+    checksum.update(2, data);
+    checksum.update(5, data);
+
+    ASSERT_EQ(checksum.value(), 0x00006162 + 0x00616200);
+}
+
+TEST(ModularChecksumTest, TestSumWrapsAround)
+{
+    const std::array<uint8_t, 8> data = {0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x02};
+
+    auto checksum = ModularChecksum{};
+    checksum.update(0, data);
+
+    ASSERT_EQ(checksum.value(), 1);
+}
+
+TEST(ModularChecksumTest, TestSegmentsCanBeAddedInAnyOrder)
+{
+    auto data = std::vector<uint8_t>(1000);
+    std::iota(data.begin(), data.end(), uint8_t{7});
+
+    auto whole = ModularChecksum{};
+    whole.update(0, data);
+
+    // Segments of uneven sizes, so most of them start mid word.
+    auto offsets = std::vector<size_t>{};
+    for (auto offset = size_t{0}; offset < data.size(); offset += 37)
+    {
+        offsets.push_back(offset);
+    }
+    std::ranges::shuffle(offsets, std::mt19937{42});
+
+    auto segmented = ModularChecksum{};
+    for (const auto offset : offsets)
+    {
+        const auto size = std::min<size_t>(37, data.size() - offset);
+        segmented.update(offset, std::span<uint8_t const>{data}.subspan(offset, size));
+    }
+
+    ASSERT_EQ(segmented.value(), whole.value());
+}
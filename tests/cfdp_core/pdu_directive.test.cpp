@@ -15,10 +15,12 @@ using ::cfdp::pdu::exception::DecodeFromBytesException;
 using ::cfdp::pdu::exception::PduConstructionException;
 
 using ::cfdp::pdu::directive::Ack;
+using ::cfdp::pdu::directive::ChecksumType;
 using ::cfdp::pdu::directive::Condition;
 using ::cfdp::pdu::directive::Directive;
 using ::cfdp::pdu::directive::EndOfFile;
 using ::cfdp::pdu::directive::KeepAlive;
+using ::cfdp::pdu::directive::Metadata;
 using ::cfdp::pdu::directive::TransactionStatus;
 using ::cfdp::pdu::header::LargeFileFlag;
 
@@ -363,3 +365,76 @@ TEST_F(EndOfFileTest, TestDecodingWrongTLVType)
 
     ASSERT_THROW(EndOfFile(encoded, LargeFileFlag::SmallFile), DecodeFromBytesException);
 }
+
+class MetadataTest : public testing::Test
+{
+  protected:
+    static constexpr std::array<uint8_t, 20> encoded_small_frame = {
+        7, 0, 0, 0, 3, 232, 7, 115, 114, 99, 46, 98, 105, 110, 5, 47, 100, 115, 116, 47};
+    static constexpr std::array<uint8_t, 16> encoded_large_frame = {
+        7, 79, 255, 255, 255, 255, 255, 255, 255, 255, 1, 97, 3, 98, 99, 100};
+};
+
+TEST_F(MetadataTest, TestEncodingSmallFile)
+{
+    auto pdu = Metadata(false, ChecksumType::Modular, 1000, LargeFileFlag::SmallFile, "src.bin",
+                        "/dst/");
+    auto encoded = pdu.encodeToBytes();
+
+    ASSERT_EQ(pdu.getRawSize(), encoded_small_frame.size());
+    EXPECT_THAT(encoded, testing::ElementsAreArray(encoded_small_frame));
+}
+
+TEST_F(MetadataTest, TestEncodingLargeFile)
+{
+    auto pdu     = Metadata(true, ChecksumType::Null, UINT64_MAX, LargeFileFlag::LargeFile, "a",
+                            "bcd");
+    auto encoded = pdu.encodeToBytes();
+
+    ASSERT_EQ(pdu.getRawSize(), encoded_large_frame.size());
+    EXPECT_THAT(encoded, testing::ElementsAreArray(encoded_large_frame));
+}
+
+TEST_F(MetadataTest, TestDecodingSmallFile)
+{
+    auto encoded = std::span<uint8_t const>{encoded_small_frame.begin(), encoded_small_frame.end()};
+
+    auto pdu = Metadata(encoded, LargeFileFlag::SmallFile);
+
+    ASSERT_FALSE(pdu.closureRequested);
+    ASSERT_EQ(pdu.checksumType, ChecksumType::Modular);
+    ASSERT_EQ(pdu.fileSize, 1000);
+    ASSERT_EQ(pdu.sourceFileName, "src.bin");
+    ASSERT_EQ(pdu.destinationFileName, "/dst/");
+}
+
+TEST_F(MetadataTest, TestDecodingLargeFile)
+{
+    auto encoded = std::span<uint8_t const>{encoded_large_frame.begin(), encoded_large_frame.end()};
+
+    auto pdu = Metadata(encoded, LargeFileFlag::LargeFile);
+
+    ASSERT_TRUE(pdu.closureRequested);
+    ASSERT_EQ(pdu.checksumType, ChecksumType::Null);
+    ASSERT_EQ(pdu.fileSize, UINT64_MAX);
+    ASSERT_EQ(pdu.sourceFileName, "a");
+    ASSERT_EQ(pdu.destinationFileName, "bcd");
+}
+
+TEST_F(MetadataTest, TestDecodingWrongByteStreamSize)
+{
+    auto encoded =
+        std::span<uint8_t const>{encoded_small_frame.begin(), encoded_small_frame.end() - 1};
+
+    ASSERT_THROW(Metadata(encoded, LargeFileFlag::SmallFile), DecodeFromBytesException);
+}
+
+TEST_F(MetadataTest, TestConstructionExceptions)
+{
+    ASSERT_THROW(Metadata(false, ChecksumType::Modular, UINT64_MAX, LargeFileFlag::SmallFile, "a",
+                          "b"),
+                 PduConstructionException);
+    ASSERT_THROW(Metadata(false, ChecksumType::Modular, 0, LargeFileFlag::SmallFile,
+                          std::string(256, 'a'), "b"),
+                 PduConstructionException);
+}
@@ -0,0 +1,94 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_core/pdu_enums.hpp>
+#include <cfdp_core/pdu_exceptions.hpp>
+#include <cfdp_core/pdu_file_data.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using ::cfdp::pdu::exception::DecodeFromBytesException;
+using ::cfdp::pdu::exception::PduConstructionException;
+
+using ::cfdp::pdu::file_data::FileData;
+using ::cfdp::pdu::header::LargeFileFlag;
+
+class FileDataTest : public testing::Test
+{
+  protected:
+    static constexpr std::array<uint8_t, 3> file_data = {1, 2, 3};
+
+    static constexpr std::array<uint8_t, 7> encoded_small_frame = {0, 0, 4, 0, 1, 2, 3};
+    static constexpr std::array<uint8_t, 11> encoded_large_frame = {0, 0, 0, 1, 0,
+                                                                    0, 0, 0, 1, 2, 3};
+};
+
+TEST_F(FileDataTest, TestEncodingSmallFile)
+{
+    auto pdu     = FileData(1024, file_data, LargeFileFlag::SmallFile);
+    auto encoded = pdu.encodeToBytes();
+
+    ASSERT_EQ(pdu.getRawSize(), encoded_small_frame.size());
+    EXPECT_THAT(encoded, testing::ElementsAreArray(encoded_small_frame));
+}
+
+TEST_F(FileDataTest, TestEncodingLargeFile)
+{
+    auto pdu     = FileData(uint64_t{1} << 32, file_data, LargeFileFlag::LargeFile);
+    auto encoded = pdu.encodeToBytes();
+
+    ASSERT_EQ(pdu.getRawSize(), encoded_large_frame.size());
+    EXPECT_THAT(encoded, testing::ElementsAreArray(encoded_large_frame));
+}
+
+TEST_F(FileDataTest, TestEncodingOffsetOnly)
+{
+    auto pdu     = FileData(uint64_t{1} << 32, file_data, LargeFileFlag::LargeFile);
+    auto encoded = std::vector<uint8_t>{0xFF};
+
+    pdu.encodeOffsetInto(encoded);
+
+    ASSERT_EQ(encoded.size(), 1 + sizeof(uint64_t));
+    EXPECT_THAT(std::span{encoded}.subspan(1),
+                testing::ElementsAreArray(std::span{encoded_large_frame}.first(sizeof(uint64_t))));
+}
+
+TEST_F(FileDataTest, TestDecodingRefersToMemory)
+{
+    auto encoded = std::span<uint8_t const>{encoded_small_frame.begin(), encoded_small_frame.end()};
+
+    auto pdu = FileData(encoded, LargeFileFlag::SmallFile);
+
+    ASSERT_EQ(pdu.offset, 1024);
+    ASSERT_EQ(pdu.data.data(), encoded.data() + sizeof(uint32_t));
+    EXPECT_THAT(pdu.data, testing::ElementsAreArray(file_data));
+}
+
+TEST_F(FileDataTest, TestDecodingLargeFile)
+{
+    auto encoded = std::span<uint8_t const>{encoded_large_frame.begin(), encoded_large_frame.end()};
+
+    auto pdu = FileData(encoded, LargeFileFlag::LargeFile);
+
+    ASSERT_EQ(pdu.offset, uint64_t{1} << 32);
+    EXPECT_THAT(pdu.data, testing::ElementsAreArray(file_data));
+}
+
+TEST_F(FileDataTest, TestDecodingWrongByteStreamSize)
+{
+    auto encoded = std::span<uint8_t const>{encoded_small_frame.begin(), 3};
+
+    ASSERT_THROW(FileData(encoded, LargeFileFlag::SmallFile), DecodeFromBytesException);
+}
+
+TEST_F(FileDataTest, TestConstructionExceptions)
+{
+    const auto too_large = std::vector<uint8_t>(FileData::max_data_size + 1);
+
+    ASSERT_THROW(FileData(UINT32_MAX, file_data, LargeFileFlag::SmallFile),
+                 PduConstructionException);
+    ASSERT_THROW(FileData(0, too_large, LargeFileFlag::LargeFile), PduConstructionException);
+}
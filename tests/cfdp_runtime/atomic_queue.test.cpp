@@ -4,6 +4,7 @@
 #include <cfdp_runtime/atomic_queue.hpp>
 
 #include <array>
+#include <memory>
 #include <numeric>
 #include <ranges>
 #include <thread>
@@ -80,3 +81,27 @@ TEST_F(AtomicQueueTest, MultipleProducersSingleConsumer)
 
     EXPECT_THAT(items, UnorderedElementsAreArray(expected));
 }
+
+TEST_F(AtomicQueueTest, MoveOnlyItemsAreSupported)
+{
+    auto queue = AtomicQueue<std::unique_ptr<int>>{};
+
+    queue.emplace(std::make_unique<int>(1));
+    queue.emplace(std::make_unique<int>(2));
+
+    ASSERT_EQ(*queue.pop(), 1);
+    ASSERT_EQ(*queue.tryPop().value(), 2);
+    ASSERT_EQ(queue.sizeNow(), 0);
+}
+
+TEST_F(AtomicQueueTest, PopIfAnyReturnsNulloptOnlyWhenEmpty)
+{
+    auto queue = AtomicQueue<int>{};
+
+    ASSERT_FALSE(queue.popIfAny().has_value());
+
+    queue.push(1);
+
+    ASSERT_EQ(queue.popIfAny().value(), 1);
+    ASSERT_FALSE(queue.popIfAny().has_value());
+}
@@ -0,0 +1,176 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/channel.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using ::cfdp::runtime::channel::Channel;
+
+TEST(ChannelTest, ItemsArePoppedInFifoOrder)
+{
+    auto channel = Channel<int>{4};
+
+    ASSERT_TRUE(channel.push(1));
+    ASSERT_TRUE(channel.push(2));
+
+    ASSERT_EQ(channel.pop(), 1);
+    ASSERT_EQ(channel.tryPop(), 2);
+    ASSERT_EQ(channel.tryPop(), std::nullopt);
+}
+
+TEST(ChannelTest, TryPushFailsWhenFull)
+{
+    auto channel = Channel<int>{2};
+
+    ASSERT_TRUE(channel.tryPush(1));
+    ASSERT_TRUE(channel.tryPush(2));
+    ASSERT_FALSE(channel.tryPush(3));
+    ASSERT_EQ(channel.sizeNow(), 2);
+}
+
+TEST(ChannelTest, PushBlocksUntilThereIsSpace)
+{
+    auto channel = Channel<int>{1};
+    auto pushed  = std::atomic_bool{false};
+
+    channel.push(1);
+
+    auto producer = std::thread{[&]() {
+        channel.push(2);
+        pushed.store(true);
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_FALSE(pushed.load());
+
+    ASSERT_EQ(channel.pop(), 1);
+    producer.join();
+
+    ASSERT_TRUE(pushed.load());
+    ASSERT_EQ(channel.pop(), 2);
+}
+
+TEST(ChannelTest, PopForTimesOutOnEmptyChannel)
+{
+    auto channel = Channel<int>{1};
+
+    const auto start = std::chrono::steady_clock::now();
+    auto item        = channel.popFor(std::chrono::milliseconds(5));
+
+    ASSERT_EQ(item, std::nullopt);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(5));
+}
+
+TEST(ChannelTest, PopForReturnsItemPushedWhileWaiting)
+{
+    auto channel = Channel<int>{1};
+
+    auto producer = std::thread{[&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        channel.push(7);
+    }};
+
+    ASSERT_EQ(channel.popFor(std::chrono::seconds(1)), 7);
+    producer.join();
+}
+
+TEST(ChannelTest, CloseWakesUpBlockedConsumer)
+{
+    auto channel = Channel<int>{1};
+    auto item    = std::make_optional(0);
+
+    auto consumer = std::thread{[&]() { item = channel.pop(); }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    channel.close();
+    consumer.join();
+
+    ASSERT_EQ(item, std::nullopt);
+}
+
+TEST(ChannelTest, CloseWakesUpBlockedProducer)
+{
+    auto channel = Channel<int>{1};
+    auto result  = true;
+
+    channel.push(1);
+
+    auto producer = std::thread{[&]() { result = channel.push(2); }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    channel.close();
+    producer.join();
+
+    ASSERT_FALSE(result);
+}
+
+TEST(ChannelTest, QueuedItemsCanBePoppedAfterClose)
+{
+    auto channel = Channel<int>{2};
+
+    channel.push(1);
+    channel.close();
+
+    ASSERT_TRUE(channel.isClosed());
+    ASSERT_FALSE(channel.push(2));
+    ASSERT_EQ(channel.pop(), 1);
+    ASSERT_EQ(channel.pop(), std::nullopt);
+}
+
+TEST(ChannelTest, DrainIntoMovesAllItems)
+{
+    auto channel = Channel<std::unique_ptr<int>>{4};
+    auto items   = std::vector<std::unique_ptr<int>>{};
+
+    channel.emplace(std::make_unique<int>(1));
+    channel.emplace(std::make_unique<int>(2));
+
+    ASSERT_EQ(channel.drainInto(items), 2);
+    ASSERT_EQ(channel.sizeNow(), 0);
+    ASSERT_EQ(*items[0], 1);
+    ASSERT_EQ(*items[1], 2);
+}
+
+TEST(ChannelTest, PopAsyncTakesQueuedItemImmediately)
+{
+    auto channel = Channel<int>{2};
+    auto item    = std::optional<int>{};
+
+    channel.push(3);
+    channel.popAsync([&item](std::optional<int> popped) { item = popped; });
+
+    ASSERT_EQ(item, 3);
+}
+
+TEST(ChannelTest, PopAsyncIsCompletedByProducer)
+{
+    auto channel = Channel<int>{2};
+    auto item    = std::optional<int>{};
+
+    channel.popAsync([&item](std::optional<int> popped) { item = popped; });
+    ASSERT_EQ(item, std::nullopt);
+
+    channel.push(4);
+
+    ASSERT_EQ(item, 4);
+    ASSERT_EQ(channel.sizeNow(), 0);
+}
+
+TEST(ChannelTest, CloseCompletesPendingPopAsync)
+{
+    auto channel = Channel<int>{2};
+    auto called  = false;
+
+    channel.popAsync([&called](std::optional<int> popped) {
+        called = true;
+        EXPECT_EQ(popped, std::nullopt);
+    });
+    channel.close();
+
+    ASSERT_TRUE(called);
+}
@@ -0,0 +1,344 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/channel.hpp>
+#include <cfdp_runtime/coroutine.hpp>
+#include <cfdp_runtime/reactor.hpp>
+#include <cfdp_runtime/thread_pool.hpp>
+#include <cfdp_runtime/timer_service.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using ::cfdp::runtime::channel::Channel;
+using ::cfdp::runtime::coroutine::FrameAllocator;
+using ::cfdp::runtime::coroutine::pop;
+using ::cfdp::runtime::coroutine::ready;
+using ::cfdp::runtime::coroutine::schedule;
+using ::cfdp::runtime::coroutine::sleepFor;
+using ::cfdp::runtime::coroutine::spawn;
+using ::cfdp::runtime::coroutine::Task;
+using ::cfdp::runtime::coroutine::wait;
+using ::cfdp::runtime::future::Future;
+using ::cfdp::runtime::io::Reactor;
+using ::cfdp::runtime::thread_pool::ThreadPool;
+using ::cfdp::runtime::timer::TimerService;
+
+namespace
+{
+Task<int> answer()
+{
+    co_return 42;
+}
+
+Task<int> addToAnswer(int value)
+{
+    co_return co_await answer() + value;
+}
+
+Task<int> failing()
+{
+    throw std::runtime_error{"failed"};
+    co_return 0;
+}
+
+Task<std::thread::id> threadAfterSchedule(ThreadPool& pool)
+{
+    co_await schedule(pool);
+    co_return std::this_thread::get_id();
+}
+
+Task<int> awaitDispatchedTask(ThreadPool& pool)
+{
+    auto value = co_await wait(pool, pool.dispatchTask([]() { return 5; }));
+    co_return value * 2;
+}
+
+Task<int> sumChannel(ThreadPool& pool, Channel<int>& channel)
+{
+    auto sum = 0;
+
+    while (auto item = co_await pop(pool, channel))
+    {
+        sum += item.value();
+    }
+
+    co_return sum;
+}
+
+Task<TimerService::Clock::duration> measureSleep(TimerService& timers)
+{
+    const auto start = TimerService::Clock::now();
+    co_await sleepFor(timers, std::chrono::milliseconds(5));
+    co_return TimerService::Clock::now() - start;
+}
+
+Task<char> readWhenReady(Reactor& reactor, int fd)
+{
+    co_await ready(reactor, fd, ::cfdp::runtime::io::readable);
+
+    auto byte = char{};
+    EXPECT_EQ(::read(fd, &byte, 1), 1);
+
+    co_return byte;
+}
+
+Task<void> forward(ThreadPool& pool, Channel<int>& input, Channel<int>& output)
+{
+    auto item = co_await pop(pool, input);
+    output.push(item.value() + 1);
+}
+
+// Keeps the posted tasks, so the test decides whether they run or not.
+struct ManualExecutor
+{
+    void post(::cfdp::runtime::thread_pool::Task&& task) { tasks.push_back(std::move(task)); }
+
+    std::vector<::cfdp::runtime::thread_pool::Task> tasks{};
+};
+
+Task<int> holdUntilResumed(ManualExecutor& executor, std::shared_ptr<int> held)
+{
+    co_await schedule(executor);
+    co_return *held;
+}
+
+Task<int> awaitHeld(ManualExecutor& executor, std::shared_ptr<int> held)
+{
+    co_return co_await holdUntilResumed(executor, std::move(held));
+}
+} // namespace
+
+TEST(CoroutineTest, SpawnedTaskReturnsValue)
+{
+    auto pool = ThreadPool{2};
+
+    ASSERT_EQ(spawn(pool, answer()).get(), 42);
+}
+
+TEST(CoroutineTest, TaskCanAwaitAnotherTask)
+{
+    auto pool = ThreadPool{2};
+
+    ASSERT_EQ(spawn(pool, addToAnswer(3)).get(), 45);
+}
+
+TEST(CoroutineTest, ExceptionIsPropagatedToFuture)
+{
+    auto pool   = ThreadPool{2};
+    auto future = spawn(pool, failing());
+
+    EXPECT_THROW(auto _ = future.get(), std::runtime_error);
+}
+
+TEST(CoroutineTest, ScheduleResumesOnWorker)
+{
+    auto pool = ThreadPool{2};
+
+    ASSERT_NE(spawn(pool, threadAfterSchedule(pool)).get(), std::this_thread::get_id());
+}
+
+TEST(CoroutineTest, FutureCanBeAwaited)
+{
+    auto pool = ThreadPool{2};
+
+    ASSERT_EQ(spawn(pool, awaitDispatchedTask(pool)).get(), 10);
+}
+
+TEST(CoroutineTest, ChannelPopResumesOnPushAndClose)
+{
+    auto pool    = ThreadPool{2};
+    auto channel = Channel<int>{4};
+    auto future  = spawn(pool, sumChannel(pool, channel));
+
+    for (auto i = 1; i <= 100; ++i)
+    {
+        channel.push(i);
+    }
+    channel.close();
+
+    ASSERT_EQ(future.get(), 5050);
+}
+
+TEST(CoroutineTest, SleepResumesAfterDelay)
+{
+    auto pool   = ThreadPool{2};
+    auto timers = TimerService{pool};
+
+    ASSERT_GE(spawn(pool, measureSleep(timers)).get(), std::chrono::milliseconds(5));
+}
+
+TEST(CoroutineTest, ReadinessResumesWhenDescriptorIsReadable)
+{
+    auto pool    = ThreadPool{2};
+    auto reactor = Reactor{pool};
+    auto fds     = std::array<int, 2>{};
+
+    ASSERT_EQ(::pipe2(fds.data(), O_NONBLOCK | O_CLOEXEC), 0);
+
+    auto future = spawn(pool, readWhenReady(reactor, fds[0]));
+    ASSERT_EQ(::write(fds[1], "y", 1), 1);
+
+    ASSERT_EQ(future.get(), 'y');
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(CoroutineTest, ThousandsOfSuspendedTasksDoNotBlockWorkers)
+{
+    constexpr auto num_tasks = 5000;
+
+    auto pool    = ThreadPool{2};
+    auto input   = Channel<int>{num_tasks};
+    auto output  = Channel<int>{num_tasks};
+    auto futures = std::vector<Future<void>>{};
+
+    for (auto i = 0; i < num_tasks; ++i)
+    {
+        futures.push_back(spawn(pool, forward(pool, input, output)));
+    }
+
+    for (auto i = 0; i < num_tasks; ++i)
+    {
+        input.push(i);
+    }
+
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    auto sum = int64_t{0};
+
+    while (auto item = output.tryPop())
+    {
+        sum += item.value();
+    }
+
+    ASSERT_EQ(sum, int64_t{num_tasks} * (num_tasks + 1) / 2);
+}
+
+TEST(CoroutineTest, DroppedTaskBreaksItsFuture)
+{
+    auto future = std::optional<Future<int>>{};
+
+    {
+        auto pool = ThreadPool{1};
+        pool.shutdown();
+
+        future.emplace(spawn(pool, answer()));
+    }
+
+    EXPECT_THROW(auto _ = future->get(), std::future_error);
+}
+
+TEST(CoroutineTest, DroppedResumptionDestroysAwaitingCoroutines)
+{
+    auto executor = ManualExecutor{};
+    auto held     = std::make_shared<int>(1);
+    auto weak     = std::weak_ptr<int>{held};
+
+    auto future = spawn(executor, awaitHeld(executor, std::move(held)));
+
+    // Runs both coroutines up to the schedule, which posts their resumption.
+    auto start = std::move(executor.tasks.back());
+    executor.tasks.pop_back();
+    start();
+
+    ASSERT_EQ(executor.tasks.size(), 1);
+    ASSERT_FALSE(weak.expired());
+
+    executor.tasks.clear();
+
+    ASSERT_TRUE(weak.expired());
+    EXPECT_THROW(static_cast<void>(future.get()), std::future_error);
+}
+
+TEST(CoroutineTest, DroppedReadinessWaitDestroysAwaitingCoroutine)
+{
+    auto pool     = ThreadPool{1};
+    auto executor = ManualExecutor{};
+    auto fds      = std::array<int, 2>{};
+
+    ASSERT_EQ(::pipe2(fds.data(), O_NONBLOCK | O_CLOEXEC), 0);
+
+    auto future = std::optional<Future<char>>{};
+
+    {
+        auto reactor = Reactor{pool};
+        future.emplace(spawn(executor, readWhenReady(reactor, fds[0])));
+
+        // Runs the coroutine up to the readiness wait, which is then
+        // dropped together with the reactor.
+        auto start = std::move(executor.tasks.back());
+        executor.tasks.pop_back();
+        start();
+    }
+
+    EXPECT_THROW(static_cast<void>(future->get()), std::future_error);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(FrameAllocatorTest, ReleasedFrameIsReused)
+{
+    auto* first = FrameAllocator::allocate(100);
+    FrameAllocator::deallocate(first, 100);
+
+    auto* second = FrameAllocator::allocate(120);
+    FrameAllocator::deallocate(second, 120);
+
+    ASSERT_EQ(first, second);
+}
+
+TEST(FrameAllocatorTest, LargeFramesAreNotPooled)
+{
+    auto* frame = FrameAllocator::allocate(FrameAllocator::max_pooled_size + 1);
+
+    ASSERT_NE(frame, nullptr);
+    FrameAllocator::deallocate(frame, FrameAllocator::max_pooled_size + 1);
+}
+
+namespace
+{
+// Constructed before the frame cache of its thread is first used, so it is
+// destroyed after the cache when the thread exits.
+struct FrameFreedAtExit
+{
+    FrameFreedAtExit()                                   = default;
+    FrameFreedAtExit(const FrameFreedAtExit&)            = delete;
+    FrameFreedAtExit& operator=(FrameFreedAtExit const&) = delete;
+    FrameFreedAtExit(FrameFreedAtExit&&)                 = delete;
+    FrameFreedAtExit& operator=(FrameFreedAtExit&&)      = delete;
+
+    ~FrameFreedAtExit()
+    {
+        FrameAllocator::deallocate(frame, 100);
+        FrameAllocator::deallocate(FrameAllocator::allocate(100), 100);
+    }
+
+    void* frame{nullptr};
+};
+} // namespace
+
+TEST(FrameAllocatorTest, FramesCanBeFreedAfterTheCacheIsGone)
+{
+    auto thread = std::thread{[]() {
+        thread_local FrameFreedAtExit holder{};
+        holder.frame = FrameAllocator::allocate(100);
+    }};
+
+    thread.join();
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/file_sink.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace logging = ::cfdp::runtime::logging;
+
+namespace
+{
+class FileSinkTest : public ::testing::Test
+{
+  protected:
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() /
+        std::format("cfdp_file_sink_test_{}",
+                    ::testing::UnitTest::GetInstance()->current_test_info()->name());
+
+    FileSinkTest() { std::filesystem::remove_all(directory); }
+    ~FileSinkTest() override { std::filesystem::remove_all(directory); }
+
+    [[nodiscard]] logging::FileSinkOptions options() const
+    {
+        return logging::FileSinkOptions{
+            .directory = directory, .baseName = "test", .segmentSize = 4096};
+    }
+
+    [[nodiscard]] std::vector<std::string> segments() const
+    {
+        auto names = std::vector<std::string>{};
+        for (const auto& entry : std::filesystem::directory_iterator{directory})
+        {
+            names.push_back(entry.path().filename());
+        }
+        std::ranges::sort(names);
+        return names;
+    }
+
+    [[nodiscard]] std::string read(const std::string& name) const
+    {
+        auto file = std::ifstream{directory / name};
+        return std::string{std::istreambuf_iterator<char>{file}, {}};
+    }
+};
+} // namespace
+
+TEST_F(FileSinkTest, SegmentIsTruncatedToItsContents)
+{
+    {
+        auto sink = logging::MappedFileSink{options()};
+        ASSERT_EQ(std::filesystem::file_size(sink.currentPath()), 4096);
+
+        sink.write("first\n");
+        sink.write("second\n");
+        sink.flush();
+    }
+
+    ASSERT_EQ(segments(), std::vector<std::string>{"test.000000.log"});
+    ASSERT_EQ(read("test.000000.log"), "first\nsecond\n");
+}
+
+TEST_F(FileSinkTest, FullSegmentRotatesBetweenLines)
+{
+    const auto line = std::string(1000, 'x') + '\n';
+
+    {
+        auto sink = logging::MappedFileSink{options()};
+        sink.write(line + line + line + line + line);
+    }
+
+    ASSERT_EQ(segments(), (std::vector<std::string>{"test.000000.log", "test.000001.log"}));
+    ASSERT_EQ(read("test.000000.log"), line + line + line + line);
+    ASSERT_EQ(read("test.000001.log"), line);
+}
+
+TEST_F(FileSinkTest, OldSegmentsAreRemovedAndNeverOverwritten)
+{
+    auto opts        = options();
+    opts.maxSegments = 2;
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto sink = logging::MappedFileSink{opts};
+        sink.write(std::format("run {}\n", i));
+    }
+
+    ASSERT_EQ(segments(), (std::vector<std::string>{"test.000001.log", "test.000002.log"}));
+    ASSERT_EQ(read("test.000002.log"), "run 2\n");
+}
+
+TEST_F(FileSinkTest, OldSegmentRotatesOnWrite)
+{
+    auto opts          = options();
+    opts.maxSegmentAge = std::chrono::seconds{0};
+    opts.syncInterval  = std::chrono::milliseconds{0};
+
+    {
+        auto sink = logging::MappedFileSink{opts};
+        sink.write("first\n");
+        sink.write("second\n");
+    }
+
+    ASSERT_EQ(segments(), (std::vector<std::string>{"test.000000.log", "test.000001.log"}));
+    ASSERT_EQ(read("test.000001.log"), "second\n");
+}
+
+TEST_F(FileSinkTest, LoggerWritesIntoSegments)
+{
+    auto sink = std::make_unique<logging::MappedFileSink>(options());
+    const auto path = sink->currentPath();
+
+    logging::setSink(std::move(sink));
+    logging::log(logging::LogLevel::Info, "mapped {}", 42);
+    logging::setSink(std::make_unique<logging::StdoutSink>());
+
+    ASSERT_TRUE(read(path.filename()).ends_with("mapped 42\n"));
+}
@@ -2,10 +2,21 @@
 #include <gtest/gtest.h>
 
 #include <cfdp_runtime/future.hpp>
+#include <cfdp_runtime/thread_pool.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <future>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 using ::cfdp::runtime::future::Future;
+using ::cfdp::runtime::future::Promise;
+using ::cfdp::runtime::future::whenAll;
+using ::cfdp::runtime::future::whenAny;
+using ::cfdp::runtime::thread_pool::ThreadPool;
 
 class TestFuture : public ::testing::Test
 {
@@ -121,3 +132,174 @@ TEST_F(TestFuture, SharedFutureCanBeCopied)
     ASSERT_EQ(sharedFuture.get(), 1);
     ASSERT_EQ(secondFuture.get(), 1);
 }
+
+TEST_F(TestFuture, WaitForAcceptsAnyDuration)
+{
+    auto future = Future{std::move(testFuture)};
+
+    ASSERT_EQ(future.waitFor(std::chrono::milliseconds(1)), std::future_status::timeout);
+
+    testPromise.set_value(1);
+
+    ASSERT_EQ(future.waitFor(std::chrono::microseconds(0)), std::future_status::ready);
+}
+
+TEST_F(TestFuture, PlainFutureCannotBeChainedBeforeReady)
+{
+    auto future = Future{std::move(testFuture)};
+
+    EXPECT_THROW(std::move(future).onReady([](Future<int>&&) {}), std::future_error);
+}
+
+TEST(TestPromise, ContinuationRunsWhenPromiseIsSatisfied)
+{
+    auto promise = Promise<int>{};
+    auto value   = 0;
+
+    promise.getFuture().onReady([&value](Future<int>&& ready) { value = ready.get(); });
+
+    ASSERT_EQ(value, 0);
+    promise.setValue(3);
+    ASSERT_EQ(value, 3);
+}
+
+TEST(TestPromise, ContinuationRegisteredAfterCompletionRunsImmediately)
+{
+    auto promise = Promise<int>{};
+    auto future  = promise.getFuture();
+    auto value   = 0;
+
+    promise.setValue(4);
+    std::move(future).onReady([&value](Future<int>&& ready) { value = ready.get(); });
+
+    ASSERT_EQ(value, 4);
+}
+
+TEST(TestPromise, AbandonedPromiseBreaksFuture)
+{
+    auto future = std::make_optional<Future<int>>(Promise<int>{}.getFuture());
+    auto called = false;
+
+    std::move(*future).onReady([&called](Future<int>&& ready) {
+        called = true;
+        EXPECT_THROW(auto _ = ready.get(), std::future_error);
+    });
+
+    ASSERT_TRUE(called);
+}
+
+TEST(TestPromise, ThrowingContinuationDoesNotEscapePromise)
+{
+    auto promise = Promise<int>{};
+    auto called  = false;
+
+    promise.getFuture().onReady([&called](Future<int>&&) {
+        called = true;
+        throw std::runtime_error{"continuation failed"};
+    });
+
+    ASSERT_NO_THROW(promise.setValue(1));
+    ASSERT_TRUE(called);
+}
+
+TEST(TestPromise, MovedPromiseKeepsContinuation)
+{
+    auto promise = Promise<int>{};
+    auto value   = 0;
+
+    promise.getFuture().onReady([&value](Future<int>&& ready) { value = ready.get(); });
+
+    auto moved = std::move(promise);
+    moved.setValue(5);
+
+    ASSERT_EQ(value, 5);
+}
+
+TEST(TestPromise, ContinuationsCanBeChainedOnThreadPool)
+{
+    auto pool = ThreadPool{2};
+
+    auto future = pool.dispatchTask([]() { return 2; })
+                      .then(pool, [](int value) { return value * 3; })
+                      .then(pool, [](int value) { return std::to_string(value); });
+
+    ASSERT_EQ(future.get(), "6");
+}
+
+TEST(TestPromise, ContinuationOfVoidTaskGetsNoArguments)
+{
+    auto pool   = ThreadPool{2};
+    auto called = std::atomic_bool{false};
+
+    auto future = pool.dispatchTask([]() {}).then(pool, [&called]() { called.store(true); });
+
+    future.get();
+    ASSERT_TRUE(called.load());
+}
+
+TEST(TestPromise, ExceptionSkipsContinuation)
+{
+    auto pool   = ThreadPool{2};
+    auto called = std::atomic_bool{false};
+
+    auto future = pool.dispatchTask([]() -> int { throw std::runtime_error{"failed"}; })
+                      .then(pool, [&called](int value) {
+                          called.store(true);
+                          return value;
+                      });
+
+    EXPECT_THROW(auto _ = future.get(), std::runtime_error);
+    ASSERT_FALSE(called.load());
+}
+
+TEST(TestPromise, WhenAllCollectsValuesInOrder)
+{
+    auto pool    = ThreadPool{2};
+    auto futures = std::vector<Future<int>>{};
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        futures.push_back(pool.dispatchTask([i]() { return i; }));
+    }
+
+    auto values = whenAll(std::move(futures)).get();
+
+    ASSERT_THAT(values, ::testing::ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(TestPromise, WhenAllPropagatesException)
+{
+    auto pool    = ThreadPool{2};
+    auto futures = std::vector<Future<void>>{};
+
+    futures.push_back(pool.dispatchTask([]() {}));
+    futures.push_back(pool.dispatchTask([]() { throw std::runtime_error{"failed"}; }));
+
+    EXPECT_THROW(whenAll(std::move(futures)).get(), std::runtime_error);
+}
+
+TEST(TestPromise, WhenAllOfNothingIsReady)
+{
+    auto future = whenAll(std::vector<Future<int>>{});
+
+    ASSERT_TRUE(future.isReady());
+    ASSERT_TRUE(future.get().empty());
+}
+
+TEST(TestPromise, WhenAnyReturnsFirstReadyFuture)
+{
+    auto first   = Promise<int>{};
+    auto second  = Promise<int>{};
+    auto futures = std::vector<Future<int>>{};
+
+    futures.push_back(first.getFuture());
+    futures.push_back(second.getFuture());
+
+    auto any = whenAny(std::move(futures));
+    ASSERT_FALSE(any.isReady());
+
+    second.setValue(5);
+    first.setValue(1);
+
+    ASSERT_EQ(any.get(), std::make_pair(size_t{1}, 5));
+}
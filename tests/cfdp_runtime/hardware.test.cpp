@@ -0,0 +1,95 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/hardware.hpp>
+
+#include <sched.h>
+
+#include <cerrno>
+#include <thread>
+
+using ::cfdp::runtime::hardware::CpuSet;
+using ::cfdp::runtime::hardware::numaNodeCpus;
+using ::cfdp::runtime::hardware::numNumaNodes;
+using ::cfdp::runtime::hardware::parseCpuList;
+using ::cfdp::runtime::hardware::pinCurrentThread;
+using ::cfdp::runtime::hardware::preferNumaNode;
+
+namespace
+{
+// CPU sets of cgroups or of the caller do not have to include CPU 0.
+[[nodiscard]] int firstAllowedCpu()
+{
+    auto allowed = cpu_set_t{};
+    CPU_ZERO(&allowed);
+
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+    {
+        for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &allowed))
+            {
+                return cpu;
+            }
+        }
+    }
+
+    return 0;
+}
+} // namespace
+
+TEST(HardwareTest, CpuListIsParsed)
+{
+    ASSERT_THAT(parseCpuList("0-3,8,10-11\n"),
+                ::testing::Optional(::testing::ElementsAre(0, 1, 2, 3, 8, 10, 11)));
+    ASSERT_THAT(parseCpuList(""), ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST(HardwareTest, MalformedCpuListIsRejected)
+{
+    ASSERT_EQ(parseCpuList("0-"), std::nullopt);
+    ASSERT_EQ(parseCpuList("3-1"), std::nullopt);
+    ASSERT_EQ(parseCpuList("a,b"), std::nullopt);
+}
+
+TEST(HardwareTest, ThereIsAtLeastOneNumaNode)
+{
+    ASSERT_GE(numNumaNodes(), 1);
+}
+
+TEST(HardwareTest, NonExistentNumaNodeHasNoCpus)
+{
+    ASSERT_TRUE(numaNodeCpus(100'000).empty());
+}
+
+TEST(HardwareTest, ThreadCanBePinnedToSingleCpu)
+{
+    const auto cpu = firstAllowedCpu();
+
+    auto current = std::thread{[cpu]() {
+        ASSERT_TRUE(pinCurrentThread(CpuSet{static_cast<size_t>(cpu)}));
+        ASSERT_EQ(::sched_getcpu(), cpu);
+    }};
+
+    current.join();
+}
+
+TEST(HardwareTest, ThreadCanPreferFirstNumaNode)
+{
+    auto preferred = false;
+    auto error     = 0;
+
+    auto current = std::thread{[&preferred, &error]() {
+        preferred = preferNumaNode(0);
+        error     = errno;
+    }};
+    current.join();
+
+    // Containers often forbid or filter out the memory policy calls.
+    if (!preferred && (error == EPERM || error == ENOSYS))
+    {
+        GTEST_SKIP() << "set_mempolicy is not permitted";
+    }
+
+    ASSERT_TRUE(preferred);
+}
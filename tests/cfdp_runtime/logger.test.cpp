@@ -0,0 +1,252 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/logger.hpp>
+
+#include <chrono>
+#include <format>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Calls go through `logging::log` directly, the level macros are not
+// defined for the tests.
+namespace logging = ::cfdp::runtime::logging;
+
+namespace
+{
+struct Captured
+{
+    std::mutex mutex{};
+    std::string lines{};
+    size_t numWrites{0};
+    size_t numFlushes{0};
+};
+
+class CaptureSink final : public logging::LogSink
+{
+  public:
+    explicit CaptureSink(std::shared_ptr<Captured> captured) : captured(std::move(captured)) {}
+
+    void write(std::string_view lines) override
+    {
+        std::scoped_lock<std::mutex> lock{captured->mutex};
+        captured->lines.append(lines);
+        ++captured->numWrites;
+    }
+
+    void flush() override
+    {
+        std::scoped_lock<std::mutex> lock{captured->mutex};
+        ++captured->numFlushes;
+    }
+
+  private:
+    std::shared_ptr<Captured> captured;
+};
+
+class LoggerTest : public ::testing::Test
+{
+  protected:
+    std::shared_ptr<Captured> captured = std::make_shared<Captured>();
+
+    LoggerTest() { logging::setSink(std::make_unique<CaptureSink>(captured)); }
+    ~LoggerTest() override
+    {
+        logging::setLevel(logging::LogLevel::Trace);
+        logging::setSink(std::make_unique<logging::StdoutSink>());
+    }
+
+    [[nodiscard]] size_t count(std::string_view needle)
+    {
+        std::scoped_lock<std::mutex> lock{captured->mutex};
+
+        auto found = size_t{0};
+        for (auto pos = captured->lines.find(needle); pos != std::string::npos;
+             pos      = captured->lines.find(needle, pos + needle.size()))
+        {
+            ++found;
+        }
+        return found;
+    }
+};
+} // namespace
+
+TEST_F(LoggerTest, MessagesReachTheSink)
+{
+    logging::log(logging::LogLevel::Error, "answer is {}", 42);
+    logging::flush();
+
+    ASSERT_EQ(count("answer is 42\n"), 1);
+    ASSERT_EQ(count("[ERROR]"), 1);
+    ASSERT_GE(captured->numFlushes, 1);
+}
+
+TEST_F(LoggerTest, NoMessageIsLostUnderContention)
+{
+    constexpr auto num_threads  = 4;
+    constexpr auto num_messages = 5000;
+
+    auto threads = std::vector<std::jthread>{};
+
+    for (auto t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([t]() {
+            for (auto i = 0; i < num_messages; ++i)
+            {
+                logging::log(logging::LogLevel::Info, "producer {} message {}", t, i);
+            }
+            logging::flush();
+        });
+    }
+    threads.clear();
+
+    ASSERT_EQ(count("message"), num_threads * num_messages);
+    ASSERT_EQ(count("producer 2 message 4999\n"), 1);
+}
+
+TEST_F(LoggerTest, FlushWritesMessagesOfAllThreads)
+{
+    constexpr auto num_threads  = 8;
+    constexpr auto num_messages = 1000;
+
+    auto threads = std::vector<std::jthread>{};
+
+    for (auto t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([t]() {
+            for (auto i = 0; i < num_messages; ++i)
+            {
+                logging::log(logging::LogLevel::Info, "pending {} message {}", t, i);
+            }
+        });
+    }
+    threads.clear();
+
+    // More records than a single batch can be waiting in the rings.
+    logging::flush();
+
+    ASSERT_EQ(count("pending"), num_threads * num_messages);
+}
+
+TEST_F(LoggerTest, FlushCompletesWhileOtherThreadsKeepLogging)
+{
+    constexpr auto num_threads = 8;
+
+    auto threads = std::vector<std::jthread>{};
+
+    for (auto t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([](const std::stop_token& stop) {
+            while (!stop.stop_requested())
+            {
+                logging::log(logging::LogLevel::Info, "noise");
+            }
+        });
+    }
+
+    // Every batch is full from now on, the flush has to wait for the rings
+    // to be drained past the request, not for them to run empty.
+    while (count("noise") < 10'000)
+    {
+        std::this_thread::yield();
+    }
+
+    logging::log(logging::LogLevel::Info, "before flush");
+    auto flushed = std::async(std::launch::async, []() { logging::flush(); });
+
+    const auto status = flushed.wait_for(std::chrono::seconds(10));
+    const auto found  = count("before flush");
+
+    threads.clear();
+
+    ASSERT_EQ(status, std::future_status::ready);
+    ASSERT_EQ(found, 1);
+}
+
+TEST_F(LoggerTest, MessagesOfThreadStayInOrder)
+{
+    for (auto i = 0; i < 100; ++i)
+    {
+        logging::log(logging::LogLevel::Warn, "ordered {}", i);
+    }
+    logging::flush();
+
+    std::scoped_lock<std::mutex> lock{captured->mutex};
+    ASSERT_LT(captured->lines.find("ordered 9\n"), captured->lines.find("ordered 10\n"));
+    ASSERT_LT(captured->lines.find("ordered 10\n"), captured->lines.find("ordered 99\n"));
+}
+
+TEST_F(LoggerTest, PlainValuesAreFormattedOnBackend)
+{
+    static_assert(logging::Deferrable<int>);
+    static_assert(logging::Deferrable<double>);
+    static_assert(!logging::Deferrable<const char*>);
+    static_assert(!logging::Deferrable<std::string_view>);
+
+    const auto thread = std::this_thread::get_id();
+
+    logging::log(logging::LogLevel::Debug, "values {} {:.2f} {} {:>4}", int8_t{-3}, 2.5, true, 7u);
+    logging::log(logging::LogLevel::Debug, "thread {}", thread);
+    logging::log(logging::LogLevel::Debug, "no arguments {{}}");
+    logging::flush();
+
+    ASSERT_EQ(count("values -3 2.50 true    7\n"), 1);
+    ASSERT_EQ(count(std::format("thread {}\n", thread)), 1);
+    ASSERT_EQ(count("no arguments {}\n"), 1);
+}
+
+TEST_F(LoggerTest, StringsAreFormattedRightAway)
+{
+    {
+        auto transient = std::string{"short lived"};
+        logging::log(logging::LogLevel::Info, "{} and {}", transient, 5);
+    }
+    logging::flush();
+
+    ASSERT_EQ(count("short lived and 5\n"), 1);
+}
+
+TEST_F(LoggerTest, ThresholdsFilterPerModule)
+{
+    logging::setLevel(logging::LogModule::Reactor, logging::LogLevel::Warn);
+
+    logging::log(logging::LogModule::Reactor, logging::LogLevel::Info, "reactor info");
+    logging::log(logging::LogModule::Reactor, logging::LogLevel::Error, "reactor error");
+    logging::log(logging::LogModule::Timer, logging::LogLevel::Debug, "timer debug");
+    logging::flush();
+
+    ASSERT_EQ(count("reactor info"), 0);
+    ASSERT_EQ(count("reactor error"), 1);
+    ASSERT_EQ(count("timer debug"), 1);
+    ASSERT_TRUE(logging::isEnabled(logging::LogModule::General, logging::LogLevel::Trace));
+}
+
+TEST_F(LoggerTest, LevelsAreConfiguredFromSpec)
+{
+    ASSERT_TRUE(logging::configureLevels("error,thread_pool=debug"));
+    ASSERT_EQ(logging::level(logging::LogModule::General), logging::LogLevel::Error);
+    ASSERT_EQ(logging::level(logging::LogModule::Simulation), logging::LogLevel::Error);
+    ASSERT_EQ(logging::level(logging::LogModule::ThreadPool), logging::LogLevel::Debug);
+
+    ASSERT_FALSE(logging::configureLevels("timer=info,nonsense=trace,reactor=loud"));
+    ASSERT_EQ(logging::level(logging::LogModule::Timer), logging::LogLevel::Info);
+    ASSERT_EQ(logging::level(logging::LogModule::Reactor), logging::LogLevel::Error);
+}
+
+TEST_F(LoggerTest, TimestampsFollowWallClock)
+{
+    const auto before = std::format("{:%d-%m-%Y %H:%M}", std::chrono::system_clock::now());
+
+    logging::log(logging::LogLevel::Info, "stamped");
+    logging::flush();
+
+    const auto after = std::format("{:%d-%m-%Y %H:%M}", std::chrono::system_clock::now());
+
+    std::scoped_lock<std::mutex> lock{captured->mutex};
+    ASSERT_THAT(captured->lines.substr(0, before.size()), ::testing::AnyOf(before, after));
+}
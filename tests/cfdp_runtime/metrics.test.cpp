@@ -0,0 +1,163 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/metrics.hpp>
+#include <cfdp_runtime/thread_pool.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ::cfdp::runtime::metrics::Histogram;
+using ::cfdp::runtime::metrics::Registry;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+TEST(MetricsTest, CounterSumsUpdatesOfAllThreads)
+{
+    constexpr auto num_threads = 8;
+    constexpr auto num_updates = 10000;
+
+    auto registry = Registry{};
+    auto& counter = registry.counter("test_events_total", "Events.");
+
+    {
+        auto threads = std::vector<std::jthread>{};
+        for (auto t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&counter]() {
+                for (auto i = 0; i < num_updates; ++i)
+                {
+                    counter.add();
+                }
+            });
+        }
+    }
+
+    ASSERT_EQ(counter.value(), num_threads * num_updates);
+    ASSERT_EQ(&registry.counter("test_events_total", "Events."), &counter);
+}
+
+TEST(MetricsTest, HistogramBucketsBoundRelativeError)
+{
+    for (auto value : {uint64_t{0}, uint64_t{7}, uint64_t{15}, uint64_t{16}, uint64_t{1000},
+                       uint64_t{123456789}, uint64_t{1} << 40, ~uint64_t{0}})
+    {
+        const auto index = Histogram::bucketIndex(value);
+
+        ASSERT_LT(index, Histogram::num_buckets);
+        ASSERT_GE(Histogram::bucketUpperBound(index), value);
+        ASSERT_LE(Histogram::bucketUpperBound(index) - value, value / Histogram::sub_bucket_count);
+        if (index > 0)
+        {
+            ASSERT_LT(Histogram::bucketUpperBound(index - 1), value);
+        }
+    }
+
+    ASSERT_EQ(Histogram::bucketIndex(~uint64_t{0}), Histogram::num_buckets - 1);
+}
+
+TEST(MetricsTest, HistogramSnapshotGivesQuantiles)
+{
+    auto histogram = Histogram{};
+
+    for (auto value = uint64_t{1}; value <= 1000; ++value)
+    {
+        histogram.record(value);
+    }
+
+    const auto snapshot = histogram.snapshot();
+
+    ASSERT_EQ(snapshot.count, 1000);
+    ASSERT_EQ(snapshot.sum, 500500);
+    ASSERT_GE(snapshot.quantile(0.5), 500);
+    ASSERT_LE(snapshot.quantile(0.5), 500 + 500 / Histogram::sub_bucket_count);
+    ASSERT_GE(snapshot.quantile(1.0), 1000);
+    ASSERT_EQ(snapshot.quantile(0.0), 1);
+}
+
+TEST(MetricsTest, ExportUsesPrometheusTextFormat)
+{
+    auto registry = Registry{};
+
+    registry.counter("test_pdus_total", "PDUs sent.", {{"type", "file_data"}}).add(3);
+    registry.gauge("test_transactions", "Open transactions.").set(-2);
+    registry.histogram("test_latency_ns", "Latency.").record(100);
+    registry.callbackGauge("test_depth", "Queue depth.", {}, []() { return 4.0; });
+
+    const auto text = registry.exportText();
+
+    ASSERT_THAT(text, HasSubstr("# HELP test_pdus_total PDUs sent.\n"
+                                "# TYPE test_pdus_total counter\n"
+                                "test_pdus_total{type=\"file_data\"} 3\n"));
+    ASSERT_THAT(text, HasSubstr("# TYPE test_transactions gauge\ntest_transactions -2\n"));
+    ASSERT_THAT(text, HasSubstr("test_latency_ns_bucket{le=\"103\"} 1\n"
+                                "test_latency_ns_bucket{le=\"+Inf\"} 1\n"
+                                "test_latency_ns_sum 100\n"
+                                "test_latency_ns_count 1\n"));
+    ASSERT_THAT(text, HasSubstr("test_depth 4\n"));
+}
+
+TEST(MetricsTest, ConflictingRegistrationsAreRejected)
+{
+    auto registry = Registry{};
+    registry.counter("test_conflict", "Counter.");
+
+    ASSERT_THROW(registry.gauge("test_conflict", "Gauge."), std::invalid_argument);
+    ASSERT_THROW(registry.counter("0_invalid", "Counter."), std::invalid_argument);
+    ASSERT_THROW(registry.counter("test_labels", "Counter.", {{"bad-label", "x"}}),
+                 std::invalid_argument);
+
+    ASSERT_TRUE(registry.remove("test_conflict"));
+    ASSERT_FALSE(registry.remove("test_conflict"));
+    ASSERT_NO_THROW(registry.gauge("test_conflict", "Gauge."));
+}
+
+TEST(MetricsTest, SeriesCanBeRemovedByKey)
+{
+    auto registry = Registry{};
+
+    registry.counter("test_removed_total", "Counter.", {{"lane", "high"}, {"pool", "1"}});
+    registry.counter("test_removed_total", "Counter.", {{"lane", "low"}, {"pool", "1"}});
+
+    const auto key = Registry::seriesKey({{"pool", "1"}, {"lane", "high"}});
+
+    ASSERT_TRUE(registry.remove("test_removed_total", key));
+    ASSERT_FALSE(registry.remove("test_removed_total", key));
+    ASSERT_THAT(registry.exportText(), Not(HasSubstr("lane=\"high\"")));
+    ASSERT_THAT(registry.exportText(), HasSubstr("lane=\"low\""));
+}
+
+TEST(MetricsTest, ExportToFileReplacesIt)
+{
+    const auto path = std::filesystem::temp_directory_path() / "cfdp_metrics_test.prom";
+
+    auto registry = Registry{};
+    registry.counter("test_exported_total", "Exported.").add(7);
+    registry.exportToFile(path);
+
+    auto file = std::ifstream{path};
+    auto text = std::string{std::istreambuf_iterator<char>{file}, {}};
+
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(text, registry.exportText());
+}
+
+TEST(MetricsTest, ThreadPoolSeriesFollowItsLifetime)
+{
+    {
+        auto pool = cfdp::runtime::thread_pool::ThreadPool{2};
+        ASSERT_EQ(pool.dispatchTask([]() { return 1; }).get(), 1);
+
+        const auto text = Registry::global().exportText();
+        ASSERT_THAT(text, HasSubstr("# TYPE cfdp_thread_pool_tasks_executed_total counter"));
+        ASSERT_THAT(text, HasSubstr("cfdp_thread_pool_lane_depth{lane=\"high\",pool="));
+    }
+
+    ASSERT_THAT(Registry::global().exportText(), Not(HasSubstr("cfdp_thread_pool_lane_depth")));
+}
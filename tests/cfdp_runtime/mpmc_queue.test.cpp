@@ -0,0 +1,229 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/mpmc_queue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+using ::cfdp::runtime::atomic::MpmcQueue;
+using ::testing::ElementsAre;
+
+TEST(MpmcQueueTest, CapacityIsRoundedToPowerOfTwo)
+{
+    auto queue = MpmcQueue<int>{5};
+
+    ASSERT_EQ(queue.capacity(), 8);
+}
+
+TEST(MpmcQueueTest, ItemsArePoppedInFifoOrder)
+{
+    auto queue = MpmcQueue<int>{4};
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    ASSERT_EQ(queue.sizeNow(), 3);
+    ASSERT_EQ(queue.pop(), 1);
+    ASSERT_EQ(queue.tryPop(), 2);
+    ASSERT_EQ(queue.tryPop(), 3);
+    ASSERT_EQ(queue.tryPop(), std::nullopt);
+}
+
+TEST(MpmcQueueTest, TryPushFailsWhenFull)
+{
+    auto queue = MpmcQueue<int>{2};
+
+    ASSERT_TRUE(queue.tryPush(1));
+    ASSERT_TRUE(queue.tryPush(2));
+    ASSERT_FALSE(queue.tryPush(3));
+
+    ASSERT_EQ(queue.pop(), 1);
+    ASSERT_TRUE(queue.tryPush(3));
+}
+
+TEST(MpmcQueueTest, MoveOnlyItemsAreSupported)
+{
+    auto queue = MpmcQueue<std::unique_ptr<int>>{2};
+
+    queue.emplace(std::make_unique<int>(7));
+    auto item = queue.pop();
+
+    ASSERT_EQ(*item, 7);
+}
+
+TEST(MpmcQueueTest, BlockedPushResumesAfterPop)
+{
+    auto queue = MpmcQueue<int>{2};
+
+    queue.push(1);
+    queue.push(2);
+
+    auto pusher = std::thread{[&]() { queue.push(3); }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_EQ(queue.pop(), 1);
+    pusher.join();
+
+    ASSERT_EQ(queue.pop(), 2);
+    ASSERT_EQ(queue.pop(), 3);
+}
+
+TEST(MpmcQueueTest, PushNStopsWhenFull)
+{
+    auto queue = MpmcQueue<int>{4};
+    auto items = std::vector<int>{1, 2, 3, 4, 5, 6};
+
+    ASSERT_EQ(queue.pushN(items), 4);
+    ASSERT_EQ(queue.pushN(items), 0);
+
+    auto popped = std::vector<int>{};
+
+    ASSERT_EQ(queue.popN(std::back_inserter(popped), 3), 3);
+    ASSERT_EQ(queue.popN(std::back_inserter(popped), 3), 1);
+    ASSERT_EQ(queue.popN(std::back_inserter(popped), 3), 0);
+
+    EXPECT_THAT(popped, ElementsAre(1, 2, 3, 4));
+}
+
+TEST(MpmcQueueTest, NoItemLostWithMultipleProducersAndConsumers)
+{
+    constexpr auto items_per_producer = 2000;
+    constexpr auto num_producers      = 3;
+
+    auto queue    = MpmcQueue<int>{64};
+    auto mutex    = std::mutex{};
+    auto consumed = std::vector<int>{};
+    auto popped   = std::atomic<int>{0};
+
+    auto producer = [&](int base) {
+        auto batch = std::vector<int>{};
+        for (const auto i : std::views::iota(base, base + items_per_producer))
+        {
+            // Mix single and batched pushes.
+            if (i % 2 == 0)
+            {
+                queue.push(i);
+                continue;
+            }
+            batch.push_back(i);
+            if (batch.size() == 8)
+            {
+                auto pending = std::span<int>{batch};
+                while (!pending.empty())
+                {
+                    pending = pending.subspan(queue.pushN(pending));
+                    std::this_thread::yield();
+                }
+                batch.clear();
+            }
+        }
+        for (auto& item : batch)
+        {
+            queue.push(item);
+        }
+    };
+    auto consumer = [&]() {
+        auto local = std::vector<int>{};
+        while (popped.load() < num_producers * items_per_producer)
+        {
+            const auto count = queue.popN(std::back_inserter(local), 4);
+            popped.fetch_add(static_cast<int>(count));
+            if (count == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+        std::scoped_lock<std::mutex> lock{mutex};
+        consumed.insert(consumed.end(), local.begin(), local.end());
+    };
+
+    auto threads = std::array<std::thread, 5>{
+        std::thread{producer, 0},
+        std::thread{producer, items_per_producer},
+        std::thread{producer, 2 * items_per_producer},
+        std::thread{consumer},
+        std::thread{consumer},
+    };
+
+    for (auto& thread : threads)
+        thread.join();
+
+    auto expected = std::vector<int>(num_producers * items_per_producer);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::ranges::sort(consumed);
+
+    EXPECT_EQ(consumed, expected);
+}
+
+TEST(MpmcQueueTest, BlockingPopWakesUpWithManyConsumers)
+{
+    constexpr auto num_consumers      = 8;
+    constexpr auto num_producers      = 4;
+    constexpr auto items_per_consumer = 2000;
+    constexpr auto num_items          = num_consumers * items_per_consumer;
+
+    auto queue  = MpmcQueue<int>{2};
+    auto popped = std::atomic<int>{0};
+
+    auto consumers = std::vector<std::thread>{};
+    for (auto c = 0; c < num_consumers; ++c)
+    {
+        consumers.emplace_back([&]() {
+            for (auto i = 0; i < items_per_consumer; ++i)
+            {
+                static_cast<void>(queue.pop());
+                popped.fetch_add(1);
+            }
+        });
+    }
+
+    // Producers go quiet every few items, a consumer parked on the wrong
+    // cell would then sleep with items left in the queue.
+    auto producers = std::vector<std::thread>{};
+    for (auto p = 0; p < num_producers; ++p)
+    {
+        producers.emplace_back([&]() {
+            for (auto i = 0; i < num_items / num_producers; ++i)
+            {
+                queue.push(i);
+                if (i % 64 == 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (popped.load() < num_items && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto poppedInTime = popped.load();
+
+    // Wakes up consumers which are stuck, so they can be joined.
+    for (auto i = poppedInTime; i < num_items; ++i)
+    {
+        queue.push(0);
+    }
+    for (auto& consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    ASSERT_EQ(poppedInTime, num_items);
+}
@@ -0,0 +1,61 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/metrics.hpp>
+#include <cfdp_runtime/profiling.hpp>
+
+#include <chrono>
+#include <thread>
+
+namespace profiling = ::cfdp::runtime::profiling;
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+TEST(ProfilingTest, CalibrationFollowsSteadyClock)
+{
+    const auto startTime   = std::chrono::steady_clock::now();
+    const auto startCycles = profiling::readCycles();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+    const auto cycles = profiling::readCyclesOrdered() - startCycles;
+    const auto nanos  = std::chrono::duration<double, std::nano>{
+        std::chrono::steady_clock::now() - startTime}.count();
+
+    ASSERT_GT(profiling::nanosPerCycle(), 0.0);
+    ASSERT_NEAR(static_cast<double>(cycles) * profiling::nanosPerCycle() / nanos, 1.0, 0.1);
+}
+
+TEST(ProfilingTest, ScopesAreRecordedPerSite)
+{
+    auto& cycles = profiling::site("test.sleep");
+    ASSERT_EQ(&profiling::site("test.sleep"), &cycles);
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        const auto scope = profiling::Scope{cycles};
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    const auto snapshot = cycles.snapshot();
+    ASSERT_EQ(snapshot.count, 3);
+    ASSERT_GE(static_cast<double>(snapshot.quantile(0.0)) * profiling::nanosPerCycle(), 900'000);
+
+    ASSERT_THAT(profiling::report(), HasSubstr("test.sleep"));
+    ASSERT_THAT(cfdp::runtime::metrics::Registry::global().exportText(),
+                HasSubstr(R"(cfdp_profile_scope_cycles_count{scope="test.sleep"} 3)"));
+}
+
+TEST(ProfilingTest, MacroFollowsBuildOption)
+{
+    {
+        CFDP_PROFILE_SCOPE("test.macro");
+    }
+
+#ifdef CFDP_ENABLE_PROFILING
+    ASSERT_THAT(profiling::report(), HasSubstr("test.macro"));
+#else
+    ASSERT_THAT(profiling::report(), Not(HasSubstr("test.macro")));
+#endif
+}
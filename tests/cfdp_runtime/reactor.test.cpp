@@ -0,0 +1,216 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/reactor.hpp>
+#include <cfdp_runtime/thread_pool.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using ::cfdp::runtime::io::Dispatch;
+using ::cfdp::runtime::io::FileDescriptor;
+using ::cfdp::runtime::io::Reactor;
+using ::cfdp::runtime::io::readable;
+using ::cfdp::runtime::thread_pool::ThreadPool;
+
+class TestReactor : public ::testing::Test
+{
+  protected:
+    ThreadPool pool{2};
+    FileDescriptor readEnd;
+    FileDescriptor writeEnd;
+
+    TestReactor()
+    {
+        auto fds = std::array<int, 2>{};
+        EXPECT_EQ(::pipe2(fds.data(), O_NONBLOCK | O_CLOEXEC), 0);
+
+        readEnd  = FileDescriptor{fds[0]};
+        writeEnd = FileDescriptor{fds[1]};
+    }
+
+    void writeByte() { ASSERT_EQ(::write(writeEnd.get(), "x", 1), 1); }
+};
+
+TEST_F(TestReactor, InlineHandlerRunsOnReactorThread)
+{
+    auto reactor       = Reactor{pool};
+    auto called        = std::promise<std::thread::id>{};
+    auto reactorThread = std::promise<std::thread::id>{};
+    const auto fd      = readEnd.get();
+
+    reactor.watch(std::move(readEnd), readable, [&, fd](uint32_t events) {
+        auto byte = char{};
+        while (::read(fd, &byte, 1) == 1)
+        {
+        }
+        EXPECT_TRUE(events & readable);
+        called.set_value(std::this_thread::get_id());
+    });
+
+    reactor.post([&]() { reactorThread.set_value(std::this_thread::get_id()); });
+
+    writeByte();
+
+    auto calledOn = called.get_future();
+
+    ASSERT_EQ(calledOn.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_EQ(calledOn.get(), reactorThread.get_future().get());
+}
+
+TEST_F(TestReactor, PoolHandlerIsRearmedAfterItReturns)
+{
+    auto reactor  = Reactor{pool};
+    auto numReads = std::atomic<int>{0};
+    const auto fd = readEnd.get();
+
+    reactor.watch(
+        std::move(readEnd), readable,
+        [&, fd](uint32_t) {
+            auto byte = char{};
+            while (::read(fd, &byte, 1) == 1)
+            {
+                numReads.fetch_add(1);
+            }
+        },
+        Dispatch::Pool);
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        writeByte();
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (numReads.load() < i + 1 && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    ASSERT_EQ(numReads.load(), 3);
+}
+
+TEST_F(TestReactor, ModifyDoesNotRunPoolHandlerConcurrently)
+{
+    auto reactor   = Reactor{pool};
+    auto active    = std::atomic<int>{0};
+    auto maxActive = std::atomic<int>{0};
+    auto entered   = std::promise<void>{};
+    auto release   = std::promise<void>{};
+    auto gate      = release.get_future().share();
+    auto numCalls  = std::atomic<int>{0};
+    const auto fd  = readEnd.get();
+
+    reactor.watch(
+        std::move(readEnd), readable,
+        [&, fd](uint32_t) {
+            maxActive.store(std::max(maxActive.load(), active.fetch_add(1) + 1));
+            if (numCalls.fetch_add(1) == 0)
+            {
+                entered.set_value();
+                gate.wait();
+            }
+
+            auto byte = char{};
+            while (::read(fd, &byte, 1) == 1)
+            {
+            }
+            active.fetch_sub(1);
+        },
+        Dispatch::Pool);
+
+    writeByte();
+    ASSERT_EQ(entered.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    writeByte();
+    ASSERT_TRUE(reactor.modify(fd, readable));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    release.set_value();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(maxActive.load(), 1);
+}
+
+TEST_F(TestReactor, StopCanBeCalledFromReactorThread)
+{
+    auto stopped = std::promise<void>{};
+    auto reactor = Reactor{pool};
+
+    reactor.post([&reactor, &stopped]() {
+        reactor.stop();
+        stopped.set_value();
+    });
+
+    ASSERT_EQ(stopped.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
+
+TEST_F(TestReactor, WatchOnceFiresOnlyOnce)
+{
+    auto reactor  = Reactor{pool};
+    auto numCalls = std::atomic<int>{0};
+
+    reactor.watchOnce(readEnd.get(), readable, [&](uint32_t) { numCalls.fetch_add(1); });
+
+    writeByte();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    writeByte();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    ASSERT_EQ(numCalls.load(), 1);
+    ASSERT_EQ(reactor.sizeNow(), 0);
+}
+
+TEST_F(TestReactor, RemovedDescriptorIsClosed)
+{
+    auto reactor  = Reactor{pool};
+    const auto fd = reactor.watch(std::move(readEnd), readable, [](uint32_t) {});
+
+    ASSERT_TRUE(reactor.remove(fd));
+    ASSERT_FALSE(reactor.remove(fd));
+    ASSERT_EQ(::fcntl(fd, F_GETFD), -1);
+}
+
+TEST_F(TestReactor, PeriodicTimerFiresRepeatedly)
+{
+    auto reactor  = Reactor{pool};
+    auto numFired = std::atomic<int>{0};
+    auto fired    = std::promise<void>{};
+
+    reactor.addTimer(std::chrono::milliseconds(1), std::chrono::milliseconds(1), [&](uint32_t) {
+        if (numFired.fetch_add(1) == 2)
+        {
+            fired.set_value();
+        }
+    });
+
+    ASSERT_EQ(fired.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
+
+TEST_F(TestReactor, SignalledEventRunsHandler)
+{
+    auto reactor = Reactor{pool};
+    auto fired   = std::promise<void>{};
+
+    const auto event = reactor.addEvent([&](uint32_t) { fired.set_value(); }, Dispatch::Pool);
+    reactor.signal(event);
+
+    ASSERT_EQ(fired.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
+
+TEST_F(TestReactor, StopClosesOwnedDescriptors)
+{
+    auto reactor  = Reactor{pool};
+    const auto fd = reactor.watch(std::move(readEnd), readable, [](uint32_t) {});
+
+    reactor.stop();
+
+    ASSERT_EQ(reactor.sizeNow(), 0);
+    ASSERT_EQ(::fcntl(fd, F_GETFD), -1);
+}
@@ -0,0 +1,248 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_core/checksum.hpp>
+#include <cfdp_core/pdu_directive.hpp>
+#include <cfdp_core/pdu_enums.hpp>
+#include <cfdp_core/pdu_file_data.hpp>
+#include <cfdp_core/pdu_header.hpp>
+
+#include <cfdp_runtime/sender.hpp>
+#include <cfdp_runtime/thread_pool.hpp>
+#include <cfdp_runtime/transport.hpp>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace directive = ::cfdp::pdu::directive;
+namespace header    = ::cfdp::pdu::header;
+namespace io        = ::cfdp::runtime::io;
+namespace sender    = ::cfdp::runtime::sender;
+
+using ::cfdp::pdu::file_data::FileData;
+using ::cfdp::runtime::thread_pool::ThreadPool;
+
+namespace
+{
+class CapturingTransport final : public io::Transport
+{
+  public:
+    void transmit(std::span<const io::OutgoingPdu> pdus) override
+    {
+        std::scoped_lock<std::mutex> lock{mutex};
+
+        for (const auto& [header, payload] : pdus)
+        {
+            auto& pdu = transmitted.emplace_back(header.begin(), header.end());
+            pdu.insert(pdu.end(), payload.begin(), payload.end());
+        }
+    }
+
+    std::mutex mutex{};
+    std::vector<std::vector<uint8_t>> transmitted{};
+};
+
+class SenderTest : public ::testing::Test
+{
+  protected:
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        std::format("cfdp_sender_test_{}",
+                    ::testing::UnitTest::GetInstance()->current_test_info()->name());
+
+    ThreadPool pool{4};
+    CapturingTransport transport{};
+
+    ~SenderTest() override { std::filesystem::remove(path); }
+
+    [[nodiscard]] static std::vector<uint8_t> fileContent(size_t size)
+    {
+        auto content = std::vector<uint8_t>(size);
+        for (auto i = size_t{0}; i < size; ++i)
+        {
+            content[i] = static_cast<uint8_t>((i * 7) + (i >> 8));
+        }
+        return content;
+    }
+
+    void writeFile(std::span<const uint8_t> content) const
+    {
+        auto file = std::ofstream{path, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(content.data()), // NOLINT
+                   static_cast<std::streamsize>(content.size()));
+    }
+
+    [[nodiscard]] std::span<uint8_t const> dataField(size_t index) const
+    {
+        const auto& pdu      = transport.transmitted.at(index);
+        const auto pduHeader = header::PduHeader{pdu};
+        return std::span<uint8_t const>{pdu}.subspan(pduHeader.getRawSize());
+    }
+};
+} // namespace
+
+TEST_F(SenderTest, TestSendingFileInOrder)
+{
+    const auto content = fileContent(10'500);
+    writeFile(content);
+    auto fileSender = sender::Sender{
+        pool, transport, sender::SenderOptions{.segmentSize = 1000, .readSize = 4096}};
+
+    const auto summary = fileSender.send(path, 2).get();
+
+    auto checksum = cfdp::checksum::ModularChecksum{};
+    checksum.update(0, content);
+
+    ASSERT_EQ(summary.fileSize, content.size());
+    ASSERT_EQ(summary.fileDataPdus, 11);
+    ASSERT_EQ(summary.checksum, checksum.value());
+    ASSERT_EQ(transport.transmitted.size(), 13);
+
+    const auto first = header::PduHeader{transport.transmitted.front()};
+    ASSERT_EQ(first.pduType, header::PduType::FileDirective);
+    ASSERT_EQ(first.transmissionMode, header::TransmissionMode::Unacknowledged);
+    ASSERT_EQ(first.sourceEntityID, 1);
+    ASSERT_EQ(first.destinationEntityID, 2);
+    ASSERT_EQ(first.transactionSequenceNumber, summary.transaction);
+
+    const auto metadata = directive::Metadata{dataField(0), header::LargeFileFlag::SmallFile};
+    ASSERT_EQ(metadata.fileSize, content.size());
+    ASSERT_EQ(metadata.checksumType, directive::ChecksumType::Modular);
+    ASSERT_EQ(metadata.sourceFileName, path.string());
+    ASSERT_EQ(metadata.destinationFileName, path.filename().string());
+
+    // Read buffers are cut at a multiple of the segment size, so only the
+    // last segment of the file is short.
+    auto received = std::vector<uint8_t>{};
+    for (auto i = size_t{1}; i < transport.transmitted.size() - 1; ++i)
+    {
+        const auto pduHeader = header::PduHeader{transport.transmitted[i]};
+        ASSERT_EQ(pduHeader.pduType, header::PduType::FileData);
+
+        const auto fileData = FileData{dataField(i), header::LargeFileFlag::SmallFile};
+        ASSERT_EQ(fileData.offset, received.size());
+        ASSERT_EQ(pduHeader.pduDataFieldLength, fileData.getRawSize());
+        received.insert(received.end(), fileData.data.begin(), fileData.data.end());
+    }
+    ASSERT_EQ(received, content);
+
+    const auto eof = directive::EndOfFile{dataField(transport.transmitted.size() - 1),
+                                          header::LargeFileFlag::SmallFile};
+    ASSERT_EQ(eof.conditionCode, directive::Condition::NoError);
+    ASSERT_EQ(eof.fileSize, content.size());
+    ASSERT_EQ(eof.checksum, checksum.value());
+}
+
+TEST_F(SenderTest, TestSendingEmptyFile)
+{
+    writeFile(fileContent(0));
+    auto fileSender = sender::Sender{pool, transport};
+
+    const auto summary = fileSender.send(path, 2).get();
+
+    ASSERT_EQ(summary.fileSize, 0);
+    ASSERT_EQ(summary.fileDataPdus, 0);
+    ASSERT_EQ(transport.transmitted.size(), 2);
+
+    const auto eof = directive::EndOfFile{dataField(1), header::LargeFileFlag::SmallFile};
+    ASSERT_EQ(eof.fileSize, 0);
+    ASSERT_EQ(eof.checksum, 0);
+}
+
+TEST_F(SenderTest, TestTransactionsAreNumberedSeparately)
+{
+    writeFile(fileContent(3000));
+    auto fileSender = sender::Sender{pool, transport};
+
+    auto first  = fileSender.send(path, 2);
+    auto second = fileSender.send(path, 3);
+
+    ASSERT_NE(first.get().transaction, second.get().transaction);
+    ASSERT_EQ(transport.transmitted.size(), 2 * 5);
+}
+
+TEST_F(SenderTest, TestTransportFailureFailsTransfer)
+{
+    class FailingTransport final : public io::Transport
+    {
+      public:
+        void transmit(std::span<const io::OutgoingPdu> /*pdus*/) override
+        {
+            throw std::system_error{std::make_error_code(std::errc::network_unreachable)};
+        }
+    };
+
+    writeFile(fileContent(5000));
+    auto failing    = FailingTransport{};
+    auto fileSender = sender::Sender{pool, failing};
+
+    auto summary = fileSender.send(path, 2);
+    ASSERT_THROW(static_cast<void>(summary.get()), std::system_error);
+}
+
+TEST_F(SenderTest, TestInvalidRequestsAreRejected)
+{
+    auto fileSender = sender::Sender{pool, transport};
+
+    ASSERT_THROW(static_cast<void>(fileSender.send(path, 2)), std::system_error);
+
+    writeFile(fileContent(10));
+    ASSERT_THROW(static_cast<void>(fileSender.send(path, 1)), std::invalid_argument);
+    ASSERT_THROW(
+        sender::Sender(pool, transport, sender::SenderOptions{.segmentSize = UINT16_MAX}),
+        std::invalid_argument);
+}
+
+TEST_F(SenderTest, TestUdpTransportSendsDatagrams)
+{
+    auto receiver = io::FileDescriptor{::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0)};
+    ASSERT_TRUE(receiver.isValid());
+
+    auto address            = sockaddr_in{};
+    address.sin_family      = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    auto length             = socklen_t{sizeof(address)};
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    ASSERT_EQ(::bind(receiver.get(), reinterpret_cast<sockaddr*>(&address), length), 0);
+    ASSERT_EQ(::getsockname(receiver.get(), reinterpret_cast<sockaddr*>(&address), &length), 0);
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    auto udp = io::UdpTransport{"127.0.0.1", ntohs(address.sin_port)};
+    ASSERT_THROW(io::UdpTransport("localhost", 1), std::invalid_argument);
+
+    // A full File Data PDU has to fit a single datagram.
+    ASSERT_THROW(sender::Sender(pool, udp, sender::SenderOptions{.segmentSize = 65500}),
+                 std::invalid_argument);
+    ASSERT_NO_THROW(sender::Sender(pool, udp, sender::SenderOptions{.segmentSize = 65471}));
+
+    // The parts of a PDU are gathered into a single datagram.
+    const auto first     = std::array<uint8_t, 3>{1, 2, 3};
+    const auto second    = std::array<uint8_t, 2>{4, 5};
+    const auto pdus      = std::array<io::OutgoingPdu, 2>{{{.header = first},
+                                                           {.header = first, .payload = second}}};
+    const auto datagrams = std::array<std::vector<uint8_t>, 2>{{{1, 2, 3}, {1, 2, 3, 4, 5}}};
+
+    udp.transmit(pdus);
+
+    for (const auto& expected : datagrams)
+    {
+        auto datagram  = std::array<uint8_t, 16>{};
+        const auto got = ::recv(receiver.get(), datagram.data(), datagram.size(), 0);
+
+        ASSERT_EQ(got, expected.size());
+        ASSERT_THAT(std::span{datagram}.first(expected.size()),
+                    testing::ElementsAreArray(expected));
+    }
+}
@@ -0,0 +1,122 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/coroutine.hpp>
+#include <cfdp_runtime/simulation.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using ::cfdp::runtime::coroutine::sleepFor;
+using ::cfdp::runtime::coroutine::spawn;
+using ::cfdp::runtime::coroutine::Task;
+using ::cfdp::runtime::simulation::Scheduler;
+
+namespace
+{
+using namespace std::chrono_literals;
+
+Task<int> transfer(Scheduler& scheduler, int segments)
+{
+    for (auto i = 0; i < segments; ++i)
+    {
+        co_await sleepFor(scheduler, 10ms);
+    }
+    co_return segments;
+}
+
+std::vector<std::string> replay()
+{
+    auto scheduler = Scheduler{};
+    auto trace     = std::vector<std::string>{};
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        scheduler.scheduleAfter(std::chrono::milliseconds(30 - i * 10),
+                                [&trace, i]() { trace.push_back("timer " + std::to_string(i)); });
+        scheduler.post([&scheduler, &trace, i]() {
+            trace.push_back("task " + std::to_string(i));
+            scheduler.scheduleAfter(20ms, [&trace, i]() {
+                trace.push_back("nested " + std::to_string(i));
+            });
+        });
+    }
+
+    scheduler.runUntilIdle();
+
+    return trace;
+}
+} // namespace
+
+TEST(SimulationTest, TimersFireInVirtualTime)
+{
+    auto scheduler = Scheduler{};
+    auto fired     = std::vector<Scheduler::Clock::time_point>{};
+
+    scheduler.scheduleAfter(1h, [&]() { fired.push_back(scheduler.now()); });
+    scheduler.scheduleAfter(5ms, [&]() { fired.push_back(scheduler.now()); });
+
+    ASSERT_EQ(scheduler.runUntilIdle(), 2);
+    ASSERT_THAT(fired, ::testing::ElementsAre(Scheduler::Clock::time_point{5ms},
+                                              Scheduler::Clock::time_point{1h}));
+    ASSERT_EQ(scheduler.now(), Scheduler::Clock::time_point{1h});
+}
+
+TEST(SimulationTest, RunUntilStopsAtDeadline)
+{
+    auto scheduler = Scheduler{};
+    auto fired     = 0;
+
+    scheduler.scheduleAfter(10ms, [&fired]() { ++fired; });
+    scheduler.scheduleAfter(20ms, [&fired]() { ++fired; });
+    auto cancelled = scheduler.scheduleAfter(15ms, [&fired]() { ++fired; });
+
+    ASSERT_TRUE(scheduler.cancel(cancelled));
+    ASSERT_EQ(scheduler.runFor(10ms), 1);
+    ASSERT_EQ(scheduler.now(), Scheduler::Clock::time_point{10ms});
+    ASSERT_EQ(scheduler.runFor(5ms), 0);
+    ASSERT_EQ(scheduler.sizeNow(), 1);
+    ASSERT_EQ(scheduler.runFor(5ms), 1);
+    ASSERT_EQ(fired, 2);
+}
+
+TEST(SimulationTest, DispatchedTaskCompletesFuture)
+{
+    auto scheduler = Scheduler{};
+    auto future    = scheduler.dispatchTask([]() { return 42; });
+
+    ASSERT_FALSE(future.isReady());
+    ASSERT_TRUE(scheduler.step());
+    ASSERT_EQ(future.get(), 42);
+    ASSERT_FALSE(scheduler.step());
+}
+
+TEST(SimulationTest, CoroutinesSleepInVirtualTime)
+{
+    constexpr auto num_transfers = 10000;
+
+    auto scheduler = Scheduler{};
+    auto futures   = std::vector<cfdp::runtime::future::Future<int>>{};
+
+    for (auto i = 0; i < num_transfers; ++i)
+    {
+        futures.push_back(spawn(scheduler, transfer(scheduler, 1 + i % 100)));
+    }
+
+    scheduler.runUntilIdle();
+
+    for (auto i = 0; i < num_transfers; ++i)
+    {
+        ASSERT_EQ(futures[i].get(), 1 + i % 100);
+    }
+    ASSERT_EQ(scheduler.now(), Scheduler::Clock::time_point{1s});
+}
+
+TEST(SimulationTest, RunsAreReproducible)
+{
+    const auto first = replay();
+
+    ASSERT_EQ(first.size(), 9);
+    ASSERT_EQ(first, replay());
+}
@@ -0,0 +1,100 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/spsc_queue.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using ::cfdp::runtime::atomic::SpscQueue;
+using ::cfdp::runtime::atomic::WaitStrategy;
+
+TEST(SpscQueueTest, ItemsArePoppedInFifoOrder)
+{
+    auto queue = SpscQueue<int, 4>{};
+
+    ASSERT_TRUE(queue.tryPush(1));
+    ASSERT_TRUE(queue.tryPush(2));
+
+    ASSERT_EQ(queue.sizeNow(), 2);
+    ASSERT_EQ(queue.tryPop(), 1);
+    ASSERT_EQ(queue.pop(), 2);
+    ASSERT_EQ(queue.tryPop(), std::nullopt);
+}
+
+TEST(SpscQueueTest, TryPushFailsWhenFull)
+{
+    auto queue = SpscQueue<int, 2>{};
+
+    ASSERT_TRUE(queue.tryPush(1));
+    ASSERT_TRUE(queue.tryPush(2));
+    ASSERT_FALSE(queue.tryPush(3));
+
+    ASSERT_EQ(queue.pop(), 1);
+    ASSERT_TRUE(queue.tryPush(3));
+}
+
+TEST(SpscQueueTest, MoveOnlyItemsAreSupported)
+{
+    auto queue = SpscQueue<std::unique_ptr<int>, 2>{};
+
+    queue.emplace(std::make_unique<int>(3));
+
+    ASSERT_EQ(*queue.pop(), 3);
+}
+
+TEST(SpscQueueTest, ParkedConsumerIsWokenUp)
+{
+    auto queue = SpscQueue<int, 2>{};
+    auto item  = 0;
+
+    auto consumer = std::thread{[&]() { item = queue.pop(); }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    queue.push(42);
+    consumer.join();
+
+    ASSERT_EQ(item, 42);
+}
+
+template <WaitStrategy Wait>
+void transferItems()
+{
+    constexpr auto num_items = 100000;
+
+    auto queue    = SpscQueue<int, 64, Wait>{};
+    auto received = std::vector<int>{};
+    received.reserve(num_items);
+
+    auto consumer = std::thread{[&]() {
+        for (auto i = 0; i < num_items; ++i)
+        {
+            received.push_back(queue.pop());
+        }
+    }};
+
+    for (auto i = 0; i < num_items; ++i)
+    {
+        queue.push(i);
+    }
+
+    consumer.join();
+
+    ASSERT_EQ(received.size(), num_items);
+    for (auto i = 0; i < num_items; ++i)
+    {
+        ASSERT_EQ(received[i], i);
+    }
+}
+
+TEST(SpscQueueTest, ItemsAreTransferredInOrderWhenParking)
+{
+    transferItems<WaitStrategy::Park>();
+}
+
+TEST(SpscQueueTest, ItemsAreTransferredInOrderWhenSpinning)
+{
+    transferItems<WaitStrategy::Spin>();
+}
@@ -0,0 +1,123 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/task.hpp>
+
+#include <array>
+#include <memory>
+#include <utility>
+
+using ::cfdp::runtime::thread_pool::Task;
+
+TEST(TaskTest, TaskFitsSingleCacheLine)
+{
+    ASSERT_LE(sizeof(Task), 64);
+}
+
+TEST(TaskTest, EmptyTaskIsFalsy)
+{
+    auto task = Task{};
+
+    ASSERT_FALSE(task);
+}
+
+TEST(TaskTest, SmallFunctorIsStoredInline)
+{
+    auto value = 0;
+    auto func  = [&value]() { value = 1; };
+
+    ASSERT_TRUE(Task::isStoredInline<decltype(func)>());
+
+    auto task = Task{func};
+    task();
+
+    ASSERT_EQ(value, 1);
+}
+
+TEST(TaskTest, LargeFunctorIsStoredOnHeap)
+{
+    auto value = 0;
+    auto data  = std::array<int, 32>{};
+    data[31]   = 5;
+
+    auto func = [&value, data]() { value = data[31]; };
+
+    ASSERT_FALSE(Task::isStoredInline<decltype(func)>());
+
+    auto task = Task{func};
+    task();
+
+    ASSERT_EQ(value, 5);
+}
+
+TEST(TaskTest, MoveOnlyFunctorIsAccepted)
+{
+    auto value = 0;
+    auto owned = std::make_unique<int>(3);
+
+    auto task = Task{[&value, owned = std::move(owned)]() { value = *owned; }};
+    task();
+
+    ASSERT_EQ(value, 3);
+}
+
+TEST(TaskTest, MovedTaskKeepsFunctor)
+{
+    auto value = 0;
+    auto first = Task{[&value]() { value = 2; }};
+
+    auto second = std::move(first);
+
+    ASSERT_FALSE(first); // NOLINT(bugprone-use-after-move)
+    ASSERT_TRUE(second);
+
+    second();
+
+    ASSERT_EQ(value, 2);
+}
+
+TEST(TaskTest, FunctorIsDestroyedWithTask)
+{
+    auto tracker = std::make_shared<int>(0);
+
+    {
+        auto task = Task{[tracker]() {}};
+        ASSERT_EQ(tracker.use_count(), 2);
+
+        auto moved = Task{};
+        moved      = std::move(task);
+        ASSERT_EQ(tracker.use_count(), 2);
+    }
+
+    ASSERT_EQ(tracker.use_count(), 1);
+}
+
+TEST(TaskTest, CancelNotifiesCancellableFunctor)
+{
+    struct Cancellable
+    {
+        bool* cancelled;
+
+        void operator()() {}
+        void cancel() noexcept { *cancelled = true; }
+    };
+
+    auto cancelled = false;
+    auto task      = Task{Cancellable{&cancelled}};
+
+    task.cancel();
+
+    ASSERT_TRUE(cancelled);
+    ASSERT_FALSE(task);
+}
+
+TEST(TaskTest, CancelDropsPlainFunctor)
+{
+    auto counter = std::make_shared<int>(0);
+    auto task    = Task{[counter]() { ++*counter; }};
+
+    task.cancel();
+
+    ASSERT_FALSE(task);
+    ASSERT_EQ(counter.use_count(), 1);
+}
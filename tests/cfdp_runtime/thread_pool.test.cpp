@@ -3,12 +3,33 @@
 
 #include <cfdp_runtime/thread_pool.hpp>
 
+#include <sched.h>
+
+#include <atomic>
 #include <chrono>
+#include <ctime>
+#include <functional>
+#include <latch>
 #include <future>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <ranges>
+#include <set>
+#include <stop_token>
+#include <stdexcept>
+#include <system_error>
 #include <thread>
+#include <vector>
 
 using ::cfdp::runtime::future::Future;
+using ::cfdp::runtime::thread_pool::ElasticPolicy;
+using ::cfdp::runtime::thread_pool::LaneScheduling;
+using ::cfdp::runtime::thread_pool::Priority;
 using ::cfdp::runtime::thread_pool::ThreadPool;
+using ::cfdp::runtime::thread_pool::ShutdownMode;
+using ::cfdp::runtime::thread_pool::ThreadPoolOptions;
+using ::cfdp::runtime::thread_pool::WorkerPlacement;
 
 class ThreadPoolTest : public ::testing::Test
 {
@@ -89,3 +110,712 @@ TEST_F(ThreadPoolTest, NoMoreTasksScheduledAfterShutdown)
     ASSERT_TRUE(validFuture.isReady());
     ASSERT_FALSE(invalidFuture.isReady());
 }
+
+TEST_F(ThreadPoolTest, TaskCanDispatchNestedTasks)
+{
+    auto future = pool.dispatchTask([this]() {
+        auto nested = pool.dispatchTask([]() { return 2; });
+        return nested;
+    });
+
+    auto nested = future.get();
+
+    ASSERT_EQ(nested.get(), 2);
+}
+
+TEST_F(ThreadPoolTest, CapturesAreReleasedOnceTaskRan)
+{
+    auto captured = std::make_shared<int>(1);
+    auto weak     = std::weak_ptr<int>{captured};
+
+    pool.post([captured = std::move(captured)]() {});
+
+    // The node of the task is kept for the next one, its functor is not.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!weak.expired() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ASSERT_TRUE(weak.expired());
+}
+
+TEST(WorkStealingThreadPoolTest, NestedTasksAreStolenByIdleWorkers)
+{
+    auto pool    = ThreadPool{4};
+    auto workers = std::mutex{};
+    auto seen    = std::set<std::thread::id>{};
+
+    auto producer = pool.dispatchTask([&]() {
+        auto futures = std::vector<Future<int>>{};
+
+        for (auto i = 0; i < 64; ++i)
+        {
+            futures.push_back(pool.dispatchTask([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                std::scoped_lock<std::mutex> lock{workers};
+                seen.insert(std::this_thread::get_id());
+                return 1;
+            }));
+        }
+
+        return futures;
+    });
+
+    auto sum = 0;
+    for (auto& future : producer.get())
+    {
+        sum += future.get();
+    }
+
+    ASSERT_EQ(sum, 64);
+    // Every nested task was pushed into the producer's deque, anything
+    // executed elsewhere had to be stolen.
+    ASSERT_GT(seen.size(), 1);
+}
+
+TEST(WorkStealingThreadPoolTest, IdleWorkersDoNotSpin)
+{
+    auto pool = ThreadPool{4};
+
+    // Let the workers run out of spin rounds and park.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    const auto start = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const auto cpuTime = std::clock() - start;
+
+    // Four spinning workers would burn ~400 ms of CPU time here.
+    ASSERT_LT(cpuTime, CLOCKS_PER_SEC / 50);
+}
+
+TEST_F(ThreadPoolTest, VoidTaskCanBeDispatched)
+{
+    auto value  = 0;
+    auto future = pool.dispatchTask([&value]() { value = 1; });
+
+    future.get();
+
+    ASSERT_EQ(value, 1);
+}
+
+TEST_F(ThreadPoolTest, MoveOnlyFunctorCanBeDispatched)
+{
+    auto owned  = std::make_unique<int>(4);
+    auto future = pool.dispatchTask([owned = std::move(owned)]() { return *owned; });
+
+    ASSERT_EQ(future.get(), 4);
+}
+
+TEST_F(ThreadPoolTest, TaskExceptionIsPropagated)
+{
+    auto future = pool.dispatchTask([]() -> int { throw std::runtime_error{"task failed"}; });
+
+    EXPECT_THROW(auto _ = future.get(), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTest, BulkDispatchedTasksAreExecuted)
+{
+    auto functors = std::vector<std::function<int()>>{};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        functors.emplace_back([i]() { return i; });
+    }
+
+    auto futures = pool.dispatchBulk(functors);
+
+    ASSERT_EQ(futures.size(), 100);
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(futures[i].get(), i);
+    }
+}
+
+TEST_F(ThreadPoolTest, BulkDispatchMovesFunctorsOfRvalueRange)
+{
+    auto functors = std::vector<std::move_only_function<int()>>{};
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        functors.emplace_back([value = std::make_unique<int>(i)]() { return *value; });
+    }
+
+    auto futures = pool.dispatchBulk(std::move(functors));
+
+    ASSERT_EQ(futures.size(), 10);
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(futures[i].get(), i);
+    }
+}
+
+TEST(WorkStealingThreadPoolTest, BulkDispatchFromWorkerIsStolen)
+{
+    auto pool = ThreadPool{4};
+
+    auto producer = pool.dispatchTask([&pool]() {
+        auto range = std::views::iota(0, 32) | std::views::transform([](int i) {
+                         return [i]() {
+                             std::this_thread::sleep_for(std::chrono::microseconds(100));
+                             return i * 2;
+                         };
+                     });
+        return pool.dispatchBulk(range);
+    });
+
+    auto sum = 0;
+    for (auto& future : producer.get())
+    {
+        sum += future.get();
+    }
+
+    ASSERT_EQ(sum, 31 * 32);
+}
+
+namespace
+{
+// CPU sets of cgroups or of the caller do not have to include CPU 0.
+[[nodiscard]] int firstAllowedCpu()
+{
+    auto allowed = cpu_set_t{};
+    CPU_ZERO(&allowed);
+
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+    {
+        for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &allowed))
+            {
+                return cpu;
+            }
+        }
+    }
+
+    return 0;
+}
+} // namespace
+
+TEST(ThreadPoolPlacementTest, WorkersArePinnedToTheirCpus)
+{
+    const auto cpu = firstAllowedCpu();
+    auto pool      = ThreadPool{2, WorkerPlacement{.cpuSets = {{static_cast<size_t>(cpu)}}}};
+
+    auto futures = std::vector<Future<int>>{};
+    for (auto i = 0; i < 10; ++i)
+    {
+        futures.push_back(pool.dispatchTask([]() { return ::sched_getcpu(); }));
+    }
+
+    for (auto& future : futures)
+    {
+        ASSERT_EQ(future.get(), cpu);
+    }
+}
+
+TEST(ThreadPoolPlacementTest, WorkersCanBePlacedOnNumaNode)
+{
+    auto pool = ThreadPool{2, WorkerPlacement{.numaNode = 0}};
+
+    ASSERT_EQ(pool.dispatchTask([]() { return 1; }).get(), 1);
+}
+
+TEST(ThreadPoolPlacementTest, WorkersHaveLocalMemoryResource)
+{
+    auto pool = ThreadPool{1};
+
+    auto isLocal = pool.dispatchTask([]() {
+        auto* resource = ThreadPool::localMemoryResource();
+        auto buffer    = std::pmr::vector<int>(128, 0, resource);
+
+        return resource != std::pmr::get_default_resource();
+    });
+
+    ASSERT_TRUE(isLocal.get());
+    ASSERT_EQ(ThreadPool::localMemoryResource(), std::pmr::get_default_resource());
+}
+
+namespace
+{
+// Occupies the only worker of the pool until the returned promise is set,
+// so the tasks dispatched in the meantime stay queued in their lanes.
+std::promise<void> blockWorker(ThreadPool& pool)
+{
+    auto release = std::promise<void>{};
+    auto running = std::promise<void>{};
+
+    pool.post([gate = release.get_future().share(), &running]() {
+        running.set_value();
+        gate.wait();
+    });
+    running.get_future().wait();
+
+    return release;
+}
+} // namespace
+
+TEST(ThreadPoolPriorityTest, HighPriorityTasksRunFirst)
+{
+    auto pool    = ThreadPool{ThreadPoolOptions{.numWorkers = 1}};
+    auto release = blockWorker(pool);
+
+    auto order   = std::vector<int>{};
+    auto futures = std::vector<Future<void>>{};
+
+    futures.push_back(pool.dispatchTask(Priority::Low, [&order]() { order.push_back(3); }));
+    futures.push_back(pool.dispatchTask([&order]() { order.push_back(2); }));
+    futures.push_back(pool.dispatchTask(Priority::High, [&order]() { order.push_back(1); }));
+
+    ASSERT_EQ(pool.laneSize(Priority::High), 1);
+    ASSERT_EQ(pool.laneSize(Priority::Low), 1);
+
+    release.set_value();
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    ASSERT_THAT(order, ::testing::ElementsAre(1, 2, 3));
+}
+
+TEST(ThreadPoolPriorityTest, StrictSchedulingKeepsHighFirstUnderContention)
+{
+    constexpr auto numQueued = 2000;
+    constexpr auto numPushed = 20000;
+
+    auto options             = ThreadPoolOptions{.numWorkers = 1};
+    options.lanes.scheduling = LaneScheduling::Strict;
+
+    auto pool    = ThreadPool{std::move(options)};
+    auto release = blockWorker(pool);
+
+    auto highRun      = std::atomic<int>{0};
+    auto highRunAtLow = std::atomic<int>{-1};
+
+    for (auto i = 0; i < numQueued; ++i)
+    {
+        ASSERT_TRUE(pool.tryPost(Priority::High, [&highRun]() { ++highRun; }));
+    }
+    auto low = pool.dispatchTask(Priority::Low, [&highRun, &highRunAtLow]() {
+        highRunAtLow = highRun.load();
+    });
+
+    // Keeps the High lane lock busy while the worker drains it.
+    auto producer = std::thread{[&pool, &highRun]() {
+        for (auto i = 0; i < numPushed; ++i)
+        {
+            static_cast<void>(pool.tryPost(Priority::High, [&highRun]() { ++highRun; }));
+        }
+    }};
+
+    release.set_value();
+    low.get();
+    producer.join();
+
+    ASSERT_GE(highRunAtLow.load(), numQueued);
+}
+
+TEST(ThreadPoolPriorityTest, WeightedSchedulingDoesNotStarveLowLane)
+{
+    auto options                  = ThreadPoolOptions{.numWorkers = 1};
+    options.lanes.scheduling      = LaneScheduling::Weighted;
+    options.lanes.lanes[0].weight = 2;
+    options.lanes.lanes[2].weight = 1;
+
+    auto pool    = ThreadPool{std::move(options)};
+    auto release = blockWorker(pool);
+
+    auto order   = std::vector<Priority>{};
+    auto futures = std::vector<Future<void>>{};
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        futures.push_back(
+            pool.dispatchTask(Priority::Low, [&order]() { order.push_back(Priority::Low); }));
+    }
+    for (auto i = 0; i < 40; ++i)
+    {
+        futures.push_back(
+            pool.dispatchTask(Priority::High, [&order]() { order.push_back(Priority::High); }));
+    }
+
+    release.set_value();
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    // A round takes 2 High tasks and 1 Low one. The Normal lane stays empty
+    // and must not hold back the next round. So Low runs in every round
+    // until its lane is empty, and never after more than 2 High tasks.
+    auto lowPositions = std::vector<size_t>{};
+    for (auto i = size_t{0}; i < order.size(); ++i)
+    {
+        if (order[i] == Priority::Low)
+        {
+            lowPositions.push_back(i);
+        }
+    }
+
+    ASSERT_EQ(lowPositions.size(), 4);
+    ASSERT_LE(lowPositions.front(), 2);
+    for (auto i = size_t{1}; i < lowPositions.size(); ++i)
+    {
+        ASSERT_LE(lowPositions[i] - lowPositions[i - 1], 3);
+    }
+}
+
+TEST(ThreadPoolPriorityTest, FullLaneRejectsTasks)
+{
+    auto options                    = ThreadPoolOptions{.numWorkers = 1};
+    options.lanes.lanes[2].maxDepth = 2;
+
+    auto pool    = ThreadPool{std::move(options)};
+    auto release = blockWorker(pool);
+
+    auto first  = pool.dispatchTask(Priority::Low, []() { return 1; });
+    auto second = pool.dispatchTask(Priority::Low, []() { return 2; });
+    auto third  = pool.dispatchTask(Priority::Low, []() { return 3; });
+
+    ASSERT_FALSE(pool.tryPost(Priority::Low, []() {}));
+    ASSERT_TRUE(pool.tryPost(Priority::High, []() {}));
+    ASSERT_EQ(pool.laneSize(Priority::Low), 2);
+
+    release.set_value();
+
+    ASSERT_EQ(first.get(), 1);
+    ASSERT_EQ(second.get(), 2);
+    ASSERT_THROW(auto _ = third.get(), std::system_error);
+}
+
+TEST(ThreadPoolPriorityTest, PostedTasksAreNeverRejected)
+{
+    auto options                    = ThreadPoolOptions{.numWorkers = 1};
+    options.lanes.lanes[2].maxDepth = 1;
+
+    auto pool     = ThreadPool{std::move(options)};
+    auto release  = blockWorker(pool);
+    auto executed = std::atomic<int>{0};
+
+    ASSERT_TRUE(pool.tryPost(Priority::Low, [&executed]() { ++executed; }));
+    pool.post(Priority::Low, [&executed]() { ++executed; });
+    ASSERT_EQ(pool.laneSize(Priority::Low), 2);
+
+    release.set_value();
+    pool.shutdown(ShutdownMode::Drain);
+
+    ASSERT_EQ(executed.load(), 2);
+}
+
+TEST(ThreadPoolPriorityTest, ConcurrentProducersAreNeverRejectedByDefault)
+{
+    constexpr auto numProducers = 4;
+    constexpr auto numTasks     = 20000;
+
+    auto pool      = ThreadPool{ThreadPoolOptions{.numWorkers = 4}};
+    auto executed  = std::atomic<int>{0};
+    auto rejected  = std::atomic<int>{0};
+    auto producers = std::vector<std::thread>{};
+
+    for (auto i = 0; i < numProducers; ++i)
+    {
+        producers.emplace_back([&pool, &executed, &rejected]() {
+            for (auto j = 0; j < numTasks; ++j)
+            {
+                if (!pool.tryPost(Priority::Normal, [&executed]() { ++executed; }))
+                {
+                    ++rejected;
+                }
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    while (executed.load() + rejected.load() < numProducers * numTasks)
+    {
+        std::this_thread::yield();
+    }
+
+    ASSERT_EQ(rejected.load(), 0);
+    ASSERT_EQ(pool.laneSize(Priority::Normal), 0);
+}
+
+TEST(ThreadPoolPriorityTest, ConcurrentProducersDoNotOvershootLaneDepth)
+{
+    constexpr auto numProducers = 4;
+    constexpr auto maxDepth     = 100;
+
+    auto options                    = ThreadPoolOptions{.numWorkers = 1};
+    options.lanes.lanes[1].maxDepth = maxDepth;
+
+    auto pool      = ThreadPool{std::move(options)};
+    auto release   = blockWorker(pool);
+    auto accepted  = std::atomic<int>{0};
+    auto producers = std::vector<std::thread>{};
+
+    for (auto i = 0; i < numProducers; ++i)
+    {
+        producers.emplace_back([&pool, &accepted]() {
+            for (auto j = 0; j < maxDepth; ++j)
+            {
+                if (pool.tryPost(Priority::Normal, []() {}))
+                {
+                    ++accepted;
+                }
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_EQ(accepted.load(), maxDepth);
+    ASSERT_EQ(pool.laneSize(Priority::Normal), maxDepth);
+
+    release.set_value();
+}
+
+TEST(ElasticThreadPoolTest, WorkersAreStartedOnDemand)
+{
+    auto pool = ThreadPool{ThreadPoolOptions{.numWorkers = 4, .elastic = ElasticPolicy{}}};
+
+    ASSERT_EQ(pool.numWorkersNow(), 0);
+    ASSERT_EQ(pool.dispatchTask([]() { return 1; }).get(), 1);
+    ASSERT_EQ(pool.numWorkersNow(), 1);
+}
+
+TEST(ElasticThreadPoolTest, PoolGrowsWhenTasksWait)
+{
+    constexpr auto numTasks = 4;
+
+    auto pool = ThreadPool{ThreadPoolOptions{
+        .numWorkers = numTasks,
+        .elastic    = ElasticPolicy{.spawnLatency = std::chrono::microseconds{100}},
+    }};
+
+    // Every task waits for all the others, so they only finish once the
+    // pool has grown to run all of them at the same time.
+    auto together = std::latch{numTasks};
+    auto futures  = std::vector<Future<void>>{};
+
+    for (auto i = 0; i < numTasks; ++i)
+    {
+        futures.push_back(pool.dispatchTask([&together]() { together.arrive_and_wait(); }));
+    }
+
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    ASSERT_EQ(pool.numWorkersNow(), numTasks);
+}
+
+TEST(ElasticThreadPoolTest, IdleWorkersAreRetired)
+{
+    constexpr auto numTasks = 3;
+
+    auto pool = ThreadPool{ThreadPoolOptions{
+        .numWorkers = numTasks,
+        .elastic =
+            ElasticPolicy{
+                .minWorkers   = 1,
+                .spawnLatency = std::chrono::microseconds{100},
+                .idleTimeout  = std::chrono::milliseconds{20},
+            },
+    }};
+
+    auto together = std::latch{numTasks};
+    auto futures  = std::vector<Future<void>>{};
+
+    for (auto i = 0; i < numTasks; ++i)
+    {
+        futures.push_back(pool.dispatchTask([&together]() { together.arrive_and_wait(); }));
+    }
+
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    ASSERT_EQ(pool.numWorkersNow(), numTasks);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (pool.numWorkersNow() > 1 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+
+    ASSERT_EQ(pool.numWorkersNow(), 1);
+
+    // Retired slots are reused once the load comes back.
+    auto again = std::latch{numTasks};
+    futures.clear();
+
+    for (auto i = 0; i < numTasks; ++i)
+    {
+        futures.push_back(pool.dispatchTask([&again]() { again.arrive_and_wait(); }));
+    }
+
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+}
+
+namespace
+{
+void expectCancelled(Future<int>& future)
+{
+    try
+    {
+        auto _ = future.get();
+        FAIL() << "task was not cancelled";
+    }
+    catch (const std::system_error& error)
+    {
+        ASSERT_EQ(error.code(), std::errc::operation_canceled);
+    }
+}
+} // namespace
+
+TEST(ThreadPoolCancellationTest, CancelledTaskIsSkipped)
+{
+    auto pool    = ThreadPool{1};
+    auto release = blockWorker(pool);
+
+    auto source = std::stop_source{};
+    auto ran    = std::atomic_bool{false};
+
+    auto cancelled = pool.dispatchTask(source.get_token(), [&ran]() {
+        ran = true;
+        return 1;
+    });
+
+    auto other = pool.dispatchTask(Priority::Low, std::stop_token{}, []() { return 2; });
+
+    source.request_stop();
+    release.set_value();
+
+    expectCancelled(cancelled);
+    ASSERT_EQ(other.get(), 2);
+    ASSERT_FALSE(ran);
+}
+
+TEST(ThreadPoolCancellationTest, ShutdownCancelsQueuedTasks)
+{
+    auto pool    = ThreadPool{1};
+    auto release = blockWorker(pool);
+
+    auto queued = pool.dispatchTask([]() { return 1; });
+
+    auto stopping = std::jthread{[&pool]() { pool.shutdown(ShutdownMode::Cancel); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    release.set_value();
+    stopping.join();
+
+    expectCancelled(queued);
+}
+
+TEST(ThreadPoolCancellationTest, ShutdownDrainsQueuedTasks)
+{
+    auto pool    = ThreadPool{2};
+    auto release = blockWorker(pool);
+
+    auto counter = std::atomic<int>{0};
+    auto futures = std::vector<Future<void>>{};
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        futures.push_back(pool.dispatchTask([&pool, &counter]() {
+            ++counter;
+            pool.post([&counter]() { ++counter; });
+        }));
+    }
+
+    auto stopping = std::jthread{[&pool]() { pool.shutdown(ShutdownMode::Drain); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    release.set_value();
+    stopping.join();
+
+    ASSERT_EQ(counter.load(), 20);
+}
+
+TEST(ThreadPoolStatsTest, StatsAreOffByDefault)
+{
+    auto pool = ThreadPool{1};
+
+    ASSERT_FALSE(pool.stats().has_value());
+}
+
+TEST(ThreadPoolStatsTest, LatenciesAndLoadAreRecorded)
+{
+    auto pool    = ThreadPool{ThreadPoolOptions{.numWorkers = 1, .collectStats = true}};
+    auto release = blockWorker(pool);
+
+    auto futures = std::vector<Future<void>>{};
+    for (auto i = 0; i < 3; ++i)
+    {
+        futures.push_back(pool.dispatchTask(Priority::Low, []() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    release.set_value();
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    const auto stats = pool.stats();
+    ASSERT_TRUE(stats.has_value());
+
+    // The blocking task is the fourth one, it can still be finishing.
+    ASSERT_GE(stats->runTime.count, 3);
+    ASSERT_GE(stats->waitTime.count, 3);
+    ASSERT_GE(stats->runTime.quantile(0.5), 2'000'000);
+    ASSERT_GE(stats->waitTime.quantile(1.0), 5'000'000);
+    ASSERT_EQ(stats->laneHighWater[static_cast<size_t>(Priority::Low)], 3);
+
+    ASSERT_EQ(stats->workers.size(), 1);
+    ASSERT_GE(stats->workers[0].tasksRun, 3);
+    ASSERT_GE(stats->workers[0].busy, std::chrono::milliseconds(6));
+    ASSERT_GT(stats->workers[0].utilisation(), 0.0);
+    ASSERT_LE(stats->workers[0].utilisation(), 1.0);
+}
+
+TEST(ThreadPoolStatsTest, StealsAreCounted)
+{
+    auto pool = ThreadPool{ThreadPoolOptions{.numWorkers = 4, .collectStats = true}};
+
+    auto spawner = pool.dispatchTask([&pool]() {
+        auto nested = std::vector<Future<void>>{};
+        for (auto i = 0; i < 64; ++i)
+        {
+            nested.push_back(pool.dispatchTask(
+                []() { std::this_thread::sleep_for(std::chrono::microseconds(200)); }));
+        }
+        for (auto& future : nested)
+        {
+            future.get();
+        }
+    });
+    spawner.get();
+
+    auto steals = uint64_t{0};
+    for (const auto& worker : pool.stats()->workers)
+    {
+        steals += worker.steals;
+    }
+
+    ASSERT_GT(steals, 0);
+}
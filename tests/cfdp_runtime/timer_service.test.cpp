@@ -0,0 +1,85 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/thread_pool.hpp>
+#include <cfdp_runtime/timer_service.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using ::cfdp::runtime::thread_pool::ThreadPool;
+using ::cfdp::runtime::timer::TimerService;
+
+TEST(TimerServiceTest, TimerFiresOnThreadPoolAfterDelay)
+{
+    auto pool   = ThreadPool{2};
+    auto timers = TimerService{pool};
+    auto fired  = std::promise<std::thread::id>{};
+
+    const auto start = TimerService::Clock::now();
+    timers.scheduleAfter(std::chrono::milliseconds(5),
+                         [&fired]() { fired.set_value(std::this_thread::get_id()); });
+
+    auto firedFuture = fired.get_future();
+
+    ASSERT_EQ(firedFuture.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_GE(TimerService::Clock::now() - start, std::chrono::milliseconds(5));
+    ASSERT_NE(firedFuture.get(), std::this_thread::get_id());
+}
+
+TEST(TimerServiceTest, EarlierTimerWakesUpService)
+{
+    auto pool   = ThreadPool{2};
+    auto timers = TimerService{pool};
+    auto fired  = std::promise<void>{};
+
+    timers.scheduleAfter(std::chrono::hours(1), []() {});
+    timers.scheduleAfter(std::chrono::milliseconds(1), [&fired]() { fired.set_value(); });
+
+    ASSERT_EQ(fired.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_EQ(timers.sizeNow(), 1);
+}
+
+TEST(TimerServiceTest, CancelledTimerNeverFires)
+{
+    auto pool   = ThreadPool{2};
+    auto timers = TimerService{pool};
+    auto fired  = std::atomic_bool{false};
+
+    auto id = timers.scheduleAfter(std::chrono::milliseconds(5), [&fired]() { fired.store(true); });
+
+    ASSERT_TRUE(timers.cancel(id));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    ASSERT_FALSE(fired.load());
+    ASSERT_FALSE(timers.cancel(id));
+}
+
+TEST(TimerServiceTest, RearmPushesTimerBack)
+{
+    auto pool   = ThreadPool{2};
+    auto timers = TimerService{pool};
+    auto fired  = std::atomic_bool{false};
+
+    auto id =
+        timers.scheduleAfter(std::chrono::milliseconds(10), [&fired]() { fired.store(true); });
+
+    ASSERT_TRUE(timers.rearm(id, std::chrono::hours(1)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    ASSERT_FALSE(fired.load());
+    ASSERT_EQ(timers.sizeNow(), 1);
+}
+
+TEST(TimerServiceTest, PendingTimersAreDroppedOnStop)
+{
+    auto pool   = ThreadPool{2};
+    auto timers = TimerService{pool};
+
+    timers.scheduleAfter(std::chrono::hours(1), []() {});
+    timers.stop();
+
+    ASSERT_EQ(timers.sizeNow(), 1);
+}
@@ -0,0 +1,210 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/timing_wheel.hpp>
+
+#include <random>
+#include <vector>
+
+using ::cfdp::runtime::thread_pool::Task;
+using ::cfdp::runtime::timer::TimerId;
+using ::cfdp::runtime::timer::TimingWheel;
+
+namespace
+{
+// Advances the wheel tick by tick, running the callbacks after every tick.
+void advanceAndRecord(TimingWheel& wheel, uint64_t tick)
+{
+    auto expired = std::vector<Task>{};
+
+    while (wheel.currentTick() <= tick)
+    {
+        wheel.advance(wheel.currentTick(), expired);
+
+        for (auto& callback : expired)
+        {
+            callback();
+        }
+        expired.clear();
+    }
+}
+
+// Arms random timers and checks every one fires in the advance covering its tick.
+void expectExactExpiries(size_t numTimers, uint64_t maxTick, uint64_t maxStep)
+{
+    auto wheel   = TimingWheel{};
+    auto random  = std::mt19937_64{7};
+    auto ticks   = std::uniform_int_distribution<uint64_t>{0, maxTick};
+    auto expiry  = std::vector<uint64_t>(numTimers, 0);
+    auto fired   = std::vector<size_t>{};
+    auto expired = std::vector<Task>{};
+
+    wheel.reserve(numTimers);
+
+    for (size_t i = 0; i < numTimers; ++i)
+    {
+        expiry[i] = ticks(random);
+        wheel.arm(expiry[i], [&fired, i]() { fired.push_back(i); });
+    }
+
+    // Advance in irregular steps, like a thread waking up late would.
+    auto steps      = std::uniform_int_distribution<uint64_t>{0, maxStep};
+    auto totalFired = size_t{0};
+
+    while (wheel.sizeNow() > 0)
+    {
+        const auto from = wheel.currentTick();
+        const auto to   = from + steps(random);
+
+        wheel.advance(to, expired);
+
+        for (auto& callback : expired)
+        {
+            callback();
+        }
+        expired.clear();
+
+        for (auto i : fired)
+        {
+            ASSERT_GE(expiry[i], from) << i;
+            ASSERT_LE(expiry[i], to) << i;
+        }
+
+        totalFired += fired.size();
+        fired.clear();
+    }
+
+    ASSERT_EQ(totalFired, numTimers);
+}
+} // namespace
+
+TEST(TimingWheelTest, TimerFiresAtItsTick)
+{
+    auto wheel   = TimingWheel{};
+    auto firedAt = uint64_t{0};
+
+    wheel.arm(10, [&]() { firedAt = wheel.currentTick(); });
+    advanceAndRecord(wheel, 20);
+
+    // The wheel is already past the tick when callbacks are run.
+    ASSERT_EQ(firedAt, 11);
+    ASSERT_EQ(wheel.sizeNow(), 0);
+}
+
+TEST(TimingWheelTest, TimerDoesNotFireEarly)
+{
+    auto wheel   = TimingWheel{};
+    auto expired = std::vector<Task>{};
+
+    wheel.arm(10, []() {});
+
+    ASSERT_EQ(wheel.advance(9, expired), 0);
+    ASSERT_EQ(wheel.advance(10, expired), 1);
+}
+
+TEST(TimingWheelTest, TimerArmedInThePastFiresOnNextAdvance)
+{
+    auto wheel   = TimingWheel{100};
+    auto expired = std::vector<Task>{};
+
+    wheel.arm(5, []() {});
+
+    ASSERT_EQ(wheel.advance(100, expired), 1);
+}
+
+TEST(TimingWheelTest, CancelledTimerDoesNotFire)
+{
+    auto wheel   = TimingWheel{};
+    auto expired = std::vector<Task>{};
+
+    auto id = wheel.arm(10, []() {});
+
+    ASSERT_TRUE(wheel.cancel(id));
+    ASSERT_FALSE(wheel.cancel(id));
+    ASSERT_EQ(wheel.advance(20, expired), 0);
+}
+
+TEST(TimingWheelTest, StaleIdDoesNotAffectReusedNode)
+{
+    auto wheel   = TimingWheel{};
+    auto expired = std::vector<Task>{};
+
+    auto first = wheel.arm(10, []() {});
+    wheel.cancel(first);
+
+    auto second = wheel.arm(10, []() {});
+
+    ASSERT_EQ(first.index, second.index);
+    ASSERT_FALSE(wheel.cancel(first));
+    ASSERT_FALSE(wheel.rearm(first, 30));
+    ASSERT_TRUE(wheel.isArmed(second));
+    ASSERT_EQ(wheel.advance(10, expired), 1);
+}
+
+TEST(TimingWheelTest, RearmedTimerFiresAtNewTick)
+{
+    auto wheel   = TimingWheel{};
+    auto expired = std::vector<Task>{};
+
+    auto id = wheel.arm(10, []() {});
+
+    ASSERT_TRUE(wheel.rearm(id, 1000));
+    ASSERT_EQ(wheel.advance(999, expired), 0);
+    ASSERT_EQ(wheel.advance(1000, expired), 1);
+    ASSERT_FALSE(wheel.isArmed(id));
+}
+
+TEST(TimingWheelTest, DistantTimersCascadeDownTheLevels)
+{
+    auto wheel   = TimingWheel{};
+    auto expired = std::vector<Task>{};
+
+    const auto ticks = std::vector<uint64_t>{255, 256, 65'535, 65'536, 1'000'000, 20'000'000};
+
+    for (auto tick : ticks)
+    {
+        wheel.arm(tick, []() {});
+    }
+
+    for (auto tick : ticks)
+    {
+        ASSERT_EQ(wheel.advance(tick - 1, expired), 0) << tick;
+        ASSERT_EQ(wheel.advance(tick, expired), 1) << tick;
+    }
+}
+
+TEST(TimingWheelTest, TimerBeyondWheelRangeFiresOnTime)
+{
+    auto wheel   = TimingWheel{};
+    auto expired = std::vector<Task>{};
+
+    const auto tick = TimingWheel::max_delta * 3 + 17;
+    wheel.arm(tick, []() {});
+
+    ASSERT_EQ(wheel.advance(tick - 1, expired), 0);
+    ASSERT_EQ(wheel.advance(tick, expired), 1);
+}
+
+TEST(TimingWheelTest, NextExpiryNeverOvershoots)
+{
+    auto wheel = TimingWheel{};
+
+    ASSERT_EQ(wheel.nextExpiry(), std::nullopt);
+
+    wheel.arm(42, []() {});
+    ASSERT_EQ(wheel.nextExpiry(), 42);
+
+    wheel.arm(10'000, []() {});
+    wheel.arm(5, []() {});
+    ASSERT_EQ(wheel.nextExpiry(), 5);
+}
+
+TEST(TimingWheelTest, RandomTimersFireExactlyAtTheirTicks)
+{
+    expectExactExpiries(100'000, 300'000, 2'000);
+}
+
+TEST(TimingWheelTest, SparseTimersFireExactlyAtTheirTicks)
+{
+    expectExactExpiries(10'000, uint64_t{1} << 40, uint64_t{1} << 28);
+}
@@ -0,0 +1,165 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/thread_pool.hpp>
+#include <cfdp_runtime/tracing.hpp>
+
+#include <future>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+namespace tracing = ::cfdp::runtime::tracing;
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+namespace
+{
+[[nodiscard]] size_t count(const std::string& text, std::string_view needle)
+{
+    auto found = size_t{0};
+    for (auto pos = text.find(needle); pos != std::string::npos;
+         pos      = text.find(needle, pos + needle.size()))
+    {
+        ++found;
+    }
+    return found;
+}
+
+class TracingTest : public ::testing::Test
+{
+  protected:
+    ~TracingTest() override { tracing::stop(); }
+};
+} // namespace
+
+TEST_F(TracingTest, SpansAndInstantsAreExported)
+{
+    tracing::start();
+
+    {
+        const auto outer = tracing::Span{"decode", "codec", "transaction", 7};
+        const auto inner = tracing::Span{"checksum", "codec"};
+        tracing::instant("phase \"eof\"", "transaction");
+    }
+
+    auto other = std::jthread{[]() {
+        tracing::setThreadName("sender");
+        const auto span = tracing::Span{"write", "file"};
+    }};
+    other.join();
+
+    const auto json = tracing::exportChromeJson();
+
+    ASSERT_THAT(json, HasSubstr(R"({"displayTimeUnit":"ns","traceEvents":[)"));
+    ASSERT_THAT(json, HasSubstr(R"("name":"decode","cat":"codec","ph":"X")"));
+    ASSERT_THAT(json, HasSubstr(R"("args":{"transaction":7})"));
+    ASSERT_THAT(json, HasSubstr(R"("name":"phase \"eof\"","cat":"transaction","ph":"i")"));
+    ASSERT_THAT(json, HasSubstr(R"("ph":"M")"));
+    ASSERT_THAT(json, HasSubstr(R"("args":{"name":"sender"}})"));
+    ASSERT_EQ(count(json, R"("ph":"X")"), 3);
+}
+
+TEST_F(TracingTest, NothingIsRecordedWhenStopped)
+{
+    tracing::start();
+    tracing::stop();
+
+    {
+        const auto span = tracing::Span{"ignored", "test"};
+        tracing::instant("ignored", "test");
+    }
+
+    ASSERT_THAT(tracing::exportChromeJson(), Not(HasSubstr("ignored")));
+}
+
+TEST_F(TracingTest, FullBufferKeepsLatestEvents)
+{
+    tracing::start(4);
+
+    tracing::instant("first", "test");
+    tracing::instant("second", "test");
+    for (auto i = 0; i < 4; ++i)
+    {
+        tracing::instant("latest", "test");
+    }
+
+    const auto json = tracing::exportChromeJson();
+
+    ASSERT_THAT(json, Not(HasSubstr("first")));
+    ASSERT_THAT(json, Not(HasSubstr("second")));
+    ASSERT_EQ(count(json, "latest"), 4);
+}
+
+TEST_F(TracingTest, ThreadPoolTasksAreTraced)
+{
+    tracing::start();
+
+    {
+        auto pool = cfdp::runtime::thread_pool::ThreadPool{2};
+        ASSERT_EQ(pool.dispatchTask([]() { return 1; }).get(), 1);
+    }
+
+    const auto json = tracing::exportChromeJson();
+
+    ASSERT_THAT(json, HasSubstr(R"("name":"task","cat":"thread_pool","ph":"X")"));
+    ASSERT_THAT(json, HasSubstr(R"("args":{"name":"cfdp worker 0"}})"));
+}
+
+TEST_F(TracingTest, ThreadsAreNamedOnceTheyRecord)
+{
+    auto untraced = std::jthread{[]() { tracing::setThreadName("untraced"); }};
+    untraced.join();
+
+    auto ready   = std::promise<void>{};
+    auto started = std::promise<void>{};
+    auto named   = std::jthread{[&ready, traced = started.get_future()]() {
+        tracing::setThreadName("named early");
+        ready.set_value();
+
+        traced.wait();
+        tracing::instant("late", "test");
+    }};
+
+    ready.get_future().wait();
+    tracing::start();
+    started.set_value();
+    named.join();
+
+    const auto json = tracing::exportChromeJson();
+
+    ASSERT_THAT(json, Not(HasSubstr("untraced")));
+    ASSERT_THAT(json, HasSubstr(R"("args":{"name":"named early"}})"));
+    ASSERT_THAT(json, HasSubstr(R"("name":"late")"));
+}
+
+TEST_F(TracingTest, ExitedThreadsAreExportedOnce)
+{
+    tracing::start();
+
+    auto other = std::jthread{[]() { tracing::instant("exited", "test"); }};
+    other.join();
+
+    ASSERT_THAT(tracing::exportChromeJson(), HasSubstr("exited"));
+    ASSERT_THAT(tracing::exportChromeJson(), Not(HasSubstr("exited")));
+}
+
+TEST_F(TracingTest, ExportDoesNotStopRecording)
+{
+    constexpr auto capacity = 64;
+
+    tracing::start(capacity);
+
+    auto recording = std::jthread{[](const std::stop_token& stop) {
+        while (!stop.stop_requested())
+        {
+            tracing::instant("busy", "test");
+        }
+    }};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        ASSERT_LE(count(tracing::exportChromeJson(), R"("name":"busy")"), capacity);
+    }
+}
@@ -0,0 +1,118 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cfdp_runtime/work_stealing_deque.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using ::cfdp::runtime::atomic::WorkStealingDeque;
+
+TEST(WorkStealingDequeTest, OwnerPopsInLifoOrder)
+{
+    auto deque = WorkStealingDeque<int>{};
+
+    deque.push(1);
+    deque.push(2);
+    deque.push(3);
+
+    ASSERT_EQ(deque.pop(), 3);
+    ASSERT_EQ(deque.pop(), 2);
+    ASSERT_EQ(deque.pop(), 1);
+    ASSERT_EQ(deque.pop(), std::nullopt);
+}
+
+TEST(WorkStealingDequeTest, ThiefStealsInFifoOrder)
+{
+    auto deque = WorkStealingDeque<int>{};
+
+    deque.push(1);
+    deque.push(2);
+
+    ASSERT_EQ(deque.steal(), 1);
+    ASSERT_EQ(deque.steal(), 2);
+    ASSERT_EQ(deque.steal(), std::nullopt);
+}
+
+TEST(WorkStealingDequeTest, DequeGrowsPastInitialCapacity)
+{
+    auto deque = WorkStealingDeque<int>{2};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        deque.push(i);
+    }
+
+    ASSERT_EQ(deque.sizeNow(), 100);
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(deque.steal(), i);
+    }
+
+    ASSERT_TRUE(deque.isEmpty());
+}
+
+TEST(WorkStealingDequeTest, NoItemLostWithConcurrentThieves)
+{
+    constexpr auto num_items = 10000;
+
+    auto deque    = WorkStealingDeque<int>{16};
+    auto done     = std::atomic_bool{false};
+    auto stolen   = std::array<std::vector<int>, 3>{};
+    auto consumed = std::vector<int>{};
+
+    auto thief = [&](std::vector<int>& output) {
+        while (!done.load() || !deque.isEmpty())
+        {
+            if (auto item = deque.steal())
+            {
+                output.push_back(item.value());
+                continue;
+            }
+            std::this_thread::yield();
+        }
+    };
+    auto thieves = std::array<std::thread, 3>{
+        std::thread{thief, std::ref(stolen[0])},
+        std::thread{thief, std::ref(stolen[1])},
+        std::thread{thief, std::ref(stolen[2])},
+    };
+
+    for (auto i = 0; i < num_items; ++i)
+    {
+        deque.push(i);
+
+        if (i % 3 == 0)
+        {
+            if (auto item = deque.pop())
+            {
+                consumed.push_back(item.value());
+            }
+        }
+    }
+
+    while (auto item = deque.pop())
+    {
+        consumed.push_back(item.value());
+    }
+
+    done.store(true);
+
+    for (auto& thread : thieves)
+        thread.join();
+
+    for (auto& output : stolen)
+        consumed.insert(consumed.end(), output.begin(), output.end());
+
+    auto expected = std::vector<int>(num_items);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    std::ranges::sort(consumed);
+
+    EXPECT_EQ(consumed, expected);
+}